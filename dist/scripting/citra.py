@@ -9,7 +9,9 @@ MAX_PACKET_SIZE = 48
 
 class RequestType(enum.IntEnum):
     ReadMemory = 1,
-    WriteMemory = 2
+    WriteMemory = 2,
+    ReadMetrics = 3,
+    ReadMetricName = 4
 
 CITRA_PORT = 45987
 
@@ -90,6 +92,48 @@ class Citra:
                 return False
         return True
 
+    def _request(self, request_type, request_data):
+        request, request_id = self._generate_header(request_type, len(request_data))
+        request += request_data
+        self.socket.sendto(request, (self.address, CITRA_PORT))
+
+        raw_reply = self.socket.recv(MAX_PACKET_SIZE)
+        return self._read_and_validate_header(raw_reply, request_id, request_type)
+
+    def read_metrics(self):
+        """
+        Returns the latest snapshot of the emulator's hot path counters as a dictionary mapping
+        counter names to their values. Counters are snapshotted once per emulated frame.
+        >>> "ipc.fs:USER" in c.read_metrics()
+        True
+        """
+        values = []
+        num_counters = None
+        while num_counters is None or len(values) < num_counters:
+            reply_data = self._request(RequestType.ReadMetrics, struct.pack("I", len(values)))
+            if reply_data is None or len(reply_data) < 8:
+                return None
+            _, num_counters = struct.unpack("II", reply_data[:8])
+            count = (len(reply_data) - 8) // 8
+            if count == 0:
+                break
+            values += struct.unpack("%dQ" % count, reply_data[8:8 + count * 8])
+
+        names = []
+        for index in range(len(values)):
+            # Long names span several replies, the last one is shorter than a full packet
+            name = b""
+            while True:
+                reply_data = self._request(RequestType.ReadMetricName,
+                                           struct.pack("II", index, len(name)))
+                if reply_data is None:
+                    return None
+                name += reply_data
+                if len(reply_data) < MAX_REQUEST_DATA_SIZE:
+                    break
+            names.append(name.decode("utf-8", "replace"))
+        return dict(zip(names, values))
+
 if "__main__" == __name__:
     import doctest
     doctest.testmod(extraglobs={'c': Citra()})
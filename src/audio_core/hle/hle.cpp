@@ -19,6 +19,7 @@
 #include "common/common_types.h"
 #include "common/hash.h"
 #include "common/logging/log.h"
+#include "common/metrics.h"
 #include "core/core.h"
 #include "core/core_timing.h"
 
@@ -377,7 +378,12 @@ StereoFrame16 DspHle::Impl::GenerateCurrentFrame() {
     return output_frame;
 }
 
+static const Common::Metrics::CounterId frame_counter =
+    Common::Metrics::RegisterCounter("dsp.frames");
+
 bool DspHle::Impl::Tick() {
+    Common::Metrics::Increment(frame_counter);
+
     StereoFrame16 current_frame = {};
 
     // TODO: Check dsp::DSP semaphore (which indicates emulated application has finished writing to
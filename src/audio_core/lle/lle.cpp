@@ -13,7 +13,7 @@
 #include "common/thread.h"
 #include "core/core.h"
 #include "core/core_timing.h"
-#include "core/hle/lock.h"
+#include "core/hle/kernel/kernel.h"
 #include "core/hle/service/dsp/dsp_dsp.h"
 
 namespace AudioCore {
@@ -407,28 +407,30 @@ std::array<u8, Memory::DSP_RAM_SIZE>& DspLle::GetDspMemory() {
 }
 
 void DspLle::SetServiceToInterrupt(std::weak_ptr<Service::DSP::DSP_DSP> dsp) {
-    impl->teakra.SetRecvDataHandler(0, [this, dsp]() {
+    // The handlers can run on the Teakra thread, so resolve the lock of the owning system here.
+    std::recursive_mutex& hle_lock = Core::System::GetInstance().Kernel().GetHLELock();
+    impl->teakra.SetRecvDataHandler(0, [this, dsp, &hle_lock]() {
         if (!impl->loaded)
             return;
 
-        std::lock_guard lock(HLE::g_hle_lock);
+        std::lock_guard lock(hle_lock);
         if (auto locked = dsp.lock()) {
             locked->SignalInterrupt(Service::DSP::DSP_DSP::InterruptType::Zero,
                                     static_cast<DspPipe>(0));
         }
     });
-    impl->teakra.SetRecvDataHandler(1, [this, dsp]() {
+    impl->teakra.SetRecvDataHandler(1, [this, dsp, &hle_lock]() {
         if (!impl->loaded)
             return;
 
-        std::lock_guard lock(HLE::g_hle_lock);
+        std::lock_guard lock(hle_lock);
         if (auto locked = dsp.lock()) {
             locked->SignalInterrupt(Service::DSP::DSP_DSP::InterruptType::One,
                                     static_cast<DspPipe>(0));
         }
     });
 
-    auto ProcessPipeEvent = [this, dsp](bool event_from_data) {
+    auto ProcessPipeEvent = [this, dsp, &hle_lock](bool event_from_data) {
         if (!impl->loaded)
             return;
 
@@ -452,7 +454,7 @@ void DspLle::SetServiceToInterrupt(std::weak_ptr<Service::DSP::DSP_DSP> dsp) {
                 // pipe 0 is for debug. 3DS automatically drains this pipe and discards the data
                 impl->ReadPipe(pipe, impl->GetPipeReadableSize(pipe));
             } else {
-                std::lock_guard lock(HLE::g_hle_lock);
+                std::lock_guard lock(hle_lock);
                 if (auto locked = dsp.lock()) {
                     locked->SignalInterrupt(Service::DSP::DSP_DSP::InterruptType::Pipe,
                                             static_cast<DspPipe>(pipe));
@@ -0,0 +1,414 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <fmt/format.h>
+
+// This needs to be included before getopt.h because the latter #defines symbols used by it
+#include "common/microprofile.h"
+
+#ifdef _WIN32
+// windows.h needs to be included before shellapi.h
+#include <windows.h>
+
+#include <shellapi.h>
+#endif
+
+#include "citra/config.h"
+#include "citra/emu_window/emu_window_sdl2.h"
+#include "common/file_util.h"
+#include "common/logging/backend.h"
+#include "common/logging/filter.h"
+#include "common/logging/log.h"
+#include "common/metrics.h"
+#include "common/scm_rev.h"
+#include "common/scope_exit.h"
+#include "common/string_util.h"
+#include "core/core.h"
+#include "core/core_timing.h"
+#include "core/frontend/applets/default_applets.h"
+#include "core/hle/service/am/am.h"
+#include "core/movie.h"
+#include "core/settings.h"
+
+#undef _UNICODE
+#include <getopt.h>
+#ifndef _MSC_VER
+#include <unistd.h>
+#endif
+
+#ifdef _WIN32
+extern "C" {
+// tells Nvidia drivers to use the dedicated GPU by default on laptops with switchable graphics
+__declspec(dllexport) unsigned long NvOptimusEnablement = 0x00000001;
+}
+#endif
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+constexpr u64 DEFAULT_FRAME_COUNT = 600;
+
+struct FrameSample {
+    /// Walltime spent emulating the frame, in milliseconds
+    double wall_time_ms;
+    /// Ratio of emulated time to walltime over the frame
+    double emulation_speed;
+};
+
+struct ProfileScope {
+    std::string group;
+    std::string name;
+    double total_ms;
+    u64 calls;
+};
+
+void PrintHelp(const char* argv0) {
+    std::cout << "Usage: " << argv0
+              << " [options] <filename>\n"
+                 "Runs a title or a movie (.ctm) without a visible window and without frame\n"
+                 "limiting, then prints a JSON performance report.\n"
+                 "-n, --frames=NUMBER   Number of emulated frames to run (default: "
+              << DEFAULT_FRAME_COUNT
+              << ")\n"
+                 "-o, --output=FILE     Write the report to FILE instead of stdout\n"
+                 "-p, --movie-play=FILE Play back the movie (game inputs) from the given file\n"
+                 "-h, --help            Display this help and exit\n"
+                 "-v, --version         Output version information and exit\n";
+}
+
+void PrintVersion() {
+    std::cout << "Citra " << Common::g_scm_branch << " " << Common::g_scm_desc << std::endl;
+}
+
+void InitializeLogging() {
+    Log::Filter log_filter(Log::Level::Debug);
+    log_filter.ParseFilterString(Settings::values.log_filter);
+    Log::SetGlobalFilter(log_filter);
+
+    // The report may be written to stdout, so only log to the console's stderr
+    Log::AddBackend(std::make_unique<Log::ColorConsoleBackend>());
+#ifdef _WIN32
+    Log::AddBackend(std::make_unique<Log::DebuggerBackend>());
+#endif
+}
+
+bool IsMovieFile(const std::string& path) {
+    constexpr std::string_view extension = ".ctm";
+    if (path.size() < extension.size()) {
+        return false;
+    }
+    return Common::ToLower(path.substr(path.size() - extension.size())) == extension;
+}
+
+std::string EscapeJson(const std::string& str) {
+    std::string result;
+    result.reserve(str.size());
+    for (const char c : str) {
+        switch (c) {
+        case '"':
+            result += "\\\"";
+            break;
+        case '\\':
+            result += "\\\\";
+            break;
+        default:
+            if (static_cast<unsigned char>(c) < 0x20) {
+                result += fmt::format("\\u{:04x}", static_cast<unsigned>(c));
+            } else {
+                result += c;
+            }
+            break;
+        }
+    }
+    return result;
+}
+
+/// Collects the time spent in every MicroProfile scope since the profiler was started
+std::vector<ProfileScope> GetProfileScopes() {
+    std::vector<ProfileScope> scopes;
+#if MICROPROFILE_ENABLED
+    std::lock_guard lock{MicroProfileGetMutex()};
+    const MicroProfile& profile = *MicroProfileGet();
+    const double ms_per_tick = 1000.0 / static_cast<double>(MicroProfileTicksPerSecondCpu());
+    for (u32 i = 0; i < profile.nTotalTimers; ++i) {
+        const MicroProfileTimer& timer = profile.Aggregate[i];
+        if (timer.nCount == 0) {
+            continue;
+        }
+        scopes.push_back({profile.GroupInfo[profile.TimerToGroup[i]].pName,
+                          profile.TimerInfo[i].pName, timer.nTicks * ms_per_tick, timer.nCount});
+    }
+#endif
+    return scopes;
+}
+
+std::string BuildReport(const std::string& filepath, const std::string& movie_play,
+                        u64 requested_frames, const std::vector<FrameSample>& frames,
+                        const std::vector<ProfileScope>& scopes,
+                        const Common::Metrics::Snapshot& metrics) {
+    double total_wall_time_ms = 0.0;
+    double total_emulated_time_ms = 0.0;
+    for (const FrameSample& frame : frames) {
+        total_wall_time_ms += frame.wall_time_ms;
+        total_emulated_time_ms += frame.wall_time_ms * frame.emulation_speed;
+    }
+    const double frame_count = frames.empty() ? 1.0 : static_cast<double>(frames.size());
+
+    std::string report = "{\n";
+    report += fmt::format("  \"version\": \"{}\",\n",
+                          EscapeJson(fmt::format("{}-{}", Common::g_scm_branch,
+                                                 Common::g_scm_desc)));
+    report += fmt::format("  \"title\": \"{}\",\n", EscapeJson(filepath));
+    report += fmt::format("  \"movie\": \"{}\",\n", EscapeJson(movie_play));
+    report += fmt::format("  \"requested_frames\": {},\n", requested_frames);
+    report += fmt::format("  \"frames\": {},\n", frames.size());
+    report += fmt::format("  \"total_wall_time_ms\": {:.3f},\n", total_wall_time_ms);
+    report += fmt::format("  \"average_frame_time_ms\": {:.3f},\n",
+                          total_wall_time_ms / frame_count);
+    report += fmt::format("  \"emulation_speed\": {:.4f},\n",
+                          total_wall_time_ms > 0.0 ? total_emulated_time_ms / total_wall_time_ms
+                                                   : 0.0);
+
+    report += "  \"frame_wall_time_ms\": [";
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        report += fmt::format("{}{:.3f}", i == 0 ? "" : ", ", frames[i].wall_time_ms);
+    }
+    report += "],\n";
+
+    report += "  \"frame_emulation_speed\": [";
+    for (std::size_t i = 0; i < frames.size(); ++i) {
+        report += fmt::format("{}{:.4f}", i == 0 ? "" : ", ", frames[i].emulation_speed);
+    }
+    report += "],\n";
+
+    report += "  \"profile_scopes\": [";
+    for (std::size_t i = 0; i < scopes.size(); ++i) {
+        report += fmt::format(
+            "{}\n    {{\"group\": \"{}\", \"name\": \"{}\", \"total_ms\": {:.3f}, \"calls\": {}}}",
+            i == 0 ? "" : ",", EscapeJson(scopes[i].group), EscapeJson(scopes[i].name),
+            scopes[i].total_ms, scopes[i].calls);
+    }
+    report += scopes.empty() ? "],\n" : "\n  ],\n";
+
+    report += "  \"counters\": {";
+    for (std::size_t i = 0; i < metrics.values.size(); ++i) {
+        report += fmt::format("{}\n    \"{}\": {}", i == 0 ? "" : ",",
+                              EscapeJson(metrics.names[i]), metrics.values[i]);
+    }
+    report += metrics.values.empty() ? "}\n" : "\n  }\n";
+
+    report += "}\n";
+    return report;
+}
+
+} // Anonymous namespace
+
+/// Application entry point
+int main(int argc, char** argv) {
+    Config config;
+    int option_index = 0;
+    u64 requested_frames = DEFAULT_FRAME_COUNT;
+    std::string output_path;
+    std::string movie_play;
+
+    InitializeLogging();
+
+    char* endarg;
+#ifdef _WIN32
+    int argc_w;
+    auto argv_w = CommandLineToArgvW(GetCommandLineW(), &argc_w);
+
+    if (argv_w == nullptr) {
+        LOG_CRITICAL(Frontend, "Failed to get command line arguments");
+        return -1;
+    }
+#endif
+    std::string filepath;
+
+    static struct option long_options[] = {
+        {"frames", required_argument, 0, 'n'},
+        {"output", required_argument, 0, 'o'},
+        {"movie-play", required_argument, 0, 'p'},
+        {"help", no_argument, 0, 'h'},
+        {"version", no_argument, 0, 'v'},
+        {0, 0, 0, 0},
+    };
+
+    while (optind < argc) {
+        int arg = getopt_long(argc, argv, "n:o:p:hv", long_options, &option_index);
+        if (arg != -1) {
+            switch (static_cast<char>(arg)) {
+            case 'n':
+                errno = 0;
+                requested_frames = strtoull(optarg, &endarg, 0);
+                if (endarg == optarg || requested_frames == 0)
+                    errno = EINVAL;
+                if (errno != 0) {
+                    perror("--frames");
+                    exit(1);
+                }
+                break;
+            case 'o':
+                output_path = optarg;
+                break;
+            case 'p':
+                movie_play = optarg;
+                break;
+            case 'h':
+                PrintHelp(argv[0]);
+                return 0;
+            case 'v':
+                PrintVersion();
+                return 0;
+            }
+        } else {
+#ifdef _WIN32
+            filepath = Common::UTF16ToUTF8(argv_w[optind]);
+#else
+            filepath = argv[optind];
+#endif
+            optind++;
+        }
+    }
+
+#ifdef _WIN32
+    LocalFree(argv_w);
+#endif
+
+    // A movie given on its own boots the installed title it was recorded with
+    if (movie_play.empty() && IsMovieFile(filepath)) {
+        movie_play = std::move(filepath);
+        filepath.clear();
+    }
+
+    if (!movie_play.empty()) {
+        const u64 program_id = Core::Movie::GetInstance().GetMovieProgramID(movie_play);
+        if (program_id == 0) {
+            LOG_CRITICAL(Frontend, "Movie {} is invalid", movie_play);
+            return -1;
+        }
+        if (filepath.empty()) {
+            filepath = Service::AM::GetTitleContentPath(Service::FS::MediaType::SDMC, program_id);
+            if (!FileUtil::Exists(filepath)) {
+                LOG_CRITICAL(Frontend,
+                             "Title {:016X} of movie {} is not installed, pass its ROM as well",
+                             program_id, movie_play);
+                return -1;
+            }
+        }
+        if (Core::Movie::GetInstance().ValidateMovie(movie_play, program_id) !=
+            Core::Movie::ValidationResult::OK) {
+            LOG_WARNING(Frontend, "Movie {} might not play back correctly", movie_play);
+        }
+    }
+
+    if (filepath.empty()) {
+        LOG_CRITICAL(Frontend, "Failed to load ROM: No ROM specified");
+        return -1;
+    }
+
+    MicroProfileOnThreadCreate("EmuThread");
+    SCOPE_EXIT({ MicroProfileShutdown(); });
+    MicroProfileSetForceEnable(true);
+    MicroProfileSetEnableAllGroups(true);
+    // Accumulate the scope timings over the whole run instead of a sliding window
+    MicroProfileSetAggregateFrames(0);
+
+    if (!movie_play.empty()) {
+        Core::Movie::GetInstance().PrepareForPlayback(movie_play);
+    }
+
+    // Run as fast as possible, without audio output or presentation waits
+    Settings::values.sink_id = "null";
+    Settings::values.use_frame_limit = false;
+    Settings::values.vsync_enabled = false;
+    Settings::values.use_gdbstub = false;
+    Settings::Apply();
+
+    // Register frontend applets
+    Frontend::RegisterDefaultApplets();
+
+    EmuWindow_SDL2 emu_window{false, true};
+
+    Core::System& system{Core::System::GetInstance()};
+
+    SCOPE_EXIT({ system.Shutdown(); });
+
+    const Core::System::ResultStatus load_result{system.Load(emu_window, filepath)};
+    if (load_result != Core::System::ResultStatus::Success) {
+        LOG_CRITICAL(Frontend, "Failed to load {} (error {})", filepath,
+                     static_cast<u32>(load_result));
+        return -1;
+    }
+
+    system.TelemetrySession().AddField(Telemetry::FieldType::App, "Frontend", "Bench");
+
+    std::atomic<bool> movie_finished{false};
+    if (!movie_play.empty()) {
+        Core::Movie::GetInstance().StartPlayback(movie_play, [&] { movie_finished = true; });
+    }
+
+    std::vector<FrameSample> frames;
+    frames.reserve(requested_frames);
+
+    bool emulation_failed = false;
+    const u64 first_frame = system.perf_stats.GetTotalSystemFrames();
+    auto frame_start = Clock::now();
+    auto frame_start_us = system.CoreTiming().GetGlobalTimeUs();
+    while (frames.size() < requested_frames && !movie_finished && emu_window.IsOpen()) {
+        if (system.RunLoop() != Core::System::ResultStatus::Success) {
+            LOG_CRITICAL(Frontend, "Emulation stopped after {} frames", frames.size());
+            emulation_failed = true;
+            break;
+        }
+
+        const u64 presented = system.perf_stats.GetTotalSystemFrames() - first_frame;
+        if (presented <= frames.size()) {
+            continue;
+        }
+
+        const auto now = Clock::now();
+        const auto now_us = system.CoreTiming().GetGlobalTimeUs();
+        const double wall_us =
+            std::chrono::duration<double, std::micro>(now - frame_start).count();
+        const double emulated_us = static_cast<double>((now_us - frame_start_us).count());
+        // Several frames can only end within one slice when they are almost empty; split the
+        // slice evenly between them
+        const u64 ended_frames = presented - frames.size();
+        const FrameSample sample{wall_us / 1000.0 / ended_frames,
+                                 wall_us > 0.0 ? emulated_us / wall_us : 0.0};
+        for (u64 i = 0; i < ended_frames && frames.size() < requested_frames; ++i) {
+            frames.push_back(sample);
+        }
+        frame_start = now;
+        frame_start_us = now_us;
+    }
+
+    if (!movie_play.empty()) {
+        Core::Movie::GetInstance().Shutdown();
+    }
+
+    Common::Metrics::TakeSnapshot();
+    const std::string report = BuildReport(filepath, movie_play, requested_frames, frames,
+                                           GetProfileScopes(), Common::Metrics::GetSnapshot());
+    if (output_path.empty()) {
+        std::cout << report;
+    } else {
+        FileUtil::IOFile file(output_path, "w");
+        if (!file.IsOpen() || file.WriteString(report) != report.size()) {
+            LOG_CRITICAL(Frontend, "Failed to write the report to {}", output_path);
+            return -1;
+        }
+    }
+
+    return emulation_failed ? -1 : 0;
+}
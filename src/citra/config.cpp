@@ -103,6 +103,11 @@ void Config::ReadValues() {
 
     // Core
     Settings::values.use_cpu_jit = sdl2_config->GetBoolean("Core", "use_cpu_jit", true);
+    Settings::values.use_idle_loop_skip =
+        sdl2_config->GetBoolean("Core", "use_idle_loop_skip", true);
+    Settings::values.idle_loop_skip_disabled_titles =
+        sdl2_config->GetString("Core", "idle_loop_skip_disabled_titles", "");
+    Settings::values.use_boot_cache = sdl2_config->GetBoolean("Core", "use_boot_cache", false);
 
     // Renderer
     Settings::values.use_gles = sdl2_config->GetBoolean("Renderer", "use_gles", false);
@@ -120,6 +125,9 @@ void Config::ReadValues() {
     Settings::values.shaders_accurate_mul =
         sdl2_config->GetBoolean("Renderer", "shaders_accurate_mul", false);
     Settings::values.use_shader_jit = sdl2_config->GetBoolean("Renderer", "use_shader_jit", true);
+    Settings::values.use_gpu_thread = sdl2_config->GetBoolean("Renderer", "use_gpu_thread", false);
+    Settings::values.use_disk_shader_cache =
+        sdl2_config->GetBoolean("Renderer", "use_disk_shader_cache", true);
     Settings::values.resolution_factor =
         static_cast<u16>(sdl2_config->GetInteger("Renderer", "resolution_factor", 1));
     Settings::values.vsync_enabled = sdl2_config->GetBoolean("Renderer", "vsync_enabled", false);
@@ -91,6 +91,18 @@ udp_pad_index=
 # 0: Interpreter (slow), 1 (default): JIT (fast)
 use_cpu_jit =
 
+# Whether to skip ahead to the next event when a thread spins in a loop polling memory
+# 0: Off, 1 (default): On
+use_idle_loop_skip =
+
+# Comma separated list of title ids (in hexadecimal) for which idle loops are never skipped
+# e.g. 0004000000030800,0004000000155100
+idle_loop_skip_disabled_titles =
+
+# Whether to keep the decompressed and decrypted code of titles on disk to speed up later boots
+# 0 (default): Off, 1: On
+use_boot_cache =
+
 [Renderer]
 # Whether to render using GLES or OpenGL
 # 0 (default): OpenGL, 1: GLES
@@ -116,6 +128,15 @@ shaders_accurate_gs =
 # 0: Interpreter (slow), 1 (default): JIT (fast)
 use_shader_jit =
 
+# Whether to process GPU command lists on a separate thread. Only used by the software renderer.
+# 0 (default): Off, 1: On
+use_gpu_thread =
+
+# Whether to store generated shaders on disk and compile them ahead of time in later sessions.
+# Only used by the hardware renderer.
+# 0: Off, 1 (default): On
+use_disk_shader_cache =
+
 # Resolution scale factor
 # 0: Auto (scales resolution to window size), 1: Native 3DS screen resolution, Otherwise a scale
 # factor for the 3DS resolution
@@ -12,7 +12,11 @@ struct SDL_Window;
 
 class EmuWindow_SDL2 : public Frontend::EmuWindow {
 public:
-    explicit EmuWindow_SDL2(bool fullscreen);
+    /**
+     * @param fullscreen Whether to start in fullscreen mode
+     * @param hidden Whether to keep the window hidden, only using it for its OpenGL context
+     */
+    explicit EmuWindow_SDL2(bool fullscreen, bool hidden = false);
     ~EmuWindow_SDL2();
 
     /// Swap buffers to display the next frame
@@ -145,6 +145,10 @@ void Config::ReadValues() {
 
     qt_config->beginGroup("Core");
     Settings::values.use_cpu_jit = ReadSetting("use_cpu_jit", true).toBool();
+    Settings::values.use_idle_loop_skip = ReadSetting("use_idle_loop_skip", true).toBool();
+    Settings::values.idle_loop_skip_disabled_titles =
+        ReadSetting("idle_loop_skip_disabled_titles", "").toString().toStdString();
+    Settings::values.use_boot_cache = ReadSetting("use_boot_cache", false).toBool();
     qt_config->endGroup();
 
     qt_config->beginGroup("Renderer");
@@ -160,6 +164,8 @@ void Config::ReadValues() {
     Settings::values.shaders_accurate_gs = ReadSetting("shaders_accurate_gs", true).toBool();
     Settings::values.shaders_accurate_mul = ReadSetting("shaders_accurate_mul", false).toBool();
     Settings::values.use_shader_jit = ReadSetting("use_shader_jit", true).toBool();
+    Settings::values.use_gpu_thread = ReadSetting("use_gpu_thread", false).toBool();
+    Settings::values.use_disk_shader_cache = ReadSetting("use_disk_shader_cache", true).toBool();
     Settings::values.resolution_factor =
         static_cast<u16>(ReadSetting("resolution_factor", 1).toInt());
     Settings::values.vsync_enabled = ReadSetting("vsync_enabled", false).toBool();
@@ -442,6 +448,10 @@ void Config::SaveValues() {
 
     qt_config->beginGroup("Core");
     WriteSetting("use_cpu_jit", Settings::values.use_cpu_jit, true);
+    WriteSetting("use_idle_loop_skip", Settings::values.use_idle_loop_skip, true);
+    WriteSetting("idle_loop_skip_disabled_titles",
+                 QString::fromStdString(Settings::values.idle_loop_skip_disabled_titles), "");
+    WriteSetting("use_boot_cache", Settings::values.use_boot_cache, false);
     qt_config->endGroup();
 
     qt_config->beginGroup("Renderer");
@@ -450,6 +460,8 @@ void Config::SaveValues() {
     WriteSetting("shaders_accurate_gs", Settings::values.shaders_accurate_gs, true);
     WriteSetting("shaders_accurate_mul", Settings::values.shaders_accurate_mul, false);
     WriteSetting("use_shader_jit", Settings::values.use_shader_jit, true);
+    WriteSetting("use_gpu_thread", Settings::values.use_gpu_thread, false);
+    WriteSetting("use_disk_shader_cache", Settings::values.use_disk_shader_cache, true);
     WriteSetting("resolution_factor", Settings::values.resolution_factor, 1);
     WriteSetting("vsync_enabled", Settings::values.vsync_enabled, false);
     WriteSetting("use_frame_limit", Settings::values.use_frame_limit, true);
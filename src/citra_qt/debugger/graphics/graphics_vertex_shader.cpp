@@ -349,11 +349,11 @@ void GraphicsVertexShaderWidget::DumpShader() {
         return;
     }
 
-    auto& setup = Pica::g_state.vs;
-    auto& config = Pica::g_state.regs.vs;
+    auto& setup = Pica::GetState().vs;
+    auto& config = Pica::GetState().regs.vs;
 
     Pica::DebugUtils::DumpShader(filename.toStdString(), config, setup,
-                                 Pica::g_state.regs.rasterizer.vs_output_attributes);
+                                 Pica::GetState().regs.rasterizer.vs_output_attributes);
 }
 
 GraphicsVertexShaderWidget::GraphicsVertexShaderWidget(
@@ -504,8 +504,8 @@ void GraphicsVertexShaderWidget::Reload(bool replace_vertex_data, void* vertex_d
     // Reload shader code
     info.Clear();
 
-    auto& shader_setup = Pica::g_state.vs;
-    auto& shader_config = Pica::g_state.regs.vs;
+    auto& shader_setup = Pica::GetState().vs;
+    auto& shader_config = Pica::GetState().regs.vs;
     for (auto instr : shader_setup.program_code)
         info.code.push_back({instr});
     int num_attributes = shader_config.max_input_attribute_index + 1;
@@ -513,7 +513,7 @@ void GraphicsVertexShaderWidget::Reload(bool replace_vertex_data, void* vertex_d
     for (auto pattern : shader_setup.swizzle_data)
         info.swizzle_info.push_back({pattern});
 
-    u32 entry_point = Pica::g_state.regs.vs.main_offset;
+    u32 entry_point = Pica::GetState().regs.vs.main_offset;
     info.labels.insert({entry_point, "main"});
 
     // Generate debug information
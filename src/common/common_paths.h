@@ -44,9 +44,14 @@
 #define CHEATS_DIR "cheats"
 #define DLL_DIR "external_dlls"
 
+// Subdirs in the directory returned by GetUserPath(UserPath::CacheDir)
+#define SHADER_CACHE_DIR "shaders"
+#define BOOT_CACHE_DIR "boot"
+
 // Filenames
 // Files in the directory returned by GetUserPath(UserPath::LogDir)
 #define LOG_FILE "citra_log.txt"
+#define METRICS_FILE "citra_metrics.txt"
 
 // Files in the directory returned by GetUserPath(UserPath::ConfigDir)
 #define EMU_CONFIG "emu.ini"
@@ -0,0 +1,162 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include "common/assert.h"
+#include "common/common_funcs.h"
+#include "common/host_memory.h"
+#include "common/logging/log.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+namespace Common {
+
+#ifdef __linux__
+namespace {
+
+/// Creates an anonymous shared memory file of the given size, returning -1 on failure
+int CreateSharedMemoryFile(std::size_t size) {
+    const int fd = memfd_create("citra_host_memory", MFD_CLOEXEC);
+    if (fd == -1) {
+        return -1;
+    }
+    if (ftruncate(fd, static_cast<off_t>(size)) != 0) {
+        close(fd);
+        return -1;
+    }
+    return fd;
+}
+
+bool WriteAll(int fd, const u8* data, std::size_t size) {
+    std::size_t offset = 0;
+    while (offset < size) {
+        const ssize_t written = pwrite(fd, data + offset, size - offset, offset);
+        if (written <= 0) {
+            return false;
+        }
+        offset += static_cast<std::size_t>(written);
+    }
+    return true;
+}
+
+bool ReadAll(int fd, u8* data, std::size_t size) {
+    std::size_t offset = 0;
+    while (offset < size) {
+        const ssize_t read_size = pread(fd, data + offset, size - offset, offset);
+        if (read_size <= 0) {
+            return false;
+        }
+        offset += static_cast<std::size_t>(read_size);
+    }
+    return true;
+}
+
+} // Anonymous namespace
+#endif
+
+HostMemory::HostMemory(std::size_t size) : backing_size(size) {
+#ifdef __linux__
+    fd = CreateSharedMemoryFile(size);
+    if (fd != -1) {
+        void* mapping = mmap(nullptr, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+        if (mapping != MAP_FAILED) {
+            pointer = static_cast<u8*>(mapping);
+            return;
+        }
+        close(fd);
+        fd = -1;
+    }
+    LOG_WARNING(Common_Memory, "Failed to create shared memory, falling back to the heap: {}",
+                GetLastErrorMsg());
+#endif
+    heap_backing = std::make_unique<u8[]>(size);
+    pointer = heap_backing.get();
+}
+
+HostMemory::HostMemory(std::shared_ptr<const HostMemoryImage> image)
+    : backing_size(image->size()), base_image(std::move(image)) {
+#ifdef __linux__
+    if (base_image->fd != -1) {
+        void* mapping = mmap(nullptr, backing_size, PROT_READ | PROT_WRITE, MAP_PRIVATE,
+                             base_image->fd, 0);
+        if (mapping != MAP_FAILED) {
+            pointer = static_cast<u8*>(mapping);
+            return;
+        }
+
+        heap_backing = std::make_unique<u8[]>(backing_size);
+        pointer = heap_backing.get();
+        const bool read = ReadAll(base_image->fd, pointer, backing_size);
+        ASSERT_MSG(read, "Failed to read memory image: {}", GetLastErrorMsg());
+        base_image.reset();
+        return;
+    }
+#endif
+    heap_backing = std::make_unique<u8[]>(backing_size);
+    pointer = heap_backing.get();
+    std::memcpy(pointer, base_image->heap_copy.get(), backing_size);
+    base_image.reset();
+}
+
+HostMemory::~HostMemory() {
+#ifdef __linux__
+    if (heap_backing == nullptr) {
+        munmap(pointer, backing_size);
+    }
+    if (fd != -1) {
+        close(fd);
+    }
+#endif
+}
+
+std::shared_ptr<const HostMemoryImage> HostMemory::CreateImage() {
+#ifdef __linux__
+    if (heap_backing == nullptr) {
+        int image_fd = fd;
+        if (image_fd == -1) {
+            // The block already copies an older image on write, so its current contents have to
+            // be written to a new file first
+            image_fd = CreateSharedMemoryFile(backing_size);
+            if (image_fd != -1 && !WriteAll(image_fd, pointer, backing_size)) {
+                close(image_fd);
+                image_fd = -1;
+            }
+        }
+
+        // Mapping the file privately at the same address keeps every pointer into the block valid
+        if (image_fd != -1 && mmap(pointer, backing_size, PROT_READ | PROT_WRITE,
+                                   MAP_PRIVATE | MAP_FIXED, image_fd, 0) != MAP_FAILED) {
+            fd = -1;
+            base_image.reset(new HostMemoryImage(image_fd, nullptr, backing_size));
+            return base_image;
+        }
+
+        if (image_fd != -1 && image_fd != fd) {
+            close(image_fd);
+        }
+        LOG_WARNING(Common_Memory, "Failed to capture memory without copying: {}",
+                    GetLastErrorMsg());
+    }
+#endif
+    auto heap_copy = std::make_unique<u8[]>(backing_size);
+    std::memcpy(heap_copy.get(), pointer, backing_size);
+    return std::shared_ptr<const HostMemoryImage>(
+        new HostMemoryImage(-1, std::move(heap_copy), backing_size));
+}
+
+HostMemoryImage::HostMemoryImage(int fd, std::unique_ptr<u8[]> heap_copy, std::size_t size)
+    : fd(fd), heap_copy(std::move(heap_copy)), image_size(size) {}
+
+HostMemoryImage::~HostMemoryImage() {
+#ifdef __linux__
+    if (fd != -1) {
+        close(fd);
+    }
+#endif
+}
+
+} // namespace Common
@@ -0,0 +1,87 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <memory>
+#include "common/common_types.h"
+
+namespace Common {
+
+class HostMemoryImage;
+
+/**
+ * A large, host page aligned and zero-initialized block of memory. Where the host supports it
+ * (Linux), the block is backed by an anonymous shared memory file, which allows capturing its
+ * contents as an image and creating new blocks from an image without copying: pages are only
+ * copied once either side writes to them.
+ */
+class HostMemory {
+public:
+    explicit HostMemory(std::size_t size);
+
+    /// Creates a block that starts out with the contents of an image
+    explicit HostMemory(std::shared_ptr<const HostMemoryImage> image);
+
+    ~HostMemory();
+
+    HostMemory(const HostMemory&) = delete;
+    HostMemory& operator=(const HostMemory&) = delete;
+
+    u8* data() {
+        return pointer;
+    }
+
+    const u8* data() const {
+        return pointer;
+    }
+
+    std::size_t size() const {
+        return backing_size;
+    }
+
+    /**
+     * Captures the current contents of the block. The block keeps its address and contents, but
+     * from then on writes only affect private copies of the pages they touch. The first capture
+     * of a block that was not created from an image is free; later captures copy the block once.
+     */
+    std::shared_ptr<const HostMemoryImage> CreateImage();
+
+private:
+    u8* pointer = nullptr;
+    std::size_t backing_size = 0;
+
+    /// Shared memory file backing the block, or -1 if it is backed by an image or the heap
+    int fd = -1;
+    /// Image whose pages the block copies on write
+    std::shared_ptr<const HostMemoryImage> base_image;
+    /// Heap allocation used where file backed memory is not supported
+    std::unique_ptr<u8[]> heap_backing;
+};
+
+/// Immutable contents of a HostMemory, see HostMemory::CreateImage
+class HostMemoryImage {
+public:
+    ~HostMemoryImage();
+
+    HostMemoryImage(const HostMemoryImage&) = delete;
+    HostMemoryImage& operator=(const HostMemoryImage&) = delete;
+
+    std::size_t size() const {
+        return image_size;
+    }
+
+private:
+    friend class HostMemory;
+
+    HostMemoryImage(int fd, std::unique_ptr<u8[]> heap_copy, std::size_t size);
+
+    /// Shared memory file holding the contents, or -1 if they are held by heap_copy
+    int fd;
+    std::unique_ptr<u8[]> heap_copy;
+    std::size_t image_size;
+};
+
+} // namespace Common
@@ -0,0 +1,133 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <mutex>
+#include <fmt/format.h>
+#include "common/assert.h"
+#include "common/file_util.h"
+#include "common/metrics.h"
+
+namespace Common::Metrics {
+
+namespace {
+
+/// Counters written by a single thread. They are atomic only so that snapshots can read them.
+struct ThreadCounters {
+    std::array<std::atomic<u64>, MAX_COUNTERS> values{};
+};
+
+struct Registry {
+    std::mutex mutex;
+    std::vector<std::string> names;
+    std::vector<ThreadCounters*> threads;
+    /// Totals of the threads that have exited
+    std::array<u64, MAX_COUNTERS> retired_values{};
+    Snapshot snapshot;
+};
+
+Registry& GetRegistry() {
+    static Registry registry;
+    return registry;
+}
+
+/// Registers the counters of a thread for as long as the thread is alive
+class ThreadCountersHandle {
+public:
+    ThreadCountersHandle() {
+        Registry& registry = GetRegistry();
+        std::lock_guard lock{registry.mutex};
+        registry.threads.push_back(&counters);
+    }
+
+    ~ThreadCountersHandle() {
+        Registry& registry = GetRegistry();
+        std::lock_guard lock{registry.mutex};
+        for (std::size_t i = 0; i < registry.names.size(); ++i) {
+            registry.retired_values[i] += counters.values[i].load(std::memory_order_relaxed);
+        }
+        registry.threads.erase(
+            std::find(registry.threads.begin(), registry.threads.end(), &counters));
+    }
+
+    ThreadCounters counters;
+};
+
+ThreadCounters& GetThreadCounters() {
+    thread_local ThreadCountersHandle handle;
+    return handle.counters;
+}
+
+} // Anonymous namespace
+
+CounterId RegisterCounter(std::string_view name) {
+    Registry& registry = GetRegistry();
+    std::lock_guard lock{registry.mutex};
+
+    const auto it = std::find(registry.names.begin(), registry.names.end(), name);
+    if (it != registry.names.end()) {
+        return static_cast<CounterId>(it - registry.names.begin());
+    }
+
+    ASSERT_MSG(registry.names.size() < MAX_COUNTERS, "Too many counters registered");
+    registry.names.emplace_back(name);
+    return static_cast<CounterId>(registry.names.size() - 1);
+}
+
+void Increment(CounterId id, u64 amount) {
+    // Only the owning thread writes to these counters, so there is no need for a locked
+    // read-modify-write
+    std::atomic<u64>& value = GetThreadCounters().values[id];
+    value.store(value.load(std::memory_order_relaxed) + amount, std::memory_order_relaxed);
+}
+
+void TakeSnapshot() {
+    Registry& registry = GetRegistry();
+    std::lock_guard lock{registry.mutex};
+
+    const std::size_t num_counters = registry.names.size();
+    Snapshot& snapshot = registry.snapshot;
+    snapshot.sequence++;
+    snapshot.names.resize(num_counters);
+    std::copy(registry.names.begin(), registry.names.end(), snapshot.names.begin());
+
+    // Counters registered since the previous snapshot start out at zero
+    std::vector<u64> previous_values = std::move(snapshot.values);
+    previous_values.resize(num_counters);
+
+    snapshot.values.assign(registry.retired_values.begin(),
+                           registry.retired_values.begin() + num_counters);
+    for (const ThreadCounters* counters : registry.threads) {
+        for (std::size_t i = 0; i < num_counters; ++i) {
+            snapshot.values[i] += counters->values[i].load(std::memory_order_relaxed);
+        }
+    }
+
+    snapshot.frame_values.resize(num_counters);
+    for (std::size_t i = 0; i < num_counters; ++i) {
+        snapshot.frame_values[i] = snapshot.values[i] - previous_values[i];
+    }
+}
+
+Snapshot GetSnapshot() {
+    Registry& registry = GetRegistry();
+    std::lock_guard lock{registry.mutex};
+    return registry.snapshot;
+}
+
+bool WriteSnapshot(const std::string& path) {
+    const Snapshot snapshot = GetSnapshot();
+
+    std::string contents = fmt::format("snapshot {}\n", snapshot.sequence);
+    for (std::size_t i = 0; i < snapshot.values.size(); ++i) {
+        contents += fmt::format("{} {}\n", snapshot.names[i], snapshot.values[i]);
+    }
+
+    FileUtil::IOFile file(path, "w");
+    return file.IsOpen() && file.WriteString(contents) == contents.size();
+}
+
+} // namespace Common::Metrics
@@ -0,0 +1,57 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <vector>
+#include "common/common_types.h"
+
+/**
+ * A registry of named event counters for the emulator's hot paths. Every thread increments its own
+ * set of counters, so counting never takes a lock or contends on a cache line. The totals of all
+ * threads are gathered into a snapshot once per frame, which is what readers get to see.
+ */
+namespace Common::Metrics {
+
+/// Maximum number of counters that can be registered
+constexpr std::size_t MAX_COUNTERS = 1024;
+
+using CounterId = u32;
+
+struct Snapshot {
+    /// Number of snapshots taken before this one
+    u64 sequence = 0;
+    /// Names of the registered counters, indexed by CounterId
+    std::vector<std::string> names;
+    /// Total of every counter at the time of the snapshot, indexed by CounterId
+    std::vector<u64> values;
+    /// Amount every counter grew by since the previous snapshot, that is during the last frame
+    std::vector<u64> frame_values;
+};
+
+/**
+ * Registers a counter, returning the id used to increment it. Registering the same name again
+ * returns the id of the existing counter.
+ */
+CounterId RegisterCounter(std::string_view name);
+
+/// Adds the given amount to a counter of the calling thread
+void Increment(CounterId id, u64 amount = 1);
+
+/// Gathers the counters of all threads into a new snapshot
+void TakeSnapshot();
+
+/// Returns a copy of the latest snapshot
+Snapshot GetSnapshot();
+
+/**
+ * Writes the latest snapshot to a text file, one "name value" pair per line.
+ * @returns Whether the file was written successfully
+ */
+bool WriteSnapshot(const std::string& path);
+
+} // namespace Common::Metrics
@@ -0,0 +1,118 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "common/thread.h"
+#include "common/thread_pool.h"
+
+namespace Common {
+
+ThreadPool::ThreadPool(std::size_t num_workers) {
+    workers.reserve(num_workers);
+    for (std::size_t i = 0; i < num_workers; ++i) {
+        workers.emplace_back(&ThreadPool::WorkerLoop, this);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard lock{mutex};
+        stop_requested = true;
+    }
+    work_available.notify_all();
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::ParallelFor(std::size_t count, const std::function<void(std::size_t)>& func) {
+    if (workers.empty() || count <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            func(i);
+        }
+        return;
+    }
+
+    std::lock_guard submit_lock{submit_mutex};
+    {
+        std::lock_guard lock{mutex};
+        job_func = &func;
+        job_count = count;
+        next_index = 0;
+        ++generation;
+    }
+    work_available.notify_all();
+
+    RunJob();
+
+    // Every index has been claimed at this point, so only the workers that joined the job have to
+    // be waited for. Closing the job under the lock keeps workers that notice it late out of it.
+    std::unique_lock lock{mutex};
+    job_done.wait(lock, [this] { return busy_workers == 0; });
+    job_func = nullptr;
+}
+
+void ThreadPool::EnqueueTask(std::function<void()> task) {
+    if (workers.empty()) {
+        task();
+        return;
+    }
+
+    {
+        std::lock_guard lock{mutex};
+        tasks.push_back(std::move(task));
+    }
+    work_available.notify_one();
+}
+
+void ThreadPool::WorkerLoop() {
+    SetCurrentThreadName("ThreadPool");
+
+    u64 last_generation = 0;
+    std::unique_lock lock{mutex};
+    while (true) {
+        work_available.wait(lock, [&] {
+            return stop_requested || generation != last_generation || !tasks.empty();
+        });
+
+        if (generation != last_generation) {
+            last_generation = generation;
+            if (job_func == nullptr) {
+                // The job was completed while this worker was running a task
+                continue;
+            }
+
+            ++busy_workers;
+            lock.unlock();
+            RunJob();
+            lock.lock();
+
+            if (--busy_workers == 0) {
+                job_done.notify_one();
+            }
+            continue;
+        }
+
+        // Queued tasks are still run when stopping, so that none of their futures is abandoned
+        if (!tasks.empty()) {
+            std::function<void()> task = std::move(tasks.front());
+            tasks.pop_front();
+
+            lock.unlock();
+            task();
+            lock.lock();
+            continue;
+        }
+
+        return;
+    }
+}
+
+void ThreadPool::RunJob() {
+    std::size_t index;
+    while ((index = next_index.fetch_add(1)) < job_count) {
+        (*job_func)(index);
+    }
+}
+
+} // namespace Common
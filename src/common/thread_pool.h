@@ -0,0 +1,89 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+#include "common/common_types.h"
+
+namespace Common {
+
+/**
+ * A fixed set of worker threads used to split a job into independent work items, or to run tasks
+ * in the background. The thread submitting a job takes part in processing it, so a pool with zero
+ * workers simply runs everything on the calling thread.
+ */
+class ThreadPool {
+public:
+    explicit ThreadPool(std::size_t num_workers);
+    ~ThreadPool();
+
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+
+    std::size_t NumWorkers() const {
+        return workers.size();
+    }
+
+    /**
+     * Calls func(i) for every i in [0, count) and returns once all calls have completed. The calls
+     * are spread over the calling thread and the workers that are idle, in no particular order, so
+     * workers busy with tasks from Submit don't hold the job up. Jobs submitted by several threads
+     * at once are processed one after another.
+     * NOTE: Not reentrant; func must not submit jobs to the same pool.
+     */
+    void ParallelFor(std::size_t count, const std::function<void(std::size_t)>& func);
+
+    /**
+     * Queues func to be run by one of the workers and returns a future for its result. Tasks are
+     * started in the order they were submitted, but jobs from ParallelFor take precedence over
+     * them. A pool with zero workers runs func before returning.
+     */
+    template <typename Func>
+    std::future<std::invoke_result_t<Func>> Submit(Func&& func) {
+        using Result = std::invoke_result_t<Func>;
+        // std::function needs a copyable target, so the task is shared with the queue entry
+        auto task = std::make_shared<std::packaged_task<Result()>>(std::forward<Func>(func));
+        std::future<Result> result = task->get_future();
+        EnqueueTask([task] { (*task)(); });
+        return result;
+    }
+
+private:
+    void WorkerLoop();
+    void RunJob();
+    void EnqueueTask(std::function<void()> task);
+
+    std::vector<std::thread> workers;
+
+    /// Held by the thread whose job is being processed
+    std::mutex submit_mutex;
+
+    std::mutex mutex;
+    std::condition_variable work_available;
+    std::condition_variable job_done;
+    bool stop_requested = false;
+    u64 generation = 0;
+    /// Number of workers that joined the current job and are still running it
+    std::size_t busy_workers = 0;
+
+    const std::function<void(std::size_t)>* job_func = nullptr;
+    std::size_t job_count = 0;
+    std::atomic<std::size_t> next_index{0};
+
+    /// Tasks from Submit that no worker has picked up yet
+    std::deque<std::function<void()>> tasks;
+};
+
+} // namespace Common
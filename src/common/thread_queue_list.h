@@ -4,31 +4,32 @@
 
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <deque>
+#include "common/bit_set.h"
+#include "common/common_types.h"
 
 namespace Common {
 
+/**
+ * Queues of threads for each priority level, with a bitmap of the non-empty levels so that the
+ * highest priority thread can be found in constant time. Lower values are higher priorities.
+ */
 template <class T, unsigned int N>
 struct ThreadQueueList {
-    // TODO(yuriks): If performance proves to be a problem, the std::deques can be replaced with
-    //               (dynamically resizable) circular buffers to remove their overhead when
-    //               inserting and popping.
+    static_assert(N <= 64, "The bitmap of non-empty queues only has room for 64 priorities");
 
     typedef unsigned int Priority;
 
     // Number of priority levels. (Valid levels are [0..NUM_QUEUES).)
     static const Priority NUM_QUEUES = N;
 
-    ThreadQueueList() {
-        first = nullptr;
-    }
-
     // Only for debugging, returns priority level.
     Priority contains(const T& uid) {
         for (Priority i = 0; i < NUM_QUEUES; ++i) {
-            Queue& cur = queues[i];
-            if (std::find(cur.data.cbegin(), cur.data.cend(), uid) != cur.data.cend()) {
+            std::deque<T>& cur = queues[i];
+            if (std::find(cur.cbegin(), cur.cend(), uid) != cur.cend()) {
                 return i;
             }
         }
@@ -37,125 +38,93 @@ struct ThreadQueueList {
     }
 
     T get_first() {
-        Queue* cur = first;
-        while (cur != nullptr) {
-            if (!cur->data.empty()) {
-                return cur->data.front();
-            }
-            cur = cur->next_nonempty;
+        if (nonempty_mask == 0) {
+            return T();
         }
-
-        return T();
+        return queues[FirstNonEmpty()].front();
     }
 
     T pop_first() {
-        Queue* cur = first;
-        while (cur != nullptr) {
-            if (!cur->data.empty()) {
-                auto tmp = std::move(cur->data.front());
-                cur->data.pop_front();
-                return tmp;
-            }
-            cur = cur->next_nonempty;
+        if (nonempty_mask == 0) {
+            return T();
         }
-
-        return T();
+        return PopFront(FirstNonEmpty());
     }
 
     T pop_first_better(Priority priority) {
-        Queue* cur = first;
-        Queue* stop = &queues[priority];
-        while (cur < stop) {
-            if (!cur->data.empty()) {
-                auto tmp = std::move(cur->data.front());
-                cur->data.pop_front();
-                return tmp;
-            }
-            cur = cur->next_nonempty;
+        // Only look at the levels above the given one
+        const u64 better_mask = nonempty_mask & ((u64(1) << priority) - 1);
+        if (better_mask == 0) {
+            return T();
         }
-
-        return T();
+        return PopFront(static_cast<Priority>(LeastSignificantSetBit(better_mask)));
     }
 
     void push_front(Priority priority, const T& thread_id) {
-        Queue* cur = &queues[priority];
-        cur->data.push_front(thread_id);
+        queues[priority].push_front(thread_id);
+        nonempty_mask |= u64(1) << priority;
     }
 
     void push_back(Priority priority, const T& thread_id) {
-        Queue* cur = &queues[priority];
-        cur->data.push_back(thread_id);
+        queues[priority].push_back(thread_id);
+        nonempty_mask |= u64(1) << priority;
     }
 
     void move(const T& thread_id, Priority old_priority, Priority new_priority) {
         remove(old_priority, thread_id);
-        prepare(new_priority);
         push_back(new_priority, thread_id);
     }
 
     void remove(Priority priority, const T& thread_id) {
-        Queue* const cur = &queues[priority];
-        const auto iter = std::remove(cur->data.begin(), cur->data.end(), thread_id);
-        cur->data.erase(iter, cur->data.end());
+        std::deque<T>& cur = queues[priority];
+        // A thread is queued at most once, and the one removed is usually at the front
+        const auto iter = std::find(cur.begin(), cur.end(), thread_id);
+        if (iter == cur.end()) {
+            return;
+        }
+        cur.erase(iter);
+        if (cur.empty()) {
+            nonempty_mask &= ~(u64(1) << priority);
+        }
     }
 
     void rotate(Priority priority) {
-        Queue* cur = &queues[priority];
+        std::deque<T>& cur = queues[priority];
 
-        if (cur->data.size() > 1) {
-            cur->data.push_back(std::move(cur->data.front()));
-            cur->data.pop_front();
+        if (cur.size() > 1) {
+            cur.push_back(std::move(cur.front()));
+            cur.pop_front();
         }
     }
 
     void clear() {
-        queues.fill(Queue());
-        first = nullptr;
+        queues.fill(std::deque<T>());
+        nonempty_mask = 0;
     }
 
     bool empty(Priority priority) const {
-        const Queue* cur = &queues[priority];
-        return cur->data.empty();
-    }
-
-    void prepare(Priority priority) {
-        Queue* cur = &queues[priority];
-        if (cur->next_nonempty == UnlinkedTag())
-            link(priority);
+        return queues[priority].empty();
     }
 
 private:
-    struct Queue {
-        // Points to the next active priority, skipping over ones that have never been used.
-        Queue* next_nonempty = UnlinkedTag();
-        // Double-ended queue of threads in this priority level
-        std::deque<T> data;
-    };
-
-    /// Special tag used to mark priority levels that have never been used.
-    static Queue* UnlinkedTag() {
-        return reinterpret_cast<Queue*>(1);
+    Priority FirstNonEmpty() const {
+        return static_cast<Priority>(LeastSignificantSetBit(nonempty_mask));
     }
 
-    void link(Priority priority) {
-        Queue* cur = &queues[priority];
-
-        for (int i = priority - 1; i >= 0; --i) {
-            if (queues[i].next_nonempty != UnlinkedTag()) {
-                cur->next_nonempty = queues[i].next_nonempty;
-                queues[i].next_nonempty = cur;
-                return;
-            }
+    T PopFront(Priority priority) {
+        std::deque<T>& cur = queues[priority];
+        T tmp = std::move(cur.front());
+        cur.pop_front();
+        if (cur.empty()) {
+            nonempty_mask &= ~(u64(1) << priority);
         }
-
-        cur->next_nonempty = first;
-        first = cur;
+        return tmp;
     }
 
-    // The first queue that's ever been used.
-    Queue* first;
+    // Bit i is set when the queue of priority level i is not empty.
+    u64 nonempty_mask = 0;
     // The priority level queues of thread ids.
-    std::array<Queue, NUM_QUEUES> queues;
+    std::array<std::deque<T>, NUM_QUEUES> queues;
 };
 
 } // namespace Common
@@ -274,11 +274,12 @@ void ARM_Dynarmic::ClearInstructionCache() {
     for (const auto& j : jits) {
         j.second->ClearCache();
     }
-    interpreter_state->instruction_cache.clear();
+    InterpreterClearCache(interpreter_state.get());
 }
 
 void ARM_Dynarmic::InvalidateCacheRange(u32 start_address, std::size_t length) {
     jit->InvalidateCacheRange(start_address, length);
+    InterpreterInvalidateCacheRange(interpreter_state.get(), start_address, length);
 }
 
 void ARM_Dynarmic::PageTableChanged() {
@@ -9,6 +9,7 @@
 #include <cstdio>
 #include "common/common_types.h"
 #include "common/logging/log.h"
+#include "common/metrics.h"
 #include "common/microprofile.h"
 #include "core/arm/dyncom/arm_dyncom_dec.h"
 #include "core/arm/dyncom/arm_dyncom_interpreter.h"
@@ -755,7 +756,8 @@ get_addr_fp_t GetAddressingOpLoadStoreT(unsigned int inst) {
 
 enum { FETCH_SUCCESS, FETCH_FAILURE };
 
-static ThumbDecodeStatus DecodeThumbInstruction(u32 inst, u32 addr, u32* arm_inst, u32* inst_size,
+static ThumbDecodeStatus DecodeThumbInstruction(ARMul_State* cpu, u32 inst, u32 addr,
+                                                u32* arm_inst, u32* inst_size,
                                                 ARM_INST_PTR* ptr_inst_base) {
     // Check if in Thumb mode
     ThumbDecodeStatus ret = TranslateThumbInstruction(addr, inst, arm_inst, inst_size);
@@ -769,7 +771,7 @@ static ThumbDecodeStatus DecodeThumbInstruction(u32 inst, u32 addr, u32* arm_ins
         case 27:
             if (((tinstr & 0x0F00) != 0x0E00) && ((tinstr & 0x0F00) != 0x0F00)) {
                 inst_index = table_length - 4;
-                *ptr_inst_base = arm_instruction_trans[inst_index](tinstr, inst_index);
+                *ptr_inst_base = arm_instruction_trans[inst_index](cpu, tinstr, inst_index);
             } else {
                 LOG_ERROR(Core_ARM11, "thumb decoder error");
             }
@@ -777,24 +779,24 @@ static ThumbDecodeStatus DecodeThumbInstruction(u32 inst, u32 addr, u32* arm_ins
         case 28:
             // Branch 2, unconditional branch
             inst_index = table_length - 5;
-            *ptr_inst_base = arm_instruction_trans[inst_index](tinstr, inst_index);
+            *ptr_inst_base = arm_instruction_trans[inst_index](cpu, tinstr, inst_index);
             break;
 
         case 8:
         case 29:
             // For BLX 1 thumb instruction
             inst_index = table_length - 1;
-            *ptr_inst_base = arm_instruction_trans[inst_index](tinstr, inst_index);
+            *ptr_inst_base = arm_instruction_trans[inst_index](cpu, tinstr, inst_index);
             break;
         case 30:
             // For BL 1 thumb instruction
             inst_index = table_length - 3;
-            *ptr_inst_base = arm_instruction_trans[inst_index](tinstr, inst_index);
+            *ptr_inst_base = arm_instruction_trans[inst_index](cpu, tinstr, inst_index);
             break;
         case 31:
             // For BL 2 thumb instruction
             inst_index = table_length - 2;
-            *ptr_inst_base = arm_instruction_trans[inst_index](tinstr, inst_index);
+            *ptr_inst_base = arm_instruction_trans[inst_index](cpu, tinstr, inst_index);
             break;
         default:
             ret = ThumbDecodeStatus::UNDEFINED;
@@ -807,8 +809,10 @@ static ThumbDecodeStatus DecodeThumbInstruction(u32 inst, u32 addr, u32* arm_ins
 enum { KEEP_GOING, FETCH_EXCEPTION };
 
 MICROPROFILE_DEFINE(DynCom_Decode, "DynCom", "Decode", MP_RGB(255, 64, 64));
+static const Common::Metrics::CounterId block_translation_counter =
+    Common::Metrics::RegisterCounter("dyncom.block_translations");
 
-static unsigned int InterpreterTranslateInstruction(const ARMul_State* cpu, const u32 phys_addr,
+static unsigned int InterpreterTranslateInstruction(ARMul_State* cpu, const u32 phys_addr,
                                                     ARM_INST_PTR& inst_base) {
     u32 inst_size = 4;
     u32 inst = cpu->memory.Read32(phys_addr & 0xFFFFFFFC);
@@ -818,7 +822,7 @@ static unsigned int InterpreterTranslateInstruction(const ARMul_State* cpu, cons
     if (cpu->TFlag) {
         u32 arm_inst;
         ThumbDecodeStatus state =
-            DecodeThumbInstruction(inst, phys_addr, &arm_inst, &inst_size, &inst_base);
+            DecodeThumbInstruction(cpu, inst, phys_addr, &arm_inst, &inst_size, &inst_base);
 
         // We have translated the Thumb branch instruction in the Thumb decoder
         if (state == ThumbDecodeStatus::BRANCH) {
@@ -835,28 +839,101 @@ static unsigned int InterpreterTranslateInstruction(const ARMul_State* cpu, cons
                   cpu->Reg[15]);
         CITRA_IGNORE_EXIT(-1);
     }
-    inst_base = arm_instruction_trans[idx](inst, idx);
+    inst_base = arm_instruction_trans[idx](cpu, inst, idx);
 
     return inst_size;
 }
 
+// Upper bound of the translation buffer space used by a single block. Blocks never cross a page
+// boundary, so they contain at most one instruction per halfword of a page.
+constexpr std::size_t MAX_BLOCK_TRANS_SIZE = (Memory::PAGE_SIZE / 2) * 256;
+
+void InterpreterClearCache(ARMul_State* cpu) {
+    cpu->instruction_cache.clear();
+    cpu->instruction_cache_pages.clear();
+    if (++cpu->instruction_cache_generation == 0) {
+        cpu->instruction_cache_generation = 1;
+    }
+    cpu->trans_cache_buf_top = 0;
+}
+
+void InterpreterInvalidateCacheRange(ARMul_State* cpu, u32 start_address, std::size_t length) {
+    if (length == 0) {
+        return;
+    }
+
+    const u32 first_page = start_address >> Memory::PAGE_BITS;
+    const u32 last_page = static_cast<u32>(
+        std::min<u64>(u64{start_address} + length - 1, 0xFFFFFFFF) >> Memory::PAGE_BITS);
+
+    // The space used by the discarded blocks is only reclaimed once the whole buffer is reset
+    const auto invalidate_page = [cpu](const std::vector<u32>& block_addresses) {
+        for (u32 block_address : block_addresses) {
+            cpu->instruction_cache.erase(block_address);
+        }
+    };
+
+    auto& pages = cpu->instruction_cache_pages;
+    const std::size_t num_pages_before = pages.size();
+    if (last_page - first_page >= pages.size()) {
+        for (auto it = pages.begin(); it != pages.end();) {
+            if (it->first >= first_page && it->first <= last_page) {
+                invalidate_page(it->second);
+                it = pages.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    } else {
+        for (u32 page = first_page; page <= last_page; ++page) {
+            auto it = pages.find(page);
+            if (it != pages.end()) {
+                invalidate_page(it->second);
+                pages.erase(it);
+            }
+        }
+    }
+
+    if (pages.size() != num_pages_before && ++cpu->instruction_cache_generation == 0) {
+        cpu->instruction_cache_generation = 1;
+    }
+}
+
+static void PrepareTranslationBuffer(ARMul_State* cpu) {
+    if (cpu->trans_cache_buf_top > TRANS_CACHE_SIZE - MAX_BLOCK_TRANS_SIZE) {
+        LOG_DEBUG(Core_ARM11, "Translation cache is full, flushing it");
+        InterpreterClearCache(cpu);
+    }
+}
+
+static void RegisterBlock(ARMul_State* cpu, u32 pc_start, u32 pc_end, std::size_t bb_start) {
+    cpu->instruction_cache[pc_start] = bb_start;
+    for (u32 page = pc_start >> Memory::PAGE_BITS; page <= (pc_end >> Memory::PAGE_BITS); ++page) {
+        cpu->instruction_cache_pages[page].push_back(pc_start);
+    }
+}
+
 static int InterpreterTranslateBlock(ARMul_State* cpu, std::size_t& bb_start, u32 addr) {
     MICROPROFILE_SCOPE(DynCom_Decode);
+    Common::Metrics::Increment(block_translation_counter);
 
     // Decode instruction, get index
     // Allocate memory and init InsCream
     // Go on next, until terminal instruction
     // Save start addr of basicblock in CreamCache
+    PrepareTranslationBuffer(cpu);
+
     ARM_INST_PTR inst_base = nullptr;
     TransExtData ret = TransExtData::NON_BRANCH;
     int size = 0; // instruction size of basic block
-    bb_start = trans_cache_buf_top;
+    bb_start = cpu->trans_cache_buf_top;
 
     u32 phys_addr = addr;
     u32 pc_start = cpu->Reg[15];
 
     while (ret == TransExtData::NON_BRANCH) {
         unsigned int inst_size = InterpreterTranslateInstruction(cpu, phys_addr, inst_base);
+        inst_base->link_generation = 0;
 
         size++;
 
@@ -868,7 +945,7 @@ static int InterpreterTranslateBlock(ARMul_State* cpu, std::size_t& bb_start, u3
         ret = inst_base->br;
     };
 
-    cpu->instruction_cache[pc_start] = bb_start;
+    RegisterBlock(cpu, pc_start, phys_addr - 1, bb_start);
 
     return KEEP_GOING;
 }
@@ -876,19 +953,22 @@ static int InterpreterTranslateBlock(ARMul_State* cpu, std::size_t& bb_start, u3
 static int InterpreterTranslateSingle(ARMul_State* cpu, std::size_t& bb_start, u32 addr) {
     MICROPROFILE_SCOPE(DynCom_Decode);
 
+    PrepareTranslationBuffer(cpu);
+
     ARM_INST_PTR inst_base = nullptr;
-    bb_start = trans_cache_buf_top;
+    bb_start = cpu->trans_cache_buf_top;
 
     u32 phys_addr = addr;
     u32 pc_start = cpu->Reg[15];
 
-    InterpreterTranslateInstruction(cpu, phys_addr, inst_base);
+    unsigned int inst_size = InterpreterTranslateInstruction(cpu, phys_addr, inst_base);
+    inst_base->link_generation = 0;
 
     if (inst_base->br == TransExtData::NON_BRANCH) {
         inst_base->br = TransExtData::SINGLE_STEP;
     }
 
-    cpu->instruction_cache[pc_start] = bb_start;
+    RegisterBlock(cpu, pc_start, phys_addr + inst_size - 1, bb_start);
 
     return KEEP_GOING;
 }
@@ -948,7 +1028,7 @@ unsigned InterpreterMainLoop(ARMul_State* cpu) {
 #define FETCH_INST                                                                                 \
     if (inst_base->br != TransExtData::NON_BRANCH)                                                 \
         goto DISPATCH;                                                                             \
-    inst_base = (arm_inst*)&trans_cache_buf[ptr]
+    inst_base = (arm_inst*)&cpu->trans_cache_buf[ptr]
 
 #define INC_PC(l) ptr += sizeof(arm_inst) + l
 #define INC_PC_STUB ptr += sizeof(arm_inst)
@@ -1621,11 +1701,14 @@ unsigned InterpreterMainLoop(ARMul_State* cpu) {
                          &&INIT_INST_LENGTH,
                          &&END};
 #endif
-    arm_inst* inst_base;
+    arm_inst* inst_base = nullptr;
     unsigned int addr;
     unsigned int num_instrs = 0;
 
     std::size_t ptr;
+    // Cache generation at the time the current block was entered. If it has changed by the next
+    // dispatch, the memory of the block may have been reused and its exit can't be linked.
+    u32 block_generation = 0;
 
     LOAD_NZCVT;
 DISPATCH : {
@@ -1640,16 +1723,35 @@ DISPATCH : {
     else
         cpu->Reg[15] &= 0xfffffffc;
 
-    // Find the cached instruction cream, otherwise translate it...
-    auto itr = cpu->instruction_cache.find(cpu->Reg[15]);
-    if (itr != cpu->instruction_cache.end()) {
-        ptr = itr->second;
-    } else if (cpu->NumInstrsToExecute != 1) {
-        if (InterpreterTranslateBlock(cpu, ptr, cpu->Reg[15]) == FETCH_EXCEPTION)
-            goto END;
-    } else {
-        if (InterpreterTranslateSingle(cpu, ptr, cpu->Reg[15]) == FETCH_EXCEPTION)
-            goto END;
+    {
+        // Follow the link of the instruction that ended the previous block if it still leads to
+        // the current address, which skips the cache lookup for most block transitions.
+        arm_inst* const exit_inst =
+            block_generation == cpu->instruction_cache_generation ? inst_base : nullptr;
+        if (exit_inst != nullptr && exit_inst->link_generation == block_generation &&
+            exit_inst->link_pc == cpu->Reg[15]) {
+            ptr = exit_inst->link_ptr;
+        } else {
+            // Find the cached instruction cream, otherwise translate it...
+            auto itr = cpu->instruction_cache.find(cpu->Reg[15]);
+            if (itr != cpu->instruction_cache.end()) {
+                ptr = itr->second;
+            } else if (cpu->NumInstrsToExecute != 1) {
+                if (InterpreterTranslateBlock(cpu, ptr, cpu->Reg[15]) == FETCH_EXCEPTION)
+                    goto END;
+            } else {
+                if (InterpreterTranslateSingle(cpu, ptr, cpu->Reg[15]) == FETCH_EXCEPTION)
+                    goto END;
+            }
+
+            // Translating may have flushed the buffer the exit instruction lives in
+            if (exit_inst != nullptr && block_generation == cpu->instruction_cache_generation) {
+                exit_inst->link_pc = cpu->Reg[15];
+                exit_inst->link_ptr = static_cast<u32>(ptr);
+                exit_inst->link_generation = block_generation;
+            }
+        }
+        block_generation = cpu->instruction_cache_generation;
     }
 
     // Find breakpoint if one exists within the block
@@ -1658,7 +1760,7 @@ DISPATCH : {
             GDBStub::GetNextBreakpointFromAddress(cpu->Reg[15], GDBStub::BreakpointType::Execute);
     }
 
-    inst_base = (arm_inst*)&trans_cache_buf[ptr];
+    inst_base = (arm_inst*)&cpu->trans_cache_buf[ptr];
     GOTO_NEXT_INST;
 }
 ADC_INST : {
@@ -4,6 +4,15 @@
 
 #pragma once
 
+#include <cstddef>
+#include "common/common_types.h"
+
 struct ARMul_State;
 
 unsigned InterpreterMainLoop(ARMul_State* state);
+
+/// Discards every translated block and resets the translation buffer
+void InterpreterClearCache(ARMul_State* state);
+
+/// Discards the translated blocks overlapping the pages of the given address range
+void InterpreterInvalidateCacheRange(ARMul_State* state, u32 start_address, std::size_t length);
@@ -26,6 +26,11 @@ struct arm_inst {
     unsigned int idx;
     unsigned int cond;
     TransExtData br;
+    // Block dispatched to the last time execution left its block through this instruction. The
+    // link is only valid while link_generation matches the cache generation of the CPU state.
+    u32 link_pc;
+    u32 link_ptr;
+    u32 link_generation;
     char component[0];
 };
 
@@ -488,11 +493,10 @@ struct ldst_inst {
 };
 
 typedef arm_inst* ARM_INST_PTR;
-typedef ARM_INST_PTR (*transop_fp_t)(unsigned int, int);
+typedef ARM_INST_PTR (*transop_fp_t)(ARMul_State*, unsigned int, int);
 
 extern const transop_fp_t arm_instruction_trans[];
 extern const std::size_t arm_instruction_trans_len;
 
 #define TRANS_CACHE_SIZE (64 * 1024 * 2000)
-extern char trans_cache_buf[TRANS_CACHE_SIZE];
-extern std::size_t trans_cache_buf_top;
+static_assert(TRANS_CACHE_SIZE <= 0xFFFFFFFF, "Block links store 32-bit cache offsets");
@@ -0,0 +1,254 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include "core/arm/arm_interface.h"
+#include "core/arm/idle_loop_detector.h"
+#include "core/memory.h"
+
+namespace Core {
+
+namespace {
+
+constexpr u32 CONDITION_ALWAYS = 0xE;
+
+constexpr u32 FLAG_N = 1u << 31;
+constexpr u32 FLAG_Z = 1u << 30;
+constexpr u32 FLAG_C = 1u << 29;
+constexpr u32 FLAG_V = 1u << 28;
+constexpr u32 THUMB_BIT = 1u << 5;
+
+bool ConditionPassed(u32 condition, u32 cpsr) {
+    const bool n = (cpsr & FLAG_N) != 0;
+    const bool z = (cpsr & FLAG_Z) != 0;
+    const bool c = (cpsr & FLAG_C) != 0;
+    const bool v = (cpsr & FLAG_V) != 0;
+
+    switch (condition) {
+    case 0x0:
+        return z;
+    case 0x1:
+        return !z;
+    case 0x2:
+        return c;
+    case 0x3:
+        return !c;
+    case 0x4:
+        return n;
+    case 0x5:
+        return !n;
+    case 0x6:
+        return v;
+    case 0x7:
+        return !v;
+    case 0x8:
+        return c && !z;
+    case 0x9:
+        return !c || z;
+    case 0xA:
+        return n == v;
+    case 0xB:
+        return n != v;
+    case 0xC:
+        return !z && n == v;
+    case 0xD:
+        return z || n != v;
+    case 0xE:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/// Reads a register as an operand of the instruction at the given address
+u32 ReadOperand(const std::array<u32, 16>& regs, u32 index, VAddr instruction_address) {
+    return index == 15 ? instruction_address + 8 : regs[index];
+}
+
+} // Anonymous namespace
+
+IdleLoopDetector::IdleLoopDetector(Memory::MemorySystem& memory) : memory(memory) {}
+
+bool IdleLoopDetector::IsIdle(const ARM_Interface& cpu) const {
+    State state;
+    state.cpsr = cpu.GetCPSR();
+    if (state.cpsr & THUMB_BIT) {
+        return false;
+    }
+    for (int i = 0; i < 15; ++i) {
+        state.regs[i] = cpu.GetReg(i);
+    }
+    const VAddr pc = cpu.GetPC();
+    state.regs[15] = pc;
+
+    // The first iteration may still read registers loaded by the one before it was interrupted. The
+    // second only sees values loaded from memory, and so do all the iterations after it as long as
+    // the memory doesn't change.
+    for (int iteration = 0; iteration < 2; ++iteration) {
+        const std::optional<bool> looped = RunIteration(pc, state);
+        if (!looped || !*looped) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+std::optional<u32> IdleLoopDetector::ReadRam(VAddr address, u32 size) const {
+    if ((address & (size - 1)) != 0) {
+        return std::nullopt;
+    }
+
+    // Reading I/O registers could have side effects, and they may change without an event
+    const Memory::PageTable& page_table = *memory.GetCurrentPageTable();
+    const u32 page = address >> Memory::PAGE_BITS;
+    if (page_table.attributes[page] != Memory::PageType::Memory) {
+        return std::nullopt;
+    }
+
+    const u8* pointer = page_table.pointers[page] + (address & Memory::PAGE_MASK);
+    switch (size) {
+    case 1:
+        return *pointer;
+    case 2: {
+        u16 value;
+        std::memcpy(&value, pointer, sizeof(value));
+        return value;
+    }
+    default: {
+        u32 value;
+        std::memcpy(&value, pointer, sizeof(value));
+        return value;
+    }
+    }
+}
+
+std::optional<bool> IdleLoopDetector::RunIteration(VAddr loop_start, State& state) const {
+    for (u32 i = 0; i < MAX_LOOP_LENGTH; ++i) {
+        const VAddr address = loop_start + i * 4;
+        const std::optional<u32> fetched = ReadRam(address, 4);
+        if (!fetched) {
+            return std::nullopt;
+        }
+        const u32 inst = *fetched;
+        const u32 condition = inst >> 28;
+
+        // B <label>, which has to jump back to the start of the loop
+        if ((inst & 0x0F000000) == 0x0A000000) {
+            const s32 offset = static_cast<s32>(inst << 8) >> 6;
+            if (condition == 0xF || address + 8 + offset != loop_start) {
+                return std::nullopt;
+            }
+            return ConditionPassed(condition, state.cpsr);
+        }
+
+        // Everything before the branch has to run unconditionally
+        if (condition != CONDITION_ALWAYS) {
+            return std::nullopt;
+        }
+
+        // LDR/LDRB Rd, [Rn, #+/-imm12]
+        if ((inst & 0x0F300000) == 0x05100000) {
+            const u32 rd = (inst >> 12) & 0xF;
+            if (rd == 15) {
+                return std::nullopt;
+            }
+            const u32 offset = inst & 0xFFF;
+            const u32 base = ReadOperand(state.regs, (inst >> 16) & 0xF, address);
+            const bool up = (inst & (1 << 23)) != 0;
+            const bool byte = (inst & (1 << 22)) != 0;
+
+            const std::optional<u32> value = ReadRam(up ? base + offset : base - offset,
+                                                     byte ? 1 : 4);
+            if (!value) {
+                return std::nullopt;
+            }
+            state.regs[rd] = *value;
+            continue;
+        }
+
+        // LDRH/LDRSH/LDRSB Rd, [Rn, #+/-imm8]
+        if ((inst & 0x0F700090) == 0x01500090 && (inst & 0x60) != 0) {
+            const u32 rd = (inst >> 12) & 0xF;
+            if (rd == 15) {
+                return std::nullopt;
+            }
+            const u32 offset = ((inst >> 4) & 0xF0) | (inst & 0xF);
+            const u32 base = ReadOperand(state.regs, (inst >> 16) & 0xF, address);
+            const bool up = (inst & (1 << 23)) != 0;
+            const bool is_signed = (inst & (1 << 6)) != 0;
+            const bool halfword = (inst & (1 << 5)) != 0;
+
+            const std::optional<u32> value = ReadRam(up ? base + offset : base - offset,
+                                                     halfword ? 2 : 1);
+            if (!value) {
+                return std::nullopt;
+            }
+            if (!is_signed) {
+                state.regs[rd] = *value;
+            } else if (halfword) {
+                state.regs[rd] = static_cast<u32>(static_cast<s16>(*value));
+            } else {
+                state.regs[rd] = static_cast<u32>(static_cast<s8>(*value));
+            }
+            continue;
+        }
+
+        // TST/TEQ/CMP/CMN Rn, <operand>
+        if ((inst & 0x0D900000) == 0x01100000) {
+            const u32 a = ReadOperand(state.regs, (inst >> 16) & 0xF, address);
+            u32 b;
+            bool shifter_carry = (state.cpsr & FLAG_C) != 0;
+            if (inst & (1 << 25)) {
+                const u32 rotate = ((inst >> 8) & 0xF) * 2;
+                const u32 imm = inst & 0xFF;
+                b = rotate == 0 ? imm : (imm >> rotate) | (imm << (32 - rotate));
+                if (rotate != 0) {
+                    shifter_carry = (b >> 31) != 0;
+                }
+            } else {
+                // Shifted register operands are not supported
+                if ((inst & 0xFF0) != 0) {
+                    return std::nullopt;
+                }
+                b = ReadOperand(state.regs, inst & 0xF, address);
+            }
+
+            u32 result;
+            bool carry;
+            bool overflow = (state.cpsr & FLAG_V) != 0;
+            switch ((inst >> 21) & 0xF) {
+            case 0x8: // TST
+                result = a & b;
+                carry = shifter_carry;
+                break;
+            case 0x9: // TEQ
+                result = a ^ b;
+                carry = shifter_carry;
+                break;
+            case 0xA: // CMP
+                result = a - b;
+                carry = a >= b;
+                overflow = (((a ^ b) & (a ^ result)) >> 31) != 0;
+                break;
+            default: // CMN
+                result = a + b;
+                carry = result < a;
+                overflow = ((~(a ^ b) & (a ^ result)) >> 31) != 0;
+                break;
+            }
+
+            state.cpsr &= ~(FLAG_N | FLAG_Z | FLAG_C | FLAG_V);
+            state.cpsr |= (result & FLAG_N) | (result == 0 ? FLAG_Z : 0) | (carry ? FLAG_C : 0) |
+                          (overflow ? FLAG_V : 0);
+            continue;
+        }
+
+        return std::nullopt;
+    }
+
+    return std::nullopt;
+}
+
+} // namespace Core
@@ -0,0 +1,65 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <optional>
+#include "common/common_types.h"
+
+class ARM_Interface;
+
+namespace Memory {
+class MemorySystem;
+}
+
+namespace Core {
+
+/**
+ * Recognizes guest threads that spin in a tight loop polling memory, such as
+ *
+ *     loop: LDR  r0, [r1, #4]
+ *           CMP  r0, #0
+ *           BEQ  loop
+ *
+ * Such a loop has no side effects, so as long as it only reads plain RAM it can only stop spinning
+ * once something else changes that memory. Nothing else runs until the next scheduled event, so the
+ * emulator may skip straight to it instead of executing the loop for the rest of the time slice.
+ *
+ * Only ARM mode loops made of immediate offset loads, flag setting comparisons (CMP, CMN, TST and
+ * TEQ) and a final branch back to the first instruction are recognized.
+ */
+class IdleLoopDetector {
+public:
+    explicit IdleLoopDetector(Memory::MemorySystem& memory);
+
+    /**
+     * Checks whether the CPU is at the start of an idle loop that will keep spinning with the
+     * current contents of memory.
+     */
+    bool IsIdle(const ARM_Interface& cpu) const;
+
+private:
+    /// Maximum number of instructions in a recognized loop, including the final branch
+    static constexpr u32 MAX_LOOP_LENGTH = 8;
+
+    struct State {
+        std::array<u32, 16> regs;
+        u32 cpsr;
+    };
+
+    /// Reads a word of plain RAM, failing for unmapped and MMIO pages or unaligned addresses
+    std::optional<u32> ReadRam(VAddr address, u32 size) const;
+
+    /**
+     * Executes one iteration of the loop starting at the given address.
+     * @returns whether the iteration ended by branching back to the start, or nullopt if the code
+     * is not an idle loop
+     */
+    std::optional<bool> RunIteration(VAddr loop_start, State& state) const;
+
+    Memory::MemorySystem& memory;
+};
+
+} // namespace Core
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include "common/logging/log.h"
 #include "common/swap.h"
+#include "core/arm/dyncom/arm_dyncom_trans.h"
 #include "core/arm/skyeye_common/armstate.h"
 #include "core/arm/skyeye_common/vfp/vfp.h"
 #include "core/core.h"
@@ -12,7 +13,7 @@
 
 ARMul_State::ARMul_State(Core::System* system, Memory::MemorySystem& memory,
                          PrivilegeMode initial_mode)
-    : system(system), memory(memory) {
+    : system(system), memory(memory), trans_cache_buf(new char[TRANS_CACHE_SIZE]) {
     Reset();
     ChangePrivilegeMode(initial_mode);
 }
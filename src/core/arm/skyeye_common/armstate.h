@@ -18,7 +18,9 @@
 #pragma once
 
 #include <array>
+#include <memory>
 #include <unordered_map>
+#include <vector>
 #include "common/common_types.h"
 #include "core/arm/skyeye_common/arm_regformat.h"
 #include "core/gdbstub/gdbstub.h"
@@ -255,6 +257,15 @@ public:
     // TODO(bunnei): Move this cache to a better place - it should be per codeset (likely per
     // process for our purposes), not per ARMul_State (which tracks CPU core state).
     std::unordered_map<u32, std::size_t> instruction_cache;
+    // Start addresses of the cached blocks overlapping each page, so that writes to code only
+    // discard the blocks they can affect.
+    std::unordered_map<u32, std::vector<u32>> instruction_cache_pages;
+    // Incremented whenever cached blocks are discarded, which invalidates every block link.
+    u32 instruction_cache_generation = 1;
+    // Backing storage for the translated blocks referenced by instruction_cache. Each core owns
+    // its own buffer so that cores of separate System instances can translate concurrently.
+    std::unique_ptr<char[]> trans_cache_buf;
+    std::size_t trans_cache_buf_top = 0;
 
 private:
     void ResetMPCoreCP15Registers();
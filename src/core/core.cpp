@@ -2,17 +2,24 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <cstdlib>
 #include <memory>
 #include <utility>
 #include "audio_core/dsp_interface.h"
 #include "audio_core/hle/hle.h"
 #include "audio_core/lle/lle.h"
+#include "common/common_paths.h"
+#include "common/file_util.h"
 #include "common/logging/log.h"
+#include "common/metrics.h"
+#include "common/string_util.h"
 #include "core/arm/arm_interface.h"
 #ifdef ARCHITECTURE_x86_64
 #include "core/arm/dynarmic/arm_dynarmic.h"
 #endif
 #include "core/arm/dyncom/arm_dyncom.h"
+#include "core/arm/idle_loop_detector.h"
 #include "core/cheats/cheats.h"
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -24,7 +31,9 @@
 #include "core/hle/service/fs/archive.h"
 #include "core/hle/service/service.h"
 #include "core/hle/service/sm/sm.h"
+#include "core/hw/gpu.h"
 #include "core/hw/hw.h"
+#include "core/hw/lcd.h"
 #include "core/loader/loader.h"
 #include "core/movie.h"
 #include "core/rpc/rpc_server.h"
@@ -34,7 +43,17 @@
 
 namespace Core {
 
+static const Common::Metrics::CounterId idle_loop_skip_counter =
+    Common::Metrics::RegisterCounter("cpu.idle_loop_skips");
+
 /*static*/ System System::s_instance;
+/*static*/ thread_local System* System::s_current_instance = &System::s_instance;
+
+System::System()
+    : video_context(std::make_unique<VideoCore::Context>()),
+      gpu_context(std::make_unique<GPU::Context>()), lcd_regs(std::make_unique<LCD::Regs>()) {}
+
+System::~System() = default;
 
 System::ResultStatus System::RunLoop(bool tight_loop) {
     status = ResultStatus::Success;
@@ -60,13 +79,29 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
     // instead advance to the next event and try to yield to the next thread
     if (kernel->GetThreadManager().GetCurrentThread() == nullptr) {
         LOG_TRACE(Core_ARM11, "Idling");
-        timing->Idle();
+        // Work in flight on the GPU thread may raise the interrupt a thread is waiting on, so only
+        // skip ahead to the next event once it has completed without waking anything up.
+        if (!GPU::SyncGPUThread()) {
+            timing->Idle();
+        }
         timing->Advance();
         PrepareReschedule();
     } else {
         timing->Advance();
         if (tight_loop) {
-            cpu_core->Run();
+            // A thread polling memory in a loop can only be released by something that happens at
+            // the next event, such as an interrupt or another thread running, so skip ahead to it.
+            // Work in flight on the GPU thread may write the polled memory without raising an
+            // interrupt, so the loop is checked again once that work has completed. The first
+            // check only avoids waiting for the GPU thread on every slice.
+            if (idle_loop_detector != nullptr && idle_loop_detector->IsIdle(*cpu_core) &&
+                !GPU::SyncGPUThread() && idle_loop_detector->IsIdle(*cpu_core)) {
+                LOG_TRACE(Core_ARM11, "Skipping idle loop at {:08X}", cpu_core->GetPC());
+                Common::Metrics::Increment(idle_loop_skip_counter);
+                timing->Idle();
+            } else {
+                cpu_core->Run();
+            }
         } else {
             cpu_core->Step();
         }
@@ -88,6 +123,15 @@ System::ResultStatus System::RunLoop(bool tight_loop) {
     return status;
 }
 
+/// Checks whether the settings disable idle loop skipping for the given title
+static bool IsIdleLoopSkipDisabled(u64 program_id) {
+    std::vector<std::string> titles;
+    Common::SplitString(Settings::values.idle_loop_skip_disabled_titles, ',', titles);
+    return std::any_of(titles.begin(), titles.end(), [program_id](const std::string& title) {
+        return std::strtoull(Common::StripSpaces(title).c_str(), nullptr, 16) == program_id;
+    });
+}
+
 System::ResultStatus System::SingleStep() {
     return RunLoop(false);
 }
@@ -142,6 +186,17 @@ System::ResultStatus System::Load(Frontend::EmuWindow& emu_window, const std::st
         }
     }
     cheat_engine = std::make_unique<Cheats::CheatEngine>(*this);
+
+    u64 program_id = 0;
+    app_loader->ReadProgramId(program_id);
+    if (!Settings::values.use_idle_loop_skip) {
+        LOG_INFO(Core, "Idle loop skipping is disabled");
+    } else if (IsIdleLoopSkipDisabled(program_id)) {
+        LOG_INFO(Core, "Idle loop skipping is disabled for title {:016X}", program_id);
+    } else {
+        idle_loop_detector = std::make_unique<IdleLoopDetector>(*memory);
+    }
+
     status = ResultStatus::Success;
     m_emu_window = &emu_window;
     m_filepath = filepath;
@@ -292,15 +347,24 @@ void System::Shutdown() {
     telemetry_session->AddField(Telemetry::FieldType::Performance, "Shutdown_Frametime",
                                 perf_results.frametime * 1000.0);
 
+    // Keep the hot path counters of the session around for later inspection
+    const std::string metrics_path =
+        FileUtil::GetUserPath(FileUtil::UserPath::LogDir) + METRICS_FILE;
+    if (!Common::Metrics::WriteSnapshot(metrics_path)) {
+        LOG_WARNING(Core, "Failed to write metrics to {}", metrics_path);
+    }
+
     // Shutdown emulation session
     GDBStub::Shutdown();
-    VideoCore::Shutdown();
+    // HW goes first so that the GPU thread is drained before the renderer is destroyed
     HW::Shutdown();
+    VideoCore::Shutdown();
     telemetry_session.reset();
     rpc_server.reset();
     cheat_engine.reset();
     service_manager.reset();
     dsp_core.reset();
+    idle_loop_detector.reset();
     cpu_core.reset();
     kernel.reset();
     timing.reset();
@@ -49,18 +49,50 @@ namespace Cheats {
 class CheatEngine;
 }
 
+namespace VideoCore {
+struct Context;
+}
+
+namespace GPU {
+struct Context;
+}
+
+namespace LCD {
+struct Regs;
+}
+
 namespace Core {
 
+class IdleLoopDetector;
 class Timing;
 
 class System {
 public:
     /**
-     * Gets the instance of the System singleton class.
-     * @returns Reference to the instance of the System singleton class.
+     * Creates an emulated console. Besides the default instance, any number of them may run in one
+     * process, each on its own host thread after binding itself with MakeCurrent().
+     */
+    System();
+    ~System();
+
+    System(const System&) = delete;
+    System& operator=(const System&) = delete;
+
+    /**
+     * Gets the instance bound to the calling host thread, which is the default instance unless
+     * another one was bound with MakeCurrent().
+     * @returns Reference to the current System instance.
      */
     static System& GetInstance() {
-        return s_instance;
+        return *s_current_instance;
+    }
+
+    /**
+     * Binds this instance to the calling host thread, so that GetInstance() and the per-console
+     * state of the GPU and video core refer to it from then on.
+     */
+    void MakeCurrent() {
+        s_current_instance = this;
     }
 
     /// Enumeration representing the return values of the System Initialize and Load process.
@@ -206,6 +238,21 @@ public:
     /// Gets a const reference to the cheat engine
     const Cheats::CheatEngine& CheatEngine() const;
 
+    /// Gets a reference to the state of the video core
+    VideoCore::Context& VideoContext() {
+        return *video_context;
+    }
+
+    /// Gets a reference to the state of the GPU
+    GPU::Context& GPUContext() {
+        return *gpu_context;
+    }
+
+    /// Gets a reference to the LCD registers
+    LCD::Regs& LCDRegs() {
+        return *lcd_regs;
+    }
+
     PerfStats perf_stats;
     FrameLimiter frame_limiter;
 
@@ -257,6 +304,9 @@ private:
     /// ARM11 CPU core
     std::shared_ptr<ARM_Interface> cpu_core;
 
+    /// Detects threads spinning in idle loops, unless disabled for the current title
+    std::unique_ptr<IdleLoopDetector> idle_loop_detector;
+
     /// DSP core
     std::unique_ptr<AudioCore::DspInterface> dsp_core;
 
@@ -285,17 +335,23 @@ private:
     std::unique_ptr<Kernel::KernelSystem> kernel;
     std::unique_ptr<Timing> timing;
 
+    /// Hardware state, which lives as long as the instance so that other threads may refer to it
+    std::unique_ptr<VideoCore::Context> video_context;
+    std::unique_ptr<GPU::Context> gpu_context;
+    std::unique_ptr<LCD::Regs> lcd_regs;
+
 private:
     static System s_instance;
+    static thread_local System* s_current_instance;
 
     ResultStatus status = ResultStatus::Success;
     std::string status_details = "";
     /// Saved variables for reset
-    Frontend::EmuWindow* m_emu_window;
+    Frontend::EmuWindow* m_emu_window{};
     std::string m_filepath;
 
-    std::atomic<bool> reset_requested;
-    std::atomic<bool> shutdown_requested;
+    std::atomic<bool> reset_requested{};
+    std::atomic<bool> shutdown_requested{};
 };
 
 inline ARM_Interface& CPU() {
@@ -12,10 +12,6 @@
 namespace Core {
 
 // Sort by time, unless the times are the same, in which case sort by the order added to the queue
-bool Timing::Event::operator>(const Event& right) const {
-    return std::tie(time, fifo_order) > std::tie(right.time, right.fifo_order);
-}
-
 bool Timing::Event::operator<(const Event& right) const {
     return std::tie(time, fifo_order) < std::tie(right.time, right.fifo_order);
 }
@@ -63,8 +59,7 @@ void Timing::ScheduleEvent(s64 cycles_into_future, const TimingEventType* event_
     if (!is_global_timer_sane)
         ForceExceptionCheck(cycles_into_future);
 
-    event_queue.emplace_back(Event{timeout, event_fifo_id++, userdata, event_type});
-    std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    PushEvent(Event{timeout, event_fifo_id++, userdata, event_type});
 }
 
 void Timing::ScheduleEventThreadsafe(s64 cycles_into_future, const TimingEventType* event_type,
@@ -73,25 +68,24 @@ void Timing::ScheduleEventThreadsafe(s64 cycles_into_future, const TimingEventTy
 }
 
 void Timing::UnscheduleEvent(const TimingEventType* event_type, u64 userdata) {
-    auto itr = std::remove_if(event_queue.begin(), event_queue.end(), [&](const Event& e) {
-        return e.type == event_type && e.userdata == userdata;
-    });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    auto [itr, end] = event_index.equal_range(EventKey{event_type, userdata});
+    while (itr != end) {
+        RemoveSlot(itr->second);
+        free_index_nodes.push_back(event_index.extract(itr++));
     }
 }
 
 void Timing::RemoveEvent(const TimingEventType* event_type) {
-    auto itr = std::remove_if(event_queue.begin(), event_queue.end(),
-                              [&](const Event& e) { return e.type == event_type; });
-
-    // Removing random items breaks the invariant so we have to re-establish it.
-    if (itr != event_queue.end()) {
-        event_queue.erase(itr, event_queue.end());
-        std::make_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+    // Only used when tearing down a service or applet, so a scan of the queue is fine here
+    std::vector<u32> slots;
+    for (u32 slot : event_queue) {
+        if (event_slots[slot].type == event_type) {
+            slots.push_back(slot);
+        }
+    }
+    for (u32 slot : slots) {
+        UnindexSlot(slot);
+        RemoveSlot(slot);
     }
 }
 
@@ -111,8 +105,7 @@ void Timing::ForceExceptionCheck(s64 cycles) {
 void Timing::MoveEvents() {
     for (Event ev; ts_queue.Pop(ev);) {
         ev.fifo_order = event_fifo_id++;
-        event_queue.emplace_back(std::move(ev));
-        std::push_heap(event_queue.begin(), event_queue.end(), std::greater<>());
+        PushEvent(ev);
     }
 }
 
@@ -125,10 +118,11 @@ void Timing::Advance() {
 
     is_global_timer_sane = true;
 
-    while (!event_queue.empty() && event_queue.front().time <= global_timer) {
-        Event evt = std::move(event_queue.front());
-        std::pop_heap(event_queue.begin(), event_queue.end(), std::greater<>());
-        event_queue.pop_back();
+    while (!event_queue.empty() && NextEvent().time <= global_timer) {
+        const u32 slot = event_queue.front();
+        const Event evt = event_slots[slot];
+        UnindexSlot(slot);
+        RemoveSlot(slot);
         evt.type->callback(evt.userdata, global_timer - evt.time);
     }
 
@@ -137,7 +131,7 @@ void Timing::Advance() {
     // Still events left (scheduled in the future)
     if (!event_queue.empty()) {
         slice_length = static_cast<int>(
-            std::min<s64>(event_queue.front().time - global_timer, MAX_SLICE_LENGTH));
+            std::min<s64>(NextEvent().time - global_timer, MAX_SLICE_LENGTH));
     }
 
     downcount = slice_length;
@@ -156,4 +150,100 @@ s64 Timing::GetDowncount() const {
     return downcount;
 }
 
+void Timing::PushEvent(const Event& event) {
+    u32 slot;
+    if (free_event_slots.empty()) {
+        slot = static_cast<u32>(event_slots.size());
+        event_slots.push_back(event);
+        event_queue_positions.push_back(0);
+    } else {
+        slot = free_event_slots.back();
+        free_event_slots.pop_back();
+        event_slots[slot] = event;
+    }
+
+    event_queue_positions[slot] = static_cast<u32>(event_queue.size());
+    event_queue.push_back(slot);
+    SiftUp(event_queue.size() - 1);
+    if (free_index_nodes.empty()) {
+        event_index.emplace(EventKey{event.type, event.userdata}, slot);
+    } else {
+        EventIndex::node_type node = std::move(free_index_nodes.back());
+        free_index_nodes.pop_back();
+        node.key() = EventKey{event.type, event.userdata};
+        node.mapped() = slot;
+        event_index.insert(std::move(node));
+    }
+}
+
+void Timing::RemoveSlot(u32 slot) {
+    const std::size_t position = event_queue_positions[slot];
+    const u32 last_slot = event_queue.back();
+    event_queue.pop_back();
+    free_event_slots.push_back(slot);
+
+    if (position == event_queue.size()) {
+        return;
+    }
+
+    // Move the last event into the hole and restore the heap property around it
+    event_queue[position] = last_slot;
+    event_queue_positions[last_slot] = static_cast<u32>(position);
+    SiftUp(position);
+    SiftDown(event_queue_positions[last_slot]);
+}
+
+void Timing::UnindexSlot(u32 slot) {
+    const Event& event = event_slots[slot];
+    const auto [begin, end] = event_index.equal_range(EventKey{event.type, event.userdata});
+    for (auto itr = begin; itr != end; ++itr) {
+        if (itr->second == slot) {
+            free_index_nodes.push_back(event_index.extract(itr));
+            return;
+        }
+    }
+    UNREACHABLE();
+}
+
+bool Timing::IsEarlier(u32 slot_a, u32 slot_b) const {
+    return event_slots[slot_a] < event_slots[slot_b];
+}
+
+void Timing::SiftUp(std::size_t position) {
+    const u32 slot = event_queue[position];
+    while (position > 0) {
+        const std::size_t parent = (position - 1) / 2;
+        if (!IsEarlier(slot, event_queue[parent])) {
+            break;
+        }
+        event_queue[position] = event_queue[parent];
+        event_queue_positions[event_queue[position]] = static_cast<u32>(position);
+        position = parent;
+    }
+    event_queue[position] = slot;
+    event_queue_positions[slot] = static_cast<u32>(position);
+}
+
+void Timing::SiftDown(std::size_t position) {
+    const u32 slot = event_queue[position];
+    const std::size_t size = event_queue.size();
+    while (true) {
+        std::size_t child = position * 2 + 1;
+        if (child >= size) {
+            break;
+        }
+        if (child + 1 < size && IsEarlier(event_queue[child + 1], event_queue[child])) {
+            ++child;
+        }
+        if (!IsEarlier(event_queue[child], slot)) {
+            break;
+        }
+        event_queue[position] = event_queue[child];
+        event_queue_positions[event_queue[position]] = static_cast<u32>(position);
+        position = child;
+    }
+    event_queue[position] = slot;
+    event_queue_positions[slot] = static_cast<u32>(position);
+}
+
 } // namespace Core
@@ -196,12 +196,41 @@ private:
         u64 userdata;
         const TimingEventType* type;
 
-        bool operator>(const Event& right) const;
         bool operator<(const Event& right) const;
     };
 
+    struct EventKey {
+        const TimingEventType* type;
+        u64 userdata;
+
+        bool operator==(const EventKey& right) const {
+            return type == right.type && userdata == right.userdata;
+        }
+    };
+
+    struct EventKeyHash {
+        std::size_t operator()(const EventKey& key) const {
+            return std::hash<const void*>()(key.type) ^
+                   std::hash<u64>()(key.userdata * 0x9E3779B97F4A7C15);
+        }
+    };
+
     static constexpr int MAX_SLICE_LENGTH = 20000;
 
+    /// Adds an event to the queue, keeping its fifo_order
+    void PushEvent(const Event& event);
+    /// Removes the event stored in the given slot from the queue and frees the slot
+    void RemoveSlot(u32 slot);
+    /// Removes the entry of the given slot from the event index
+    void UnindexSlot(u32 slot);
+    bool IsEarlier(u32 slot_a, u32 slot_b) const;
+    void SiftUp(std::size_t position);
+    void SiftDown(std::size_t position);
+
+    const Event& NextEvent() const {
+        return event_slots[event_queue.front()];
+    }
+
     s64 global_timer = 0;
     s64 slice_length = MAX_SLICE_LENGTH;
     s64 downcount = MAX_SLICE_LENGTH;
@@ -210,11 +239,18 @@ private:
     // elements remain stable regardless of rehashes/resizing.
     std::unordered_map<std::string, TimingEventType> event_types;
 
-    // The queue is a min-heap using std::make_heap/push_heap/pop_heap.
-    // We don't use std::priority_queue because we need to be able to serialize, unserialize and
-    // erase arbitrary events (RemoveEvent()) regardless of the queue order. These aren't
-    // accomodated by the standard adaptor class.
-    std::vector<Event> event_queue;
+    // Scheduled events are stored in slots that keep their index until the event is removed. The
+    // queue is a min-heap of slot indices ordered by (time, fifo_order), and every slot knows its
+    // position in it, so that any event can be removed in O(log n) once its slot is known. The
+    // index maps the type and userdata of scheduled events to their slots.
+    std::vector<Event> event_slots;
+    std::vector<u32> free_event_slots;
+    std::vector<u32> event_queue_positions;
+    std::vector<u32> event_queue;
+    using EventIndex = std::unordered_multimap<EventKey, u32, EventKeyHash>;
+    EventIndex event_index;
+    // Nodes of removed index entries, reused to avoid an allocation per scheduled event
+    std::vector<EventIndex::node_type> free_index_nodes;
     u64 event_fifo_id = 0;
     // the queue for storing the events from other threads threadsafe until they will be added
     // to the event_queue by the emu thread
@@ -232,6 +232,9 @@ Loader::ResultStatus NCCHContainer::Load() {
                     }
                 }
 
+                // Hold the key slots until both normal keys have been read back, so that a
+                // container loading on another thread cannot swap the KeyYs in between.
+                auto key_lock = LockKeys();
                 SetKeyY(KeySlotID::NCCHSecure1, key_y_primary);
                 if (!IsNormalKeyAvailable(KeySlotID::NCCHSecure1)) {
                     LOG_ERROR(Service_FS, "Secure1 KeyX missing");
@@ -739,4 +742,12 @@ bool NCCHContainer::HasExHeader() {
     return has_exheader;
 }
 
+bool NCCHContainer::IsTainted() {
+    Loader::ResultStatus result = Load();
+    if (result != Loader::ResultStatus::Success)
+        return false;
+
+    return is_tainted;
+}
+
 } // namespace FileSys
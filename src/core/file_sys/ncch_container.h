@@ -289,6 +289,12 @@ public:
      */
     bool HasExHeader();
 
+    /**
+     * Checks whether the contents of the NCCH container are replaced by files next to it
+     * @return bool check result
+     */
+    bool IsTainted();
+
     NCCH_Header ncch_header;
     ExeFs_Header exefs_header;
     ExHeader_Header exheader_header;
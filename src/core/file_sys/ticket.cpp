@@ -44,6 +44,7 @@ Loader::ResultStatus Ticket::Load(const std::vector<u8> file_data, std::size_t o
 std::optional<std::array<u8, 16>> Ticket::GetTitleKey() const {
     HW::AES::InitKeys();
     std::array<u8, 16> ctr{};
+    auto key_lock = HW::AES::LockKeys();
     std::memcpy(ctr.data(), &ticket_body.title_id, sizeof(u64));
     HW::AES::SelectCommonKeyIndex(ticket_body.common_key_index);
     if (!HW::AES::IsNormalKeyAvailable(HW::AES::KeySlotID::TicketCommonKey)) {
@@ -75,6 +75,17 @@ HLERequestContext::HLERequestContext(KernelSystem& kernel, std::shared_ptr<Serve
 
 HLERequestContext::~HLERequestContext() = default;
 
+void HLERequestContext::Reset(std::shared_ptr<ServerSession> session, Thread* thread) {
+    this->session = std::move(session);
+    this->thread = thread;
+    cmd_buf[0] = 0;
+    request_handles.clear();
+    request_mapped_buffers.clear();
+    for (auto& buffer : static_buffers) {
+        buffer.clear();
+    }
+}
+
 std::shared_ptr<Object> HLERequestContext::GetIncomingHandle(u32 id_from_cmdbuf) const {
     ASSERT(id_from_cmdbuf < request_handles.size());
     return request_handles[id_from_cmdbuf];
@@ -140,11 +151,11 @@ ResultCode HLERequestContext::PopulateFromIncomingCommandBuffer(const u32_le* sr
             VAddr source_address = src_cmdbuf[i];
             IPC::StaticBufferDescInfo buffer_info{descriptor};
 
-            // Copy the input buffer into our own vector and store it.
-            std::vector<u8> data(buffer_info.size);
+            // Copy the input buffer into our own vector, reusing its storage if it has any.
+            std::vector<u8>& data = static_buffers[buffer_info.buffer_id];
+            data.resize(buffer_info.size);
             kernel.memory.ReadBlock(src_process, source_address, data.data(), data.size());
 
-            AddStaticBuffer(buffer_info.buffer_id, std::move(data));
             cmd_buf[i++] = source_address;
             break;
         }
@@ -241,6 +252,16 @@ MappedBuffer::MappedBuffer(Memory::MemorySystem& memory, const Process& process,
     perms = desc.perms;
 }
 
+const u8* MappedBuffer::GetReadPointer() {
+    ASSERT(perms & IPC::R);
+    return memory->GetContiguousPointer(*process, address, size);
+}
+
+u8* MappedBuffer::GetWritePointer() {
+    ASSERT(perms & IPC::W);
+    return memory->GetContiguousPointer(*process, address, size);
+}
+
 void MappedBuffer::Read(void* dest_buffer, std::size_t offset, std::size_t size) {
     ASSERT(perms & IPC::R);
     ASSERT(offset + size <= this->size);
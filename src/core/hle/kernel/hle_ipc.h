@@ -104,6 +104,13 @@ public:
     // interface for service
     void Read(void* dest_buffer, std::size_t offset, std::size_t size);
     void Write(const void* src_buffer, std::size_t offset, std::size_t size);
+    /**
+     * Return a pointer to the whole buffer if it can be accessed directly, or nullptr if Read and
+     * Write have to be used. Like Read and Write, they require the buffer to be readable or
+     * writable respectively. The pointer is only valid while the request is being handled.
+     */
+    const u8* GetReadPointer();
+    u8* GetWritePointer();
     std::size_t GetSize() const {
         return size;
     }
@@ -161,6 +168,13 @@ public:
     HLERequestContext(KernelSystem& kernel, std::shared_ptr<ServerSession> session, Thread* thread);
     ~HLERequestContext();
 
+    /**
+     * Prepares the context for a new request, discarding everything left by the previous one. The
+     * buffers of the context keep their capacity, so a context reused for many requests does not
+     * need to allocate memory for each of them.
+     */
+    void Reset(std::shared_ptr<ServerSession> session, Thread* thread);
+
     /// Returns a pointer to the IPC command buffer for this request.
     u32* CommandBuffer() {
         return cmd_buf.data();
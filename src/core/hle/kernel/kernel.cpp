@@ -5,6 +5,7 @@
 #include "core/hle/kernel/client_port.h"
 #include "core/hle/kernel/config_mem.h"
 #include "core/hle/kernel/handle_table.h"
+#include "core/hle/kernel/hle_ipc.h"
 #include "core/hle/kernel/kernel.h"
 #include "core/hle/kernel/memory.h"
 #include "core/hle/kernel/process.h"
@@ -91,4 +92,22 @@ void KernelSystem::AddNamedPort(std::string name, std::shared_ptr<ClientPort> po
     named_ports.emplace(std::move(name), std::move(port));
 }
 
+std::unique_ptr<HLERequestContext> KernelSystem::AcquireRequestContext(
+    std::shared_ptr<ServerSession> session, Thread* thread) {
+    if (request_context_pool.empty()) {
+        return std::make_unique<HLERequestContext>(*this, std::move(session), thread);
+    }
+
+    std::unique_ptr<HLERequestContext> context = std::move(request_context_pool.back());
+    request_context_pool.pop_back();
+    context->Reset(std::move(session), thread);
+    return context;
+}
+
+void KernelSystem::ReleaseRequestContext(std::unique_ptr<HLERequestContext> context) {
+    // Drop the references to the objects of the request right away instead of on the next reuse
+    context->Reset(nullptr, nullptr);
+    request_context_pool.push_back(std::move(context));
+}
+
 } // namespace Kernel
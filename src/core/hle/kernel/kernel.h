@@ -8,6 +8,7 @@
 #include <atomic>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -46,6 +47,7 @@ class ClientPort;
 class ServerPort;
 class ClientSession;
 class ServerSession;
+class HLERequestContext;
 class ResourceLimitList;
 class SharedMemory;
 class ThreadManager;
@@ -231,10 +233,30 @@ public:
     /// Adds a port to the named port table
     void AddNamedPort(std::string name, std::shared_ptr<ClientPort> port);
 
+    /**
+     * Gets a context for an HLE request made by the given thread, reusing the context of a
+     * finished request when there is one so that its buffers do not have to be allocated again.
+     */
+    std::unique_ptr<HLERequestContext> AcquireRequestContext(std::shared_ptr<ServerSession> session,
+                                                             Thread* thread);
+    /// Returns the context of a finished HLE request so that later requests can reuse it.
+    void ReleaseRequestContext(std::unique_ptr<HLERequestContext> context);
+
     void PrepareReschedule() {
         prepare_reschedule_callback();
     }
 
+    /**
+     * Synchronizes access to the internal HLE kernel structures, it is acquired when a guest
+     * application thread performs a syscall. It should be acquired by any host threads that read or
+     * modify the HLE kernel state. Note: Any operation that directly or indirectly reads from or
+     * writes to the emulated memory is not protected by this mutex, and should be avoided in any
+     * threads other than the CPU thread.
+     */
+    std::recursive_mutex& GetHLELock() {
+        return hle_lock;
+    }
+
     /// Map of named ports managed by the kernel, which can be retrieved using the ConnectToPort
     std::unordered_map<std::string, std::shared_ptr<ClientPort>> named_ports;
 
@@ -249,6 +271,8 @@ private:
 
     std::function<void()> prepare_reschedule_callback;
 
+    std::recursive_mutex hle_lock;
+
     std::unique_ptr<ResourceLimitList> resource_limits;
     std::atomic<u32> next_object_id{0};
 
@@ -274,6 +298,9 @@ private:
 
     std::unique_ptr<ConfigMem::Handler> config_mem_handler;
     std::unique_ptr<SharedPage::Handler> shared_page_handler;
+
+    /// Contexts of finished HLE requests, ready to be reused
+    std::vector<std::unique_ptr<HLERequestContext>> request_context_pool;
 };
 
 } // namespace Kernel
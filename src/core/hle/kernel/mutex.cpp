@@ -109,11 +109,11 @@ void Mutex::UpdatePriority() {
     if (!holding_thread)
         return;
 
+    // The waiting threads are ordered by priority, so the first one has the best
     u32 best_priority = ThreadPrioLowest;
-    for (auto& waiter : GetWaitingThreads()) {
-        if (waiter->current_priority < best_priority)
-            best_priority = waiter->current_priority;
-    }
+    const auto& waiters = GetWaitingThreads();
+    if (!waiters.empty())
+        best_priority = waiters.front()->current_priority;
 
     if (best_priority != priority) {
         priority = best_priority;
@@ -5,8 +5,10 @@
 #include <algorithm>
 #include <cinttypes>
 #include <map>
+#include <vector>
 #include <fmt/format.h>
 #include "common/logging/log.h"
+#include "common/metrics.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "core/arm/arm_interface.h"
@@ -34,7 +36,6 @@
 #include "core/hle/kernel/timer.h"
 #include "core/hle/kernel/vm_manager.h"
 #include "core/hle/kernel/wait_object.h"
-#include "core/hle/lock.h"
 #include "core/hle/result.h"
 #include "core/hle/service/service.h"
 
@@ -183,6 +184,9 @@ private:
 
     static const FunctionDef SVC_Table[];
     static const FunctionDef* GetSVCInfo(u32 func_num);
+
+    /// Metrics counters of the calls to every SVC, indexed like SVC_Table
+    std::vector<Common::Metrics::CounterId> call_counters;
 };
 
 /// Map application or GSP heap memory
@@ -1571,13 +1575,14 @@ void SVC::CallSVC(u32 immediate) {
     MICROPROFILE_SCOPE(Kernel_SVC);
 
     // Lock the global kernel mutex when we enter the kernel HLE.
-    std::lock_guard lock{HLE::g_hle_lock};
+    std::lock_guard lock{kernel.GetHLELock()};
 
     DEBUG_ASSERT_MSG(kernel.GetCurrentProcess()->status == ProcessStatus::Running,
                      "Running threads from exiting processes is unimplemented");
 
     const FunctionDef* info = GetSVCInfo(immediate);
     if (info) {
+        Common::Metrics::Increment(call_counters[immediate]);
         if (info->func) {
             (this->*(info->func))();
         } else {
@@ -1586,7 +1591,13 @@ void SVC::CallSVC(u32 immediate) {
     }
 }
 
-SVC::SVC(Core::System& system) : system(system), kernel(system.Kernel()), memory(system.Memory()) {}
+SVC::SVC(Core::System& system) : system(system), kernel(system.Kernel()), memory(system.Memory()) {
+    call_counters.reserve(ARRAY_SIZE(SVC_Table));
+    for (const FunctionDef& def : SVC_Table) {
+        call_counters.push_back(Common::Metrics::RegisterCounter(
+            fmt::format("svc.{:02X}.{}", def.id, def.name)));
+    }
+}
 
 u32 SVC::GetReg(std::size_t n) {
     return system.CPU().GetReg(static_cast<int>(n));
@@ -312,7 +312,6 @@ ResultVal<std::shared_ptr<Thread>> KernelSystem::CreateThread(std::string name,
     auto thread{std::make_shared<Thread>(*this)};
 
     thread_manager->thread_list.push_back(thread);
-    thread_manager->ready_queue.prepare(priority);
 
     thread->thread_id = thread_manager->NewThreadId();
     thread->status = ThreadStatus::Dormant;
@@ -381,10 +380,9 @@ void Thread::SetPriority(u32 priority) {
     // If thread was ready, adjust queues
     if (status == ThreadStatus::Ready)
         thread_manager.ready_queue.move(this, current_priority, priority);
-    else
-        thread_manager.ready_queue.prepare(priority);
 
     nominal_priority = current_priority = priority;
+    UpdateWaitQueues();
 }
 
 void Thread::UpdatePriority() {
@@ -400,9 +398,14 @@ void Thread::BoostPriority(u32 priority) {
     // If thread was ready, adjust queues
     if (status == ThreadStatus::Ready)
         thread_manager.ready_queue.move(this, current_priority, priority);
-    else
-        thread_manager.ready_queue.prepare(priority);
     current_priority = priority;
+    UpdateWaitQueues();
+}
+
+void Thread::UpdateWaitQueues() {
+    for (auto& object : wait_objects) {
+        object->UpdateWaitingThreadPriority(this);
+    }
 }
 
 std::shared_ptr<Thread> SetupMainThread(KernelSystem& kernel, u32 entry_point, u32 priority,
@@ -305,6 +305,9 @@ public:
     std::function<WakeupCallback> wakeup_callback;
 
 private:
+    /// Keeps the waiting lists of the objects the thread waits on ordered after a priority change
+    void UpdateWaitQueues();
+
     ThreadManager& thread_manager;
 };
 
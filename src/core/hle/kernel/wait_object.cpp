@@ -19,7 +19,7 @@ namespace Kernel {
 void WaitObject::AddWaitingThread(std::shared_ptr<Thread> thread) {
     auto itr = std::find(waiting_threads.begin(), waiting_threads.end(), thread);
     if (itr == waiting_threads.end())
-        waiting_threads.push_back(std::move(thread));
+        InsertWaitingThread(std::move(thread));
 }
 
 void WaitObject::RemoveWaitingThread(Thread* thread) {
@@ -32,10 +32,26 @@ void WaitObject::RemoveWaitingThread(Thread* thread) {
         waiting_threads.erase(itr);
 }
 
-std::shared_ptr<Thread> WaitObject::GetHighestPriorityReadyThread() const {
-    Thread* candidate = nullptr;
-    u32 candidate_priority = ThreadPrioLowest + 1;
+void WaitObject::UpdateWaitingThreadPriority(Thread* thread) {
+    auto itr = std::find_if(waiting_threads.begin(), waiting_threads.end(),
+                            [thread](const auto& p) { return p.get() == thread; });
+    if (itr == waiting_threads.end())
+        return;
+
+    std::shared_ptr<Thread> waiting_thread = std::move(*itr);
+    waiting_threads.erase(itr);
+    InsertWaitingThread(std::move(waiting_thread));
+}
 
+void WaitObject::InsertWaitingThread(std::shared_ptr<Thread> thread) {
+    const u32 priority = thread->current_priority;
+    auto itr = std::find_if(waiting_threads.begin(), waiting_threads.end(),
+                            [priority](const auto& p) { return p->current_priority > priority; });
+    waiting_threads.insert(itr, std::move(thread));
+}
+
+std::shared_ptr<Thread> WaitObject::GetHighestPriorityReadyThread() const {
+    // The waiting threads are ordered by priority, so the first one that can run is the answer
     for (const auto& thread : waiting_threads) {
         // The list of waiting threads must not contain threads that are not waiting to be awakened.
         ASSERT_MSG(thread->status == ThreadStatus::WaitSynchAny ||
@@ -43,9 +59,6 @@ std::shared_ptr<Thread> WaitObject::GetHighestPriorityReadyThread() const {
                        thread->status == ThreadStatus::WaitHleEvent,
                    "Inconsistent thread statuses in waiting_threads");
 
-        if (thread->current_priority >= candidate_priority)
-            continue;
-
         if (ShouldWait(thread.get()))
             continue;
 
@@ -60,12 +73,11 @@ std::shared_ptr<Thread> WaitObject::GetHighestPriorityReadyThread() const {
         }
 
         if (ready_to_run) {
-            candidate = thread.get();
-            candidate_priority = thread->current_priority;
+            return thread;
         }
     }
 
-    return SharedFrom(candidate);
+    return nullptr;
 }
 
 void WaitObject::WakeupAllWaitingThreads() {
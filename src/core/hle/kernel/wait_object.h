@@ -42,6 +42,12 @@ public:
      */
     virtual void RemoveWaitingThread(Thread* thread);
 
+    /**
+     * Moves a waiting thread to its place in the waiting list after its priority changed
+     * @param thread Pointer to the thread whose priority changed
+     */
+    void UpdateWaitingThreadPriority(Thread* thread);
+
     /**
      * Wake up all threads waiting on this object that can be awoken, in priority order,
      * and set the synchronization result and output of the thread.
@@ -51,14 +57,18 @@ public:
     /// Obtains the highest priority thread that is ready to run from this object's waiting list.
     std::shared_ptr<Thread> GetHighestPriorityReadyThread() const;
 
-    /// Get a const reference to the waiting threads list for debug use
+    /// Get a const reference to the waiting threads list, ordered by priority, for debug use
     const std::vector<std::shared_ptr<Thread>>& GetWaitingThreads() const;
 
     /// Sets a callback which is called when the object becomes available
     void SetHLENotifier(std::function<void()> callback);
 
 private:
-    /// Threads waiting for this object to become available
+    /// Inserts a thread after the waiting threads with the same or a better priority
+    void InsertWaitingThread(std::shared_ptr<Thread> thread);
+
+    /// Threads waiting for this object to become available, ordered by priority and then by the
+    /// order in which they started waiting
     std::vector<std::shared_ptr<Thread>> waiting_threads;
 
     /// Function to call when this object becomes available
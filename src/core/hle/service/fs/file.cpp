@@ -58,13 +58,18 @@ void File::Read(Kernel::HLERequestContext& ctx) {
 
     IPC::RequestBuilder rb = rp.MakeBuilder(2, 2);
 
-    std::vector<u8> data(length);
-    ResultVal<std::size_t> read = backend->Read(offset, data.size(), data.data());
+    // Read straight into the memory of the application when the buffer allows it
+    u8* const target = length <= buffer.GetSize() ? buffer.GetWritePointer() : nullptr;
+    std::vector<u8> data(target == nullptr ? length : 0);
+    ResultVal<std::size_t> read =
+        backend->Read(offset, length, target == nullptr ? data.data() : target);
     if (read.Failed()) {
         rb.Push(read.Code());
         rb.Push<u32>(0);
     } else {
-        buffer.Write(data.data(), 0, *read);
+        if (target == nullptr) {
+            buffer.Write(data.data(), 0, *read);
+        }
         rb.Push(RESULT_SUCCESS);
         rb.Push<u32>(static_cast<u32>(*read));
     }
@@ -100,9 +105,14 @@ void File::Write(Kernel::HLERequestContext& ctx) {
         return;
     }
 
-    std::vector<u8> data(length);
-    buffer.Read(data.data(), 0, data.size());
-    ResultVal<std::size_t> written = backend->Write(offset, data.size(), flush != 0, data.data());
+    const u8* source = length <= buffer.GetSize() ? buffer.GetReadPointer() : nullptr;
+    std::vector<u8> data;
+    if (source == nullptr) {
+        data.resize(length);
+        buffer.Read(data.data(), 0, data.size());
+        source = data.data();
+    }
+    ResultVal<std::size_t> written = backend->Write(offset, length, flush != 0, source);
     if (written.Failed()) {
         rb.Push(written.Code());
         rb.Push<u32>(0);
@@ -7,13 +7,13 @@
 #include "core/hle/kernel/event.h"
 #include "core/hle/kernel/shared_memory.h"
 #include "core/hle/service/gsp/gsp.h"
+#include "core/hle/service/sm/sm.h"
 
 namespace Service::GSP {
 
-static std::weak_ptr<GSP_GPU> gsp_gpu;
-
 void SignalInterrupt(InterruptId interrupt_id) {
-    auto gpu = gsp_gpu.lock();
+    // Interrupts go to the GSP service of the console raising them
+    auto gpu = Core::System::GetInstance().ServiceManager().GetService<GSP_GPU>("gsp::Gpu");
     ASSERT(gpu != nullptr);
     return gpu->SignalInterrupt(interrupt_id);
 }
@@ -22,7 +22,6 @@ void InstallInterfaces(Core::System& system) {
     auto& service_manager = system.ServiceManager();
     auto gpu = std::make_shared<GSP_GPU>(system);
     gpu->InstallAsService(service_manager);
-    gsp_gpu = gpu;
 
     std::make_shared<GSP_LCD>()->InstallAsService(service_manager);
 }
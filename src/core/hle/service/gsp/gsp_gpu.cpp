@@ -343,6 +343,9 @@ void GSP_GPU::InvalidateDataCache(Kernel::HLERequestContext& ctx) {
     u32 size = rp.Pop<u32>();
     auto process = rp.PopObject<Kernel::Process>();
 
+    // The CPU is about to read memory that may still be written by the GPU thread
+    GPU::SyncGPUThread();
+
     // TODO(purpasmart96): Verify return header on HW
 
     IPC::RequestBuilder rb = rp.MakeBuilder(1, 0);
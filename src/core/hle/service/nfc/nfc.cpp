@@ -5,7 +5,6 @@
 #include "core/core.h"
 #include "core/hle/ipc_helpers.h"
 #include "core/hle/kernel/event.h"
-#include "core/hle/lock.h"
 #include "core/hle/service/nfc/nfc.h"
 #include "core/hle/service/nfc/nfc_m.h"
 #include "core/hle/service/nfc/nfc_u.h"
@@ -302,14 +301,14 @@ std::shared_ptr<Module> Module::Interface::GetModule() const {
 }
 
 void Module::Interface::LoadAmiibo(const AmiiboData& amiibo_data) {
-    std::lock_guard lock(HLE::g_hle_lock);
+    std::lock_guard lock(nfc->system.Kernel().GetHLELock());
     nfc->amiibo_data = amiibo_data;
     nfc->nfc_tag_state = Service::NFC::TagState::TagInRange;
     nfc->tag_in_range_event->Signal();
 }
 
 void Module::Interface::RemoveAmiibo() {
-    std::lock_guard lock(HLE::g_hle_lock);
+    std::lock_guard lock(nfc->system.Kernel().GetHLELock());
     nfc->nfc_tag_state = Service::NFC::TagState::TagOutOfRange;
     nfc->tag_out_of_range_event->Signal();
     nfc->amiibo_data = {};
@@ -320,7 +319,7 @@ Module::Interface::Interface(std::shared_ptr<Module> nfc, const char* name, u32
 
 Module::Interface::~Interface() = default;
 
-Module::Module(Core::System& system) {
+Module::Module(Core::System& system) : system(system) {
     tag_in_range_event =
         system.Kernel().CreateEvent(Kernel::ResetType::OneShot, "NFC::tag_in_range_event");
     tag_out_of_range_event =
@@ -231,6 +231,8 @@ public:
     };
 
 private:
+    Core::System& system;
+
     std::shared_ptr<Kernel::Event> tag_in_range_event;
     std::shared_ptr<Kernel::Event> tag_out_of_range_event;
     std::atomic<TagState> nfc_tag_state = TagState::NotInitialized;
@@ -127,7 +127,9 @@ const std::array<ServiceModuleInfo, 40> service_module_map{
 
 ServiceFrameworkBase::ServiceFrameworkBase(const char* service_name, u32 max_sessions,
                                            InvokerFn* handler_invoker)
-    : service_name(service_name), max_sessions(max_sessions), handler_invoker(handler_invoker) {}
+    : service_name(service_name), max_sessions(max_sessions),
+      request_counter(Common::Metrics::RegisterCounter(fmt::format("ipc.{}", service_name))),
+      handler_invoker(handler_invoker) {}
 
 ServiceFrameworkBase::~ServiceFrameworkBase() = default;
 
@@ -145,8 +147,15 @@ void ServiceFrameworkBase::InstallAsNamedPort(Kernel::KernelSystem& kernel) {
 void ServiceFrameworkBase::RegisterHandlersBase(const FunctionInfoBase* functions, std::size_t n) {
     handlers.reserve(handlers.size() + n);
     for (std::size_t i = 0; i < n; ++i) {
-        // Usually this array is sorted by id already, so hint to insert at the end
-        handlers.emplace_hint(handlers.cend(), functions[i].expected_header, functions[i]);
+        const u32 command_id = functions[i].expected_header >> 16;
+        if (command_id >= handler_indices.size()) {
+            handler_indices.resize(command_id + 1, 0);
+        }
+        ASSERT_MSG(handler_indices[command_id] == 0, "{}: command {:#06x} registered twice",
+                   service_name, command_id);
+
+        handlers.push_back(functions[i]);
+        handler_indices[command_id] = static_cast<u16>(handlers.size());
     }
 }
 
@@ -172,9 +181,18 @@ void ServiceFrameworkBase::ReportUnimplementedFunction(u32* cmd_buf, const Funct
 }
 
 void ServiceFrameworkBase::HandleSyncRequest(Kernel::HLERequestContext& context) {
-    u32 header_code = context.CommandBuffer()[0];
-    auto itr = handlers.find(header_code);
-    const FunctionInfoBase* info = itr == handlers.end() ? nullptr : &itr->second;
+    Common::Metrics::Increment(request_counter);
+
+    const u32 header_code = context.CommandBuffer()[0];
+    const u32 command_id = header_code >> 16;
+    const FunctionInfoBase* info = nullptr;
+    if (command_id < handler_indices.size() && handler_indices[command_id] != 0) {
+        info = &handlers[handler_indices[command_id] - 1];
+        // Requests whose parameter sizes don't match the handler are treated as unknown
+        if (info->expected_header != header_code) {
+            info = nullptr;
+        }
+    }
     if (info == nullptr || info->handler_callback == nullptr) {
         return ReportUnimplementedFunction(context.CommandBuffer(), info);
     }
@@ -9,8 +9,9 @@
 #include <functional>
 #include <memory>
 #include <string>
-#include <boost/container/flat_map.hpp>
+#include <vector>
 #include "common/common_types.h"
+#include "common/metrics.h"
 #include "core/hle/kernel/hle_ipc.h"
 #include "core/hle/kernel/object.h"
 #include "core/hle/service/sm/sm.h"
@@ -92,10 +93,15 @@ private:
     std::string service_name;
     /// Maximum number of concurrent sessions that this service can handle.
     u32 max_sessions;
+    /// Metrics counter of the requests handled by this service.
+    Common::Metrics::CounterId request_counter;
 
     /// Function used to safely up-cast pointers to the derived class before invoking a handler.
     InvokerFn* handler_invoker;
-    boost::container::flat_map<u32, FunctionInfoBase> handlers;
+    std::vector<FunctionInfoBase> handlers;
+    /// Maps each command id to one plus the index of its entry in `handlers`, or to 0 if it has no
+    /// handler, so that dispatching a request is a single array lookup.
+    std::vector<u16> handler_indices;
 };
 
 /**
@@ -85,6 +85,7 @@ struct KeySlot {
     }
 };
 
+std::recursive_mutex key_mutex;
 std::array<KeySlot, KeySlotID::MaxKeySlotID> key_slots;
 std::array<std::optional<AESKey>, 6> common_key_y_slots;
 
@@ -439,7 +440,12 @@ void LoadPresetKeys() {
 
 } // namespace
 
+std::unique_lock<std::recursive_mutex> LockKeys() {
+    return std::unique_lock{key_mutex};
+}
+
 void InitKeys() {
+    std::lock_guard lock{key_mutex};
     static bool initialized = false;
     if (initialized)
         return;
@@ -451,26 +457,32 @@ void InitKeys() {
 }
 
 void SetKeyX(std::size_t slot_id, const AESKey& key) {
+    std::lock_guard lock{key_mutex};
     key_slots.at(slot_id).SetKeyX(key);
 }
 
 void SetKeyY(std::size_t slot_id, const AESKey& key) {
+    std::lock_guard lock{key_mutex};
     key_slots.at(slot_id).SetKeyY(key);
 }
 
 void SetNormalKey(std::size_t slot_id, const AESKey& key) {
+    std::lock_guard lock{key_mutex};
     key_slots.at(slot_id).SetNormalKey(key);
 }
 
 bool IsNormalKeyAvailable(std::size_t slot_id) {
+    std::lock_guard lock{key_mutex};
     return key_slots.at(slot_id).normal.has_value();
 }
 
 AESKey GetNormalKey(std::size_t slot_id) {
+    std::lock_guard lock{key_mutex};
     return key_slots.at(slot_id).normal.value_or(AESKey{});
 }
 
 void SelectCommonKeyIndex(u8 index) {
+    std::lock_guard lock{key_mutex};
     key_slots[KeySlotID::TicketCommonKey].SetKeyY(common_key_y_slots.at(index));
 }
 
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <cstddef>
+#include <mutex>
 #include "common/common_types.h"
 
 namespace HW::AES {
@@ -52,6 +53,13 @@ constexpr std::size_t AES_BLOCK_SIZE = 16;
 
 using AESKey = std::array<u8, AES_BLOCK_SIZE>;
 
+/**
+ * Acquires the lock guarding the key slots, which are shared by every System instance. Callers that
+ * set a KeyY and then read back the derived normal key must hold it across the whole sequence so
+ * another thread cannot replace the KeyY in between. The individual functions below also take it.
+ */
+std::unique_lock<std::recursive_mutex> LockKeys();
+
 void InitKeys();
 
 void SetGeneratorConstant(const AESKey& key);
@@ -2,20 +2,30 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <condition_variable>
 #include <cstring>
+#include <deque>
+#include <functional>
+#include <mutex>
 #include <numeric>
+#include <thread>
 #include <type_traits>
+#include <vector>
 #include "common/alignment.h"
 #include "common/color.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
+#include "common/metrics.h"
 #include "common/microprofile.h"
+#include "common/thread.h"
 #include "common/vector_math.h"
+#include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/service/gsp/gsp.h"
 #include "core/hw/gpu.h"
 #include "core/hw/hw.h"
 #include "core/memory.h"
+#include "core/settings.h"
 #include "core/tracer/recorder.h"
 #include "video_core/command_processor.h"
 #include "video_core/debug_utils/debug_utils.h"
@@ -26,16 +36,159 @@
 
 namespace GPU {
 
-Regs g_regs;
-Memory::MemorySystem* g_memory;
-
 /// 268MHz CPU clocks / 60Hz frames per second
 const u64 frame_ticks = static_cast<u64>(BASE_CLOCK_RATE_ARM11 / SCREEN_REFRESH_RATE);
-/// Event id for CoreTiming
-static Core::TimingEventType* vblank_event;
+
+/**
+ * Consumer thread for GPU work (command lists, memory fills and display transfers). Work is
+ * executed in submission order. Interrupts raised while processing are queued up and delivered on
+ * the emulation thread by Update() or SyncGPUThread().
+ */
+class GPUThread {
+public:
+    explicit GPUThread(Core::System& system)
+        : system(system), thread(&GPUThread::ThreadLoop, this) {}
+
+    ~GPUThread() {
+        {
+            std::lock_guard lock{queue_mutex};
+            stop_requested = true;
+        }
+        work_available.notify_one();
+        thread.join();
+    }
+
+    void Push(std::function<void()> work) {
+        {
+            std::lock_guard lock{queue_mutex};
+            queue.push_back(std::move(work));
+            ++pending_work;
+        }
+        work_available.notify_one();
+    }
+
+    /// Blocks until all submitted work has been processed
+    void WaitIdle() {
+        std::unique_lock lock{queue_mutex};
+        work_done.wait(lock, [this] { return pending_work == 0; });
+    }
+
+    bool IsCurrentThread() const {
+        return std::this_thread::get_id() == thread.get_id();
+    }
+
+    void QueueInterrupt(Service::GSP::InterruptId interrupt_id) {
+        std::lock_guard lock{interrupt_mutex};
+        pending_interrupts.push_back(interrupt_id);
+    }
+
+    /// Signals all interrupts queued by the GPU thread. Returns true if there were any.
+    bool DeliverInterrupts() {
+        std::vector<Service::GSP::InterruptId> interrupts;
+        {
+            std::lock_guard lock{interrupt_mutex};
+            interrupts.swap(pending_interrupts);
+        }
+        for (auto interrupt_id : interrupts) {
+            Service::GSP::SignalInterrupt(interrupt_id);
+        }
+        return !interrupts.empty();
+    }
+
+private:
+    void ThreadLoop() {
+        Common::SetCurrentThreadName("GPU");
+        // The work refers to the state of the console that owns the thread
+        system.MakeCurrent();
+        std::unique_lock lock{queue_mutex};
+        while (true) {
+            work_available.wait(lock, [this] { return stop_requested || !queue.empty(); });
+            if (queue.empty()) {
+                // Only reached once a stop was requested and all work has been drained
+                return;
+            }
+
+            auto work = std::move(queue.front());
+            queue.pop_front();
+            lock.unlock();
+            work();
+            lock.lock();
+
+            if (--pending_work == 0) {
+                work_done.notify_all();
+            }
+        }
+    }
+
+    Core::System& system;
+
+    std::mutex queue_mutex;
+    std::condition_variable work_available;
+    std::condition_variable work_done;
+    std::deque<std::function<void()>> queue;
+    std::size_t pending_work = 0;
+    bool stop_requested = false;
+
+    std::mutex interrupt_mutex;
+    std::vector<Service::GSP::InterruptId> pending_interrupts;
+
+    std::thread thread;
+};
+
+Context::Context() = default;
+Context::~Context() = default;
+
+static Context& GetContext() {
+    return Core::System::GetInstance().GPUContext();
+}
+
+Regs& GetRegs() {
+    return GetContext().regs;
+}
+
+/// Executes GPU work, either asynchronously on the GPU thread or synchronously.
+template <typename Func>
+static void SubmitWork(Func&& work) {
+    // The hardware renderer owns a GL context that is bound to the emulation thread
+    GPUThread* const gpu_thread = GetContext().thread.get();
+    if (gpu_thread && !VideoCore::g_hw_renderer_enabled) {
+        gpu_thread->Push(std::forward<Func>(work));
+    } else {
+        // Make sure work queued earlier (e.g. before the renderer was switched) completes first
+        SyncGPUThread();
+        work();
+    }
+}
+
+void SignalInterrupt(Service::GSP::InterruptId interrupt_id) {
+    GPUThread* const gpu_thread = GetContext().thread.get();
+    if (gpu_thread && gpu_thread->IsCurrentThread()) {
+        gpu_thread->QueueInterrupt(interrupt_id);
+    } else {
+        Service::GSP::SignalInterrupt(interrupt_id);
+    }
+}
+
+bool SyncGPUThread() {
+    GPUThread* const gpu_thread = GetContext().thread.get();
+    if (!gpu_thread || gpu_thread->IsCurrentThread()) {
+        return false;
+    }
+    gpu_thread->WaitIdle();
+    return gpu_thread->DeliverInterrupts();
+}
+
+void Update() {
+    if (GPUThread* const gpu_thread = GetContext().thread.get()) {
+        gpu_thread->DeliverInterrupts();
+    }
+}
 
 template <typename T>
 inline void Read(T& var, const u32 raw_addr) {
+    // Registers may be updated by work in flight, e.g. the memory fill "finished" flag
+    SyncGPUThread();
+
     u32 addr = raw_addr - HW::VADDR_GPU;
     u32 index = addr / 4;
 
@@ -45,7 +198,7 @@ inline void Read(T& var, const u32 raw_addr) {
         return;
     }
 
-    var = g_regs[addr / 4];
+    var = GetRegs()[addr / 4];
 }
 
 static Common::Vec4<u8> DecodePixel(Regs::PixelFormat input_format, const u8* src_pixel) {
@@ -79,12 +232,12 @@ static void MemoryFill(const Regs::MemoryFillConfig& config) {
     const PAddr end_addr = config.GetEndAddress();
 
     // TODO: do hwtest with these cases
-    if (!g_memory->IsValidPhysicalAddress(start_addr)) {
+    if (!GetContext().memory->IsValidPhysicalAddress(start_addr)) {
         LOG_CRITICAL(HW_GPU, "invalid start address {:#010X}", start_addr);
         return;
     }
 
-    if (!g_memory->IsValidPhysicalAddress(end_addr)) {
+    if (!GetContext().memory->IsValidPhysicalAddress(end_addr)) {
         LOG_CRITICAL(HW_GPU, "invalid end address {:#010X}", end_addr);
         return;
     }
@@ -95,10 +248,10 @@ static void MemoryFill(const Regs::MemoryFillConfig& config) {
         return;
     }
 
-    u8* start = g_memory->GetPhysicalPointer(start_addr);
-    u8* end = g_memory->GetPhysicalPointer(end_addr);
+    u8* start = GetContext().memory->GetPhysicalPointer(start_addr);
+    u8* end = GetContext().memory->GetPhysicalPointer(end_addr);
 
-    if (VideoCore::g_renderer->Rasterizer()->AccelerateFill(config))
+    if (VideoCore::GetRenderer()->Rasterizer()->AccelerateFill(config))
         return;
 
     Memory::RasterizerInvalidateRegion(config.GetStartAddress(),
@@ -132,12 +285,12 @@ static void DisplayTransfer(const Regs::DisplayTransferConfig& config) {
     const PAddr dst_addr = config.GetPhysicalOutputAddress();
 
     // TODO: do hwtest with these cases
-    if (!g_memory->IsValidPhysicalAddress(src_addr)) {
+    if (!GetContext().memory->IsValidPhysicalAddress(src_addr)) {
         LOG_CRITICAL(HW_GPU, "invalid input address {:#010X}", src_addr);
         return;
     }
 
-    if (!g_memory->IsValidPhysicalAddress(dst_addr)) {
+    if (!GetContext().memory->IsValidPhysicalAddress(dst_addr)) {
         LOG_CRITICAL(HW_GPU, "invalid output address {:#010X}", dst_addr);
         return;
     }
@@ -162,11 +315,11 @@ static void DisplayTransfer(const Regs::DisplayTransferConfig& config) {
         return;
     }
 
-    if (VideoCore::g_renderer->Rasterizer()->AccelerateDisplayTransfer(config))
+    if (VideoCore::GetRenderer()->Rasterizer()->AccelerateDisplayTransfer(config))
         return;
 
-    u8* src_pointer = g_memory->GetPhysicalPointer(src_addr);
-    u8* dst_pointer = g_memory->GetPhysicalPointer(dst_addr);
+    u8* src_pointer = GetContext().memory->GetPhysicalPointer(src_addr);
+    u8* dst_pointer = GetContext().memory->GetPhysicalPointer(dst_addr);
 
     if (config.scaling > config.ScaleXY) {
         LOG_CRITICAL(HW_GPU, "Unimplemented display transfer scaling mode {}",
@@ -308,21 +461,21 @@ static void TextureCopy(const Regs::DisplayTransferConfig& config) {
     const PAddr dst_addr = config.GetPhysicalOutputAddress();
 
     // TODO: do hwtest with invalid addresses
-    if (!g_memory->IsValidPhysicalAddress(src_addr)) {
+    if (!GetContext().memory->IsValidPhysicalAddress(src_addr)) {
         LOG_CRITICAL(HW_GPU, "invalid input address {:#010X}", src_addr);
         return;
     }
 
-    if (!g_memory->IsValidPhysicalAddress(dst_addr)) {
+    if (!GetContext().memory->IsValidPhysicalAddress(dst_addr)) {
         LOG_CRITICAL(HW_GPU, "invalid output address {:#010X}", dst_addr);
         return;
     }
 
-    if (VideoCore::g_renderer->Rasterizer()->AccelerateTextureCopy(config))
+    if (VideoCore::GetRenderer()->Rasterizer()->AccelerateTextureCopy(config))
         return;
 
-    u8* src_pointer = g_memory->GetPhysicalPointer(src_addr);
-    u8* dst_pointer = g_memory->GetPhysicalPointer(dst_addr);
+    u8* src_pointer = GetContext().memory->GetPhysicalPointer(src_addr);
+    u8* dst_pointer = GetContext().memory->GetPhysicalPointer(dst_addr);
 
     u32 remaining_size = Common::AlignDown(config.texture_copy.size, 16);
 
@@ -396,7 +549,8 @@ inline void Write(u32 addr, const T data) {
         return;
     }
 
-    g_regs[index] = static_cast<u32>(data);
+    Regs& regs = GetRegs();
+    regs[index] = static_cast<u32>(data);
 
     switch (index) {
 
@@ -404,22 +558,24 @@ inline void Write(u32 addr, const T data) {
     case GPU_REG_INDEX_WORKAROUND(memory_fill_config[0].trigger, 0x00004 + 0x3):
     case GPU_REG_INDEX_WORKAROUND(memory_fill_config[1].trigger, 0x00008 + 0x3): {
         const bool is_second_filler = (index != GPU_REG_INDEX(memory_fill_config[0].trigger));
-        auto& config = g_regs.memory_fill_config[is_second_filler];
+        auto& config = regs.memory_fill_config[is_second_filler];
 
         if (config.trigger) {
-            MemoryFill(config);
-            LOG_TRACE(HW_GPU, "MemoryFill from {:#010X} to {:#010X}", config.GetStartAddress(),
-                      config.GetEndAddress());
-
-            // It seems that it won't signal interrupt if "address_start" is zero.
-            // TODO: hwtest this
-            if (config.GetStartAddress() != 0) {
-                if (!is_second_filler) {
-                    Service::GSP::SignalInterrupt(Service::GSP::InterruptId::PSC0);
-                } else {
-                    Service::GSP::SignalInterrupt(Service::GSP::InterruptId::PSC1);
+            SubmitWork([config, is_second_filler] {
+                MemoryFill(config);
+                LOG_TRACE(HW_GPU, "MemoryFill from {:#010X} to {:#010X}",
+                          config.GetStartAddress(), config.GetEndAddress());
+
+                // It seems that it won't signal interrupt if "address_start" is zero.
+                // TODO: hwtest this
+                if (config.GetStartAddress() != 0) {
+                    if (!is_second_filler) {
+                        GPU::SignalInterrupt(Service::GSP::InterruptId::PSC0);
+                    } else {
+                        GPU::SignalInterrupt(Service::GSP::InterruptId::PSC1);
+                    }
                 }
-            }
+            });
 
             // Reset "trigger" flag and set the "finish" flag
             // NOTE: This was confirmed to happen on hardware even if "address_start" is zero.
@@ -430,57 +586,65 @@ inline void Write(u32 addr, const T data) {
     }
 
     case GPU_REG_INDEX(display_transfer_config.trigger): {
-        MICROPROFILE_SCOPE(GPU_DisplayTransfer);
-
-        const auto& config = g_regs.display_transfer_config;
+        const auto& config = regs.display_transfer_config;
         if (config.trigger & 1) {
 
             if (Pica::g_debug_context)
                 Pica::g_debug_context->OnEvent(Pica::DebugContext::Event::IncomingDisplayTransfer,
                                                nullptr);
 
-            if (config.is_texture_copy) {
-                TextureCopy(config);
-                LOG_TRACE(HW_GPU,
-                          "TextureCopy: {:#X} bytes from {:#010X}({}+{})-> "
-                          "{:#010X}({}+{}), flags {:#010X}",
-                          config.texture_copy.size, config.GetPhysicalInputAddress(),
-                          config.texture_copy.input_width * 16, config.texture_copy.input_gap * 16,
-                          config.GetPhysicalOutputAddress(), config.texture_copy.output_width * 16,
-                          config.texture_copy.output_gap * 16, config.flags);
-            } else {
-                DisplayTransfer(config);
-                LOG_TRACE(HW_GPU,
-                          "DisplayTransfer: {:#010X}({}x{})-> "
-                          "{:#010X}({}x{}), dst format {:x}, flags {:#010X}",
-                          config.GetPhysicalInputAddress(), config.input_width.Value(),
-                          config.input_height.Value(), config.GetPhysicalOutputAddress(),
-                          config.output_width.Value(), config.output_height.Value(),
-                          static_cast<u32>(config.output_format.Value()), config.flags);
-            }
+            SubmitWork([config] {
+                MICROPROFILE_SCOPE(GPU_DisplayTransfer);
+
+                if (config.is_texture_copy) {
+                    TextureCopy(config);
+                    LOG_TRACE(HW_GPU,
+                              "TextureCopy: {:#X} bytes from {:#010X}({}+{})-> "
+                              "{:#010X}({}+{}), flags {:#010X}",
+                              config.texture_copy.size, config.GetPhysicalInputAddress(),
+                              config.texture_copy.input_width * 16,
+                              config.texture_copy.input_gap * 16,
+                              config.GetPhysicalOutputAddress(),
+                              config.texture_copy.output_width * 16,
+                              config.texture_copy.output_gap * 16, config.flags);
+                } else {
+                    DisplayTransfer(config);
+                    LOG_TRACE(HW_GPU,
+                              "DisplayTransfer: {:#010X}({}x{})-> "
+                              "{:#010X}({}x{}), dst format {:x}, flags {:#010X}",
+                              config.GetPhysicalInputAddress(), config.input_width.Value(),
+                              config.input_height.Value(), config.GetPhysicalOutputAddress(),
+                              config.output_width.Value(), config.output_height.Value(),
+                              static_cast<u32>(config.output_format.Value()), config.flags);
+                }
+
+                GPU::SignalInterrupt(Service::GSP::InterruptId::PPF);
+            });
 
-            g_regs.display_transfer_config.trigger = 0;
-            Service::GSP::SignalInterrupt(Service::GSP::InterruptId::PPF);
+            regs.display_transfer_config.trigger = 0;
         }
         break;
     }
 
     // Seems like writing to this register triggers processing
     case GPU_REG_INDEX(command_processor_config.trigger): {
-        const auto& config = g_regs.command_processor_config;
+        const auto& config = regs.command_processor_config;
         if (config.trigger & 1) {
-            MICROPROFILE_SCOPE(GPU_CmdlistProcessing);
-
-            u32* buffer = (u32*)g_memory->GetPhysicalPointer(config.GetPhysicalAddress());
+            u32* buffer =
+                (u32*)GetContext().memory->GetPhysicalPointer(config.GetPhysicalAddress());
+            const u32 size = config.size;
 
             if (Pica::g_debug_context && Pica::g_debug_context->recorder) {
-                Pica::g_debug_context->recorder->MemoryAccessed((u8*)buffer, config.size,
+                Pica::g_debug_context->recorder->MemoryAccessed((u8*)buffer, size,
                                                                 config.GetPhysicalAddress());
             }
 
-            Pica::CommandProcessor::ProcessCommandList(buffer, config.size);
+            SubmitWork([buffer, size] {
+                MICROPROFILE_SCOPE(GPU_CmdlistProcessing);
+                Pica::CommandProcessor::ProcessCommandList(buffer, size);
+            });
 
-            g_regs.command_processor_config.trigger = 0;
+            regs.command_processor_config.trigger = 0;
         }
         break;
     }
@@ -512,7 +676,11 @@ template void Write<u8>(u32 addr, const u8 data);
 
 /// Update hardware
 static void VBlankCallback(u64 userdata, s64 cycles_late) {
-    VideoCore::g_renderer->SwapBuffers();
+    // The framebuffers must be complete before they are presented
+    SyncGPUThread();
+
+    VideoCore::GetRenderer()->SwapBuffers();
+    Common::Metrics::TakeSnapshot();
 
     // Signal to GSP that GPU interrupt has occurred
     // TODO(yuriks): hwtest to determine if PDC0 is for the Top screen and PDC1 for the Sub
@@ -523,16 +691,18 @@ static void VBlankCallback(u64 userdata, s64 cycles_late) {
     Service::GSP::SignalInterrupt(Service::GSP::InterruptId::PDC1);
 
     // Reschedule recurrent event
-    Core::System::GetInstance().CoreTiming().ScheduleEvent(frame_ticks - cycles_late, vblank_event);
+    Core::System::GetInstance().CoreTiming().ScheduleEvent(frame_ticks - cycles_late,
+                                                           GetContext().vblank_event);
 }
 
 /// Initialize hardware
 void Init(Memory::MemorySystem& memory) {
-    g_memory = &memory;
-    memset(&g_regs, 0, sizeof(g_regs));
+    Context& context = GetContext();
+    context.memory = &memory;
+    memset(&context.regs, 0, sizeof(context.regs));
 
-    auto& framebuffer_top = g_regs.framebuffer_config[0];
-    auto& framebuffer_sub = g_regs.framebuffer_config[1];
+    auto& framebuffer_top = context.regs.framebuffer_config[0];
+    auto& framebuffer_sub = context.regs.framebuffer_config[1];
 
     // Setup default framebuffer addresses (located in VRAM)
     // .. or at least these are the ones used by system applets.
@@ -557,15 +727,24 @@ void Init(Memory::MemorySystem& memory) {
     framebuffer_sub.color_format.Assign(Regs::PixelFormat::RGB8);
     framebuffer_sub.active_fb = 0;
 
-    Core::Timing& timing = Core::System::GetInstance().CoreTiming();
-    vblank_event = timing.RegisterEvent("GPU::VBlankCallback", VBlankCallback);
-    timing.ScheduleEvent(frame_ticks, vblank_event);
+    Core::System& system = Core::System::GetInstance();
+    Core::Timing& timing = system.CoreTiming();
+    context.vblank_event = timing.RegisterEvent("GPU::VBlankCallback", VBlankCallback);
+    timing.ScheduleEvent(frame_ticks, context.vblank_event);
+
+    if (Settings::values.use_gpu_thread) {
+        if (Settings::values.use_hw_renderer) {
+            LOG_WARNING(HW_GPU, "GPU thread is only used with the software renderer");
+        }
+        context.thread = std::make_unique<GPUThread>(system);
+    }
 
     LOG_DEBUG(HW_GPU, "initialized OK");
 }
 
 /// Shutdown hardware
 void Shutdown() {
+    GetContext().thread.reset();
     LOG_DEBUG(HW_GPU, "shutdown OK");
 }
 
@@ -5,16 +5,25 @@
 #pragma once
 
 #include <cstddef>
+#include <memory>
 #include <type_traits>
 #include "common/assert.h"
 #include "common/bit_field.h"
 #include "common/common_funcs.h"
 #include "common/common_types.h"
 
+namespace Core {
+struct TimingEventType;
+}
+
 namespace Memory {
 class MemorySystem;
 }
 
+namespace Service::GSP {
+enum class InterruptId : u8;
+}
+
 namespace GPU {
 
 constexpr float SCREEN_REFRESH_RATE = 60;
@@ -321,7 +330,23 @@ ASSERT_REG_POSITION(command_processor_config, 0x00638);
 // anyway.
 static_assert(sizeof(Regs) == 0x1000 * sizeof(u32), "Invalid total size of register set");
 
-extern Regs g_regs;
+class GPUThread;
+
+/// GPU state of one emulated console
+struct Context {
+    Context();
+    ~Context();
+
+    Regs regs{};
+    Memory::MemorySystem* memory = nullptr;
+    /// Event id for CoreTiming
+    Core::TimingEventType* vblank_event = nullptr;
+    /// Consumer thread for GPU work, if enabled
+    std::unique_ptr<GPUThread> thread;
+};
+
+/// Returns the GPU registers of the console bound to the calling thread
+Regs& GetRegs();
 
 template <typename T>
 void Read(T& var, const u32 addr);
@@ -329,6 +354,23 @@ void Read(T& var, const u32 addr);
 template <typename T>
 void Write(u32 addr, const T data);
 
+/**
+ * Signals a GSP interrupt raised by GPU work. When called from the GPU thread, the interrupt is
+ * deferred until the emulation thread picks it up in Update() or SyncGPUThread().
+ * @param interrupt_id ID of interrupt that is being signalled
+ */
+void SignalInterrupt(Service::GSP::InterruptId interrupt_id);
+
+/**
+ * Waits for all work submitted to the GPU thread to complete and delivers its pending interrupts.
+ * Does nothing if the GPU thread is disabled or when called from the GPU thread itself.
+ * @returns true if any interrupt was delivered
+ */
+bool SyncGPUThread();
+
+/// Delivers interrupts raised by the GPU thread so far, without waiting for it
+void Update();
+
 /// Initialize hardware
 void Init(Memory::MemorySystem& memory);
 
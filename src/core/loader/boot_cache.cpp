@@ -0,0 +1,114 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <string>
+#include <fmt/format.h>
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "core/file_sys/ncch_container.h"
+#include "core/loader/boot_cache.h"
+
+namespace Loader::BootCache {
+
+namespace {
+
+constexpr u32 FILE_MAGIC = 0x43544243; // "CBTC"
+/// Increase this when the layout of the file changes
+constexpr u32 FILE_VERSION = 1;
+
+/// The .code section of a title can't be larger than the memory of a New 3DS
+constexpr u64 MAX_CODE_SIZE = 0x10000000;
+
+struct FileHeader {
+    u32 magic;
+    u32 version;
+    u64 program_id;
+    u64 content_hash;
+    u64 code_size;
+    u64 code_hash;
+};
+
+std::string GetPath(u64 program_id) {
+    return fmt::format("{}{}" DIR_SEP "{:016X}.bin",
+                       FileUtil::GetUserPath(FileUtil::UserPath::CacheDir), BOOT_CACHE_DIR,
+                       program_id);
+}
+
+} // Anonymous namespace
+
+u64 ComputeContentHash(const FileSys::NCCHContainer& ncch) {
+    u64 hash = Common::ComputeHash64(&ncch.ncch_header, sizeof(ncch.ncch_header));
+    hash = Common::CityHash64WithSeed(reinterpret_cast<const char*>(&ncch.exheader_header),
+                                      sizeof(ncch.exheader_header), hash);
+    return Common::CityHash64WithSeed(reinterpret_cast<const char*>(&ncch.exefs_header),
+                                      sizeof(ncch.exefs_header), hash);
+}
+
+bool Load(u64 program_id, u64 content_hash, std::vector<u8>& code) {
+    const std::string path = GetPath(program_id);
+    FileUtil::IOFile file(path, "rb");
+    if (!file.IsOpen()) {
+        return false;
+    }
+
+    FileHeader header;
+    if (file.ReadBytes(&header, sizeof(header)) != sizeof(header) || header.magic != FILE_MAGIC ||
+        header.version != FILE_VERSION || header.program_id != program_id ||
+        header.content_hash != content_hash) {
+        LOG_INFO(Loader, "Boot cache {} is outdated, discarding it", path);
+        return false;
+    }
+    if (header.code_size > MAX_CODE_SIZE || file.GetSize() != sizeof(header) + header.code_size) {
+        LOG_WARNING(Loader, "Boot cache {} is truncated, discarding it", path);
+        return false;
+    }
+
+    code.resize(header.code_size);
+    if (file.ReadBytes(code.data(), code.size()) != code.size() ||
+        Common::ComputeHash64(code.data(), code.size()) != header.code_hash) {
+        LOG_WARNING(Loader, "Boot cache {} is corrupted, discarding it", path);
+        code.clear();
+        return false;
+    }
+
+    LOG_INFO(Loader, "Loaded code of {:016X} from boot cache", program_id);
+    return true;
+}
+
+void Store(u64 program_id, u64 content_hash, const std::vector<u8>& code) {
+    const std::string path = GetPath(program_id);
+    const std::string temp_path = path + ".tmp";
+
+    // Write to a separate file first so that an interrupted write never leaves behind an entry
+    // that looks complete
+    FileUtil::CreateFullPath(path);
+    {
+        FileUtil::IOFile file(temp_path, "wb");
+        const FileHeader header{FILE_MAGIC,
+                                FILE_VERSION,
+                                program_id,
+                                content_hash,
+                                code.size(),
+                                Common::ComputeHash64(code.data(), code.size())};
+        if (!file.IsOpen() || !file.WriteObject(header) ||
+            file.WriteBytes(code.data(), code.size()) != code.size()) {
+            LOG_ERROR(Loader, "Failed to write boot cache {}", path);
+            file.Close();
+            FileUtil::Delete(temp_path);
+            return;
+        }
+    }
+
+    if (FileUtil::Exists(path)) {
+        FileUtil::Delete(path);
+    }
+    if (!FileUtil::Rename(temp_path, path)) {
+        LOG_ERROR(Loader, "Failed to replace boot cache {}", path);
+        FileUtil::Delete(temp_path);
+    }
+}
+
+} // namespace Loader::BootCache
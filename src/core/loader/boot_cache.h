@@ -0,0 +1,40 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <vector>
+#include "common/common_types.h"
+
+namespace FileSys {
+class NCCHContainer;
+}
+
+/**
+ * On-disk cache of the .code sections of titles after LZSS decompression, decryption and IPS
+ * patching, so that later boots only have to read them back.
+ *
+ * Entries live in the boot cache directory, one file per program id, and are tagged with a hash of
+ * the NCCH header, the extended header and the ExeFS header. The ExeFS header holds the SHA-256 of
+ * every section, so an update or a different dump of a title replaces the entry instead of reusing
+ * it.
+ */
+namespace Loader::BootCache {
+
+/// Computes the hash identifying the code of a loaded container
+u64 ComputeContentHash(const FileSys::NCCHContainer& ncch);
+
+/**
+ * Reads the cached code of a title
+ * @param program_id Program id of the title
+ * @param content_hash Hash returned by ComputeContentHash for the container the code comes from
+ * @param code Buffer receiving the code
+ * @return whether a matching and intact entry was found
+ */
+bool Load(u64 program_id, u64 content_hash, std::vector<u8>& code);
+
+/// Stores the code of a title, replacing any previous entry for it
+void Store(u64 program_id, u64 content_hash, const std::vector<u8>& code);
+
+} // namespace Loader::BootCache
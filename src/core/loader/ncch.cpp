@@ -21,9 +21,11 @@
 #include "core/hle/service/am/am.h"
 #include "core/hle/service/cfg/cfg.h"
 #include "core/hle/service/fs/archive.h"
+#include "core/loader/boot_cache.h"
 #include "core/loader/ncch.h"
 #include "core/loader/smdh.h"
 #include "core/memory.h"
+#include "core/settings.h"
 #include "network/network.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -196,7 +198,25 @@ ResultStatus AppLoader_NCCH::Load(std::shared_ptr<Kernel::Process>& process) {
 }
 
 ResultStatus AppLoader_NCCH::ReadCode(std::vector<u8>& buffer) {
-    return overlay_ncch->LoadSectionExeFS(".code", buffer);
+    // Files next to the NCCH can replace or patch the code at any time, so it is never cached
+    if (!Settings::values.use_boot_cache || overlay_ncch->IsTainted()) {
+        return overlay_ncch->LoadSectionExeFS(".code", buffer);
+    }
+
+    u64_le program_id;
+    ResultStatus result = ReadProgramId(program_id);
+    if (result != ResultStatus::Success)
+        return result;
+
+    const u64 content_hash = BootCache::ComputeContentHash(*overlay_ncch);
+    if (BootCache::Load(program_id, content_hash, buffer))
+        return ResultStatus::Success;
+
+    result = overlay_ncch->LoadSectionExeFS(".code", buffer);
+    if (result == ResultStatus::Success) {
+        BootCache::Store(program_id, content_hash, buffer);
+    }
+    return result;
 }
 
 ResultStatus AppLoader_NCCH::ReadIcon(std::vector<u8>& buffer) {
@@ -2,9 +2,11 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
 #include <cstring>
 #include "audio_core/dsp_interface.h"
+#include "common/alignment.h"
 #include "common/assert.h"
 #include "common/common_types.h"
 #include "common/logging/log.h"
@@ -13,19 +15,36 @@
 #include "core/core.h"
 #include "core/hle/kernel/memory.h"
 #include "core/hle/kernel/process.h"
-#include "core/hle/lock.h"
+#include "core/hw/gpu.h"
 #include "core/memory.h"
 #include "video_core/renderer_base.h"
 #include "video_core/video_core.h"
 
 namespace Memory {
 
+/// Number of logged rasterizer cache changes after which lagging page tables are fully resynced
+constexpr std::size_t MAX_CACHE_LOG_SIZE = 0x10000;
+
+/// A virtual region the rasterizer cache can mark, and the physical memory it is backed by
+struct RasterizerCacheRegion {
+    VAddr vaddr;
+    VAddr vaddr_end;
+    PAddr paddr;
+};
+
+constexpr std::array<RasterizerCacheRegion, 3> rasterizer_cache_regions{{
+    {VRAM_VADDR, VRAM_VADDR_END, VRAM_PADDR},
+    {LINEAR_HEAP_VADDR, LINEAR_HEAP_VADDR_END, FCRAM_PADDR},
+    {NEW_LINEAR_HEAP_VADDR, NEW_LINEAR_HEAP_VADDR_END, FCRAM_PADDR},
+}};
+
 class RasterizerCacheMarker {
 public:
-    void Mark(VAddr addr, bool cached) {
-        bool* p = At(addr);
+    /// Marks a run of pages that lies within a single rasterizer cache region
+    void MarkRange(VAddr start, u32 num_pages, bool cached) {
+        bool* p = At(start);
         if (p)
-            *p = cached;
+            std::fill_n(p, num_pages, cached);
     }
 
     bool IsCached(VAddr addr) {
@@ -35,6 +54,11 @@ public:
         return false;
     }
 
+    /// Gets the state of the page at addr, followed by the pages after it in the same region
+    const bool* GetRange(VAddr addr) {
+        return At(addr);
+    }
+
 private:
     bool* At(VAddr addr) {
         if (addr >= VRAM_VADDR && addr < VRAM_VADDR_END) {
@@ -56,23 +80,45 @@ private:
 
 class MemorySystem::Impl {
 public:
-    // Visual Studio would try to allocate these on compile time if they are std::array, which would
-    // exceed the memory limit.
-    std::unique_ptr<u8[]> fcram = std::make_unique<u8[]>(Memory::FCRAM_N3DS_SIZE);
-    std::unique_ptr<u8[]> vram = std::make_unique<u8[]>(Memory::VRAM_SIZE);
-    std::unique_ptr<u8[]> n3ds_extra_ram = std::make_unique<u8[]>(Memory::N3DS_EXTRA_RAM_SIZE);
+    Impl() = default;
+    explicit Impl(const RamImage& image)
+        : fcram(image.fcram), vram(image.vram), n3ds_extra_ram(image.n3ds_extra_ram) {}
+
+    Common::HostMemory fcram{Memory::FCRAM_N3DS_SIZE};
+    Common::HostMemory vram{Memory::VRAM_SIZE};
+    Common::HostMemory n3ds_extra_ram{Memory::N3DS_EXTRA_RAM_SIZE};
 
     PageTable* current_page_table = nullptr;
     RasterizerCacheMarker cache_marker;
     std::vector<PageTable*> page_table_list;
 
+    struct CacheLogEntry {
+        VAddr start;
+        u32 num_pages;
+    };
+
+    /// Runs of pages whose rasterizer cache state changed, oldest first
+    std::vector<CacheLogEntry> cache_log;
+    /// Log position of the first entry of cache_log
+    u64 cache_log_start = 0;
+    /// Number of registered page tables that have not applied every entry of cache_log yet
+    std::size_t num_lagging_tables = 0;
+
+    u64 GetCacheLogEnd() const {
+        return cache_log_start + cache_log.size();
+    }
+
     AudioCore::DspInterface* dsp = nullptr;
 };
 
 MemorySystem::MemorySystem() : impl(std::make_unique<Impl>()) {}
+MemorySystem::MemorySystem(const RamImage& image) : impl(std::make_unique<Impl>(image)) {}
 MemorySystem::~MemorySystem() = default;
 
 void MemorySystem::SetCurrentPageTable(PageTable* page_table) {
+    if (page_table != nullptr) {
+        SyncPageTable(*page_table);
+    }
     impl->current_page_table = page_table;
 }
 
@@ -129,24 +175,96 @@ void MemorySystem::UnmapRegion(PageTable& page_table, VAddr base, u32 size) {
 
 u8* MemorySystem::GetPointerForRasterizerCache(VAddr addr) {
     if (addr >= LINEAR_HEAP_VADDR && addr < LINEAR_HEAP_VADDR_END) {
-        return impl->fcram.get() + (addr - LINEAR_HEAP_VADDR);
+        return impl->fcram.data() + (addr - LINEAR_HEAP_VADDR);
     }
     if (addr >= NEW_LINEAR_HEAP_VADDR && addr < NEW_LINEAR_HEAP_VADDR_END) {
-        return impl->fcram.get() + (addr - NEW_LINEAR_HEAP_VADDR);
+        return impl->fcram.data() + (addr - NEW_LINEAR_HEAP_VADDR);
     }
     if (addr >= VRAM_VADDR && addr < VRAM_VADDR_END) {
-        return impl->vram.get() + (addr - VRAM_VADDR);
+        return impl->vram.data() + (addr - VRAM_VADDR);
     }
     UNREACHABLE();
 }
 
 void MemorySystem::RegisterPageTable(PageTable* page_table) {
+    // Mappings always follow the current cache state, so the table starts out up to date
+    page_table->cache_log_position = impl->GetCacheLogEnd();
+    page_table->cache_log_registered = true;
     impl->page_table_list.push_back(page_table);
 }
 
 void MemorySystem::UnregisterPageTable(PageTable* page_table) {
+    if (page_table->cache_log_position != impl->GetCacheLogEnd()) {
+        --impl->num_lagging_tables;
+    }
+    page_table->cache_log_registered = false;
     impl->page_table_list.erase(
         std::find(impl->page_table_list.begin(), impl->page_table_list.end(), page_table));
+    TrimCacheLog();
+}
+
+void MemorySystem::UpdateRasterizerCachedRange(PageTable& page_table, VAddr start,
+                                               u32 num_pages) {
+    const u32 first_page = start >> PAGE_BITS;
+    const bool* const cached = impl->cache_marker.GetRange(start);
+    u8* pointer = GetPointerForRasterizerCache(start);
+
+    for (u32 i = 0; i < num_pages; ++i, pointer += PAGE_SIZE) {
+        PageType& page_type = page_table.attributes[first_page + i];
+
+        // It is not necessary for a process to have this region mapped into its address space,
+        // for example, a system module need not have a VRAM mapping.
+        if (page_type == PageType::Unmapped) {
+            continue;
+        }
+
+        ASSERT(page_type == PageType::Memory || page_type == PageType::RasterizerCachedMemory);
+        if (cached[i]) {
+            page_type = PageType::RasterizerCachedMemory;
+            page_table.pointers[first_page + i] = nullptr;
+        } else {
+            page_type = PageType::Memory;
+            page_table.pointers[first_page + i] = pointer;
+        }
+    }
+}
+
+void MemorySystem::SyncPageTable(const PageTable& page_table) {
+    const u64 log_end = impl->GetCacheLogEnd();
+    // Unregistered tables are not tracked by the rasterizer cache
+    if (page_table.cache_log_position == log_end || !page_table.cache_log_registered) {
+        return;
+    }
+
+    // Callers only reach the table through the process owning it, which does not make its pages
+    // any less subject to the rasterizer cache state
+    PageTable& table = const_cast<PageTable&>(page_table);
+
+    if (table.cache_log_position < impl->cache_log_start) {
+        // The changes this table missed have been dropped, so check every page that can be cached
+        for (const RasterizerCacheRegion& region : rasterizer_cache_regions) {
+            UpdateRasterizerCachedRange(table, region.vaddr,
+                                        (region.vaddr_end - region.vaddr) >> PAGE_BITS);
+        }
+    } else {
+        for (auto i = table.cache_log_position - impl->cache_log_start; i < impl->cache_log.size();
+             ++i) {
+            const Impl::CacheLogEntry& entry = impl->cache_log[i];
+            UpdateRasterizerCachedRange(table, entry.start, entry.num_pages);
+        }
+    }
+
+    table.cache_log_position = log_end;
+    --impl->num_lagging_tables;
+    TrimCacheLog();
+}
+
+void MemorySystem::TrimCacheLog() {
+    // Past a certain size, lagging tables are cheaper to resync entirely than through the log
+    if (impl->num_lagging_tables == 0 || impl->cache_log.size() > MAX_CACHE_LOG_SIZE) {
+        impl->cache_log_start = impl->GetCacheLogEnd();
+        impl->cache_log.clear();
+    }
 }
 
 /**
@@ -271,6 +389,27 @@ u8* MemorySystem::GetPointer(const VAddr vaddr) {
     return nullptr;
 }
 
+u8* MemorySystem::GetContiguousPointer(const Kernel::Process& process, const VAddr vaddr,
+                                       const std::size_t size) {
+    auto& page_table = process.vm_manager.page_table;
+    SyncPageTable(page_table);
+
+    const std::size_t first_page = vaddr >> PAGE_BITS;
+    const std::size_t last_page = (vaddr + std::max<std::size_t>(size, 1) - 1) >> PAGE_BITS;
+    if (last_page >= PAGE_TABLE_NUM_ENTRIES) {
+        return nullptr;
+    }
+
+    u8* const base = page_table.pointers[first_page];
+    for (std::size_t page = first_page; page <= last_page; ++page) {
+        if (page_table.attributes[page] != PageType::Memory ||
+            page_table.pointers[page] != base + ((page - first_page) << PAGE_BITS)) {
+            return nullptr;
+        }
+    }
+    return base + (vaddr & PAGE_MASK);
+}
+
 std::string MemorySystem::ReadCString(VAddr vaddr, std::size_t max_length) {
     std::string string;
     string.reserve(max_length);
@@ -315,16 +454,16 @@ u8* MemorySystem::GetPhysicalPointer(PAddr address) {
     u8* target_pointer = nullptr;
     switch (area->paddr_base) {
     case VRAM_PADDR:
-        target_pointer = impl->vram.get() + offset_into_region;
+        target_pointer = impl->vram.data() + offset_into_region;
         break;
     case DSP_RAM_PADDR:
         target_pointer = impl->dsp->GetDspMemory().data() + offset_into_region;
         break;
     case FCRAM_PADDR:
-        target_pointer = impl->fcram.get() + offset_into_region;
+        target_pointer = impl->fcram.data() + offset_into_region;
         break;
     case N3DS_EXTRA_RAM_PADDR:
-        target_pointer = impl->n3ds_extra_ram.get() + offset_into_region;
+        target_pointer = impl->n3ds_extra_ram.data() + offset_into_region;
         break;
     default:
         UNREACHABLE();
@@ -333,105 +472,101 @@ u8* MemorySystem::GetPhysicalPointer(PAddr address) {
     return target_pointer;
 }
 
-/// For a rasterizer-accessible PAddr, gets a list of all possible VAddr
-static std::vector<VAddr> PhysicalToVirtualAddressForRasterizer(PAddr addr) {
-    if (addr >= VRAM_PADDR && addr < VRAM_PADDR_END) {
-        return {addr - VRAM_PADDR + VRAM_VADDR};
-    }
-    if (addr >= FCRAM_PADDR && addr < FCRAM_PADDR_END) {
-        return {addr - FCRAM_PADDR + LINEAR_HEAP_VADDR, addr - FCRAM_PADDR + NEW_LINEAR_HEAP_VADDR};
+void MemorySystem::RasterizerMarkRegionCached(PAddr start, u32 size, bool cached) {
+    if (start == 0 || size == 0) {
+        return;
     }
-    if (addr >= FCRAM_PADDR_END && addr < FCRAM_N3DS_PADDR_END) {
-        return {addr - FCRAM_PADDR + NEW_LINEAR_HEAP_VADDR};
+
+    // Only the current page table is updated right away, the others catch up when next used
+    PageTable* const current_page_table = impl->current_page_table;
+    const bool update_current = current_page_table != nullptr &&
+                                current_page_table->cache_log_position == impl->GetCacheLogEnd();
+
+    // Work on whole pages, in 64 bits so that ranges touching the end of the address space work
+    const u64 paddr_start = start & ~PAGE_MASK;
+    const u64 paddr_end = Common::AlignUp(static_cast<u64>(start) + size, PAGE_SIZE);
+
+    // Every physical page maps to at most one virtual page per region, so each region the range
+    // overlaps gives one contiguous run of virtual pages
+    u64 mapped_size = 0;
+    for (const RasterizerCacheRegion& region : rasterizer_cache_regions) {
+        const u64 region_start = region.paddr;
+        const u64 region_end = region.paddr + (region.vaddr_end - region.vaddr);
+        const u64 overlap_start = std::max(paddr_start, region_start);
+        const u64 overlap_end = std::min(paddr_end, region_end);
+        if (overlap_start >= overlap_end) {
+            continue;
+        }
+
+        const VAddr vaddr = static_cast<VAddr>(region.vaddr + (overlap_start - region_start));
+        const u32 num_pages = static_cast<u32>((overlap_end - overlap_start) >> PAGE_BITS);
+        impl->cache_marker.MarkRange(vaddr, num_pages, cached);
+        impl->cache_log.push_back({vaddr, num_pages});
+        if (update_current) {
+            UpdateRasterizerCachedRange(*current_page_table, vaddr, num_pages);
+        }
+
+        // The new linear heap aliases the whole of FCRAM, so it alone decides what is covered
+        if (region.vaddr != LINEAR_HEAP_VADDR) {
+            mapped_size += overlap_end - overlap_start;
+        }
     }
+
     // While the physical <-> virtual mapping is 1:1 for the regions supported by the cache,
     // some games (like Pokemon Super Mystery Dungeon) will try to use textures that go beyond
     // the end address of VRAM, causing the Virtual->Physical translation to fail when flushing
     // parts of the texture.
-    LOG_ERROR(HW_Memory, "Trying to use invalid physical address for rasterizer: {:08X}", addr);
-    return {};
-}
-
-void MemorySystem::RasterizerMarkRegionCached(PAddr start, u32 size, bool cached) {
-    if (start == 0) {
-        return;
+    if (mapped_size != paddr_end - paddr_start) {
+        LOG_ERROR(HW_Memory,
+                  "Trying to use invalid physical address range for rasterizer: {:08X}-{:08X}",
+                  start, static_cast<u64>(start) + size);
     }
 
-    u32 num_pages = ((start + size - 1) >> PAGE_BITS) - (start >> PAGE_BITS) + 1;
-    PAddr paddr = start;
-
-    for (unsigned i = 0; i < num_pages; ++i, paddr += PAGE_SIZE) {
-        for (VAddr vaddr : PhysicalToVirtualAddressForRasterizer(paddr)) {
-            impl->cache_marker.Mark(vaddr, cached);
-            for (PageTable* page_table : impl->page_table_list) {
-                PageType& page_type = page_table->attributes[vaddr >> PAGE_BITS];
-
-                if (cached) {
-                    // Switch page type to cached if now cached
-                    switch (page_type) {
-                    case PageType::Unmapped:
-                        // It is not necessary for a process to have this region mapped into its
-                        // address space, for example, a system module need not have a VRAM mapping.
-                        break;
-                    case PageType::Memory:
-                        page_type = PageType::RasterizerCachedMemory;
-                        page_table->pointers[vaddr >> PAGE_BITS] = nullptr;
-                        break;
-                    default:
-                        UNREACHABLE();
-                    }
-                } else {
-                    // Switch page type to uncached if now uncached
-                    switch (page_type) {
-                    case PageType::Unmapped:
-                        // It is not necessary for a process to have this region mapped into its
-                        // address space, for example, a system module need not have a VRAM mapping.
-                        break;
-                    case PageType::RasterizerCachedMemory: {
-                        page_type = PageType::Memory;
-                        page_table->pointers[vaddr >> PAGE_BITS] =
-                            GetPointerForRasterizerCache(vaddr & ~PAGE_MASK);
-                        break;
-                    }
-                    default:
-                        UNREACHABLE();
-                    }
-                }
-            }
-        }
+    const u64 log_end = impl->GetCacheLogEnd();
+    if (update_current) {
+        current_page_table->cache_log_position = log_end;
     }
+    const auto& list = impl->page_table_list;
+    impl->num_lagging_tables = static_cast<std::size_t>(
+        std::count_if(list.begin(), list.end(), [log_end](const PageTable* table) {
+            return table->cache_log_position != log_end;
+        }));
+    TrimCacheLog();
 }
 
 void RasterizerFlushRegion(PAddr start, u32 size) {
-    if (VideoCore::g_renderer == nullptr) {
+    if (VideoCore::GetRenderer() == nullptr) {
         return;
     }
 
-    VideoCore::g_renderer->Rasterizer()->FlushRegion(start, size);
+    VideoCore::GetRenderer()->Rasterizer()->FlushRegion(start, size);
 }
 
 void RasterizerInvalidateRegion(PAddr start, u32 size) {
-    if (VideoCore::g_renderer == nullptr) {
+    if (VideoCore::GetRenderer() == nullptr) {
         return;
     }
 
-    VideoCore::g_renderer->Rasterizer()->InvalidateRegion(start, size);
+    VideoCore::GetRenderer()->Rasterizer()->InvalidateRegion(start, size);
 }
 
 void RasterizerFlushAndInvalidateRegion(PAddr start, u32 size) {
     // Since pages are unmapped on shutdown after video core is shutdown, the renderer may be
     // null here
-    if (VideoCore::g_renderer == nullptr) {
+    if (VideoCore::GetRenderer() == nullptr) {
         return;
     }
 
-    VideoCore::g_renderer->Rasterizer()->FlushAndInvalidateRegion(start, size);
+    VideoCore::GetRenderer()->Rasterizer()->FlushAndInvalidateRegion(start, size);
 }
 
 void RasterizerFlushVirtualRegion(VAddr start, u32 size, FlushMode mode) {
+    // CPU-side accesses to rasterizer-visible memory must observe all submitted GPU work
+    GPU::SyncGPUThread();
+
     // Since pages are unmapped on shutdown after video core is shutdown, the renderer may be
     // null here
-    if (VideoCore::g_renderer == nullptr) {
+    if (VideoCore::GetRenderer() == nullptr) {
         return;
     }
 
@@ -448,7 +583,7 @@ void RasterizerFlushVirtualRegion(VAddr start, u32 size, FlushMode mode) {
         PAddr physical_start = paddr_region_start + (overlap_start - region_start);
         u32 overlap_size = overlap_end - overlap_start;
 
-        auto* rasterizer = VideoCore::g_renderer->Rasterizer();
+        auto* rasterizer = VideoCore::GetRenderer()->Rasterizer();
         switch (mode) {
         case FlushMode::Flush:
             rasterizer->FlushRegion(physical_start, overlap_size);
@@ -486,6 +621,7 @@ u64 MemorySystem::Read64(const VAddr addr) {
 void MemorySystem::ReadBlock(const Kernel::Process& process, const VAddr src_addr,
                              void* dest_buffer, const std::size_t size) {
     auto& page_table = process.vm_manager.page_table;
+    SyncPageTable(page_table);
 
     std::size_t remaining_size = size;
     std::size_t page_index = src_addr >> PAGE_BITS;
@@ -552,6 +688,7 @@ void MemorySystem::Write64(const VAddr addr, const u64 data) {
 void MemorySystem::WriteBlock(const Kernel::Process& process, const VAddr dest_addr,
                               const void* src_buffer, const std::size_t size) {
     auto& page_table = process.vm_manager.page_table;
+    SyncPageTable(page_table);
     std::size_t remaining_size = size;
     std::size_t page_index = dest_addr >> PAGE_BITS;
     std::size_t page_offset = dest_addr & PAGE_MASK;
@@ -600,6 +737,7 @@ void MemorySystem::WriteBlock(const Kernel::Process& process, const VAddr dest_a
 void MemorySystem::ZeroBlock(const Kernel::Process& process, const VAddr dest_addr,
                              const std::size_t size) {
     auto& page_table = process.vm_manager.page_table;
+    SyncPageTable(page_table);
     std::size_t remaining_size = size;
     std::size_t page_index = dest_addr >> PAGE_BITS;
     std::size_t page_offset = dest_addr & PAGE_MASK;
@@ -655,6 +793,7 @@ void MemorySystem::CopyBlock(const Kernel::Process& dest_process,
                              const Kernel::Process& src_process, VAddr dest_addr, VAddr src_addr,
                              std::size_t size) {
     auto& page_table = src_process.vm_manager.page_table;
+    SyncPageTable(page_table);
     std::size_t remaining_size = size;
     std::size_t page_index = src_addr >> PAGE_BITS;
     std::size_t page_offset = src_addr & PAGE_MASK;
@@ -745,17 +884,26 @@ void WriteMMIO<u64>(MMIORegionPointer mmio_handler, VAddr addr, const u64 data)
 }
 
 u32 MemorySystem::GetFCRAMOffset(u8* pointer) {
-    ASSERT(pointer >= impl->fcram.get() && pointer <= impl->fcram.get() + Memory::FCRAM_N3DS_SIZE);
-    return pointer - impl->fcram.get();
+    ASSERT(pointer >= impl->fcram.data() && pointer <= impl->fcram.data() + Memory::FCRAM_N3DS_SIZE);
+    return pointer - impl->fcram.data();
 }
 
 u8* MemorySystem::GetFCRAMPointer(u32 offset) {
     ASSERT(offset <= Memory::FCRAM_N3DS_SIZE);
-    return impl->fcram.get() + offset;
+    return impl->fcram.data() + offset;
 }
 
 void MemorySystem::SetDSP(AudioCore::DspInterface& dsp) {
     impl->dsp = &dsp;
 }
 
+MemorySystem::RamImage MemorySystem::CaptureRam() {
+    // Surfaces only modified by the GPU have to be written back to be part of the image
+    RasterizerFlushRegion(VRAM_PADDR, VRAM_SIZE);
+    RasterizerFlushRegion(FCRAM_PADDR, FCRAM_N3DS_SIZE);
+
+    return {impl->fcram.CreateImage(), impl->vram.CreateImage(),
+            impl->n3ds_extra_ram.CreateImage()};
+}
+
 } // namespace Memory
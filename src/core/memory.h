@@ -10,6 +10,7 @@
 #include <string>
 #include <vector>
 #include "common/common_types.h"
+#include "common/host_memory.h"
 #include "core/mmio.h"
 
 class ARM_Interface;
@@ -78,6 +79,15 @@ struct PageTable {
      * the corresponding entry in `pointers` MUST be set to null.
      */
     std::array<PageType, PAGE_TABLE_NUM_ENTRIES> attributes;
+
+    /**
+     * Position in the log of rasterizer cache changes up to which the attributes of this table are
+     * up to date. Registered tables other than the current one are only updated when next used.
+     */
+    u64 cache_log_position = 0;
+
+    /// Whether the table is registered, and so kept in sync with the rasterizer cache state
+    bool cache_log_registered = false;
 };
 
 /// Physical memory regions as seen from the ARM11
@@ -217,7 +227,21 @@ void RasterizerFlushVirtualRegion(VAddr start, u32 size, FlushMode mode);
 
 class MemorySystem {
 public:
+    /// Contents of the emulated RAM captured by CaptureRam
+    struct RamImage {
+        std::shared_ptr<const Common::HostMemoryImage> fcram;
+        std::shared_ptr<const Common::HostMemoryImage> vram;
+        std::shared_ptr<const Common::HostMemoryImage> n3ds_extra_ram;
+    };
+
     MemorySystem();
+
+    /**
+     * Creates a memory system whose RAM starts out with the contents of a captured image. Where
+     * the host supports it, pages are shared with the image until either side writes to them.
+     */
+    explicit MemorySystem(const RamImage& image);
+
     ~MemorySystem();
 
     /**
@@ -265,6 +289,14 @@ public:
     void CopyBlock(const Kernel::Process& dest_process, const Kernel::Process& src_process,
                    VAddr dest_addr, VAddr src_addr, std::size_t size);
 
+    /**
+     * Gets a pointer to a range of the address space of a process if the whole range is backed by
+     * contiguous host memory that the rasterizer does not cache, so that it can be accessed without
+     * going through ReadBlock and WriteBlock. Returns nullptr otherwise. The pointer is only valid
+     * until the memory map of the process or the rasterizer cache changes.
+     */
+    u8* GetContiguousPointer(const Kernel::Process& process, VAddr vaddr, std::size_t size);
+
     std::string ReadCString(VAddr vaddr, std::size_t max_length);
 
     /**
@@ -295,6 +327,13 @@ public:
 
     void SetDSP(AudioCore::DspInterface& dsp);
 
+    /**
+     * Captures the contents of FCRAM, VRAM and the New 3DS extra RAM, for example to start other
+     * instances from a booted title. Where the host supports it, the first capture does not copy
+     * anything, and later ones copy the RAM once; emulation keeps running on copy-on-write pages.
+     */
+    RamImage CaptureRam();
+
 private:
     template <typename T>
     T Read(const VAddr vaddr);
@@ -310,6 +349,18 @@ private:
      */
     u8* GetPointerForRasterizerCache(VAddr addr);
 
+    /**
+     * Sets the types of the mapped pages of a run within the linear heap or VRAM from their
+     * rasterizer cache state.
+     */
+    void UpdateRasterizerCachedRange(PageTable& page_table, VAddr start, u32 num_pages);
+
+    /// Applies the rasterizer cache changes a registered page table has missed since its last use
+    void SyncPageTable(const PageTable& page_table);
+
+    /// Drops the logged rasterizer cache changes once every registered page table has applied them
+    void TrimCacheLog();
+
     void MapPages(PageTable& page_table, u32 base, u32 size, u8* memory, PageType type);
 
     class Impl;
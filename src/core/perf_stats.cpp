@@ -29,6 +29,7 @@ void PerfStats::EndSystemFrame() {
     auto frame_end = Clock::now();
     accumulated_frametime += frame_end - frame_begin;
     system_frames += 1;
+    total_system_frames += 1;
 
     previous_frame_length = frame_end - previous_frame_end;
     previous_frame_end = frame_end;
@@ -73,6 +74,12 @@ double PerfStats::GetLastFrameTimeScale() {
     return duration_cast<DoubleSecs>(previous_frame_length).count() / FRAME_LENGTH;
 }
 
+u64 PerfStats::GetTotalSystemFrames() {
+    std::lock_guard lock{object_mutex};
+
+    return total_system_frames;
+}
+
 void FrameLimiter::DoFrameLimiting(microseconds current_system_time_us) {
     if (frame_advancing_enabled) {
         // Frame advancing is enabled: wait on event instead of doing framelimiting
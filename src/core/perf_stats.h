@@ -43,6 +43,9 @@ public:
      */
     double GetLastFrameTimeScale();
 
+    /// Gets the number of system frames presented since this object was created
+    u64 GetTotalSystemFrames();
+
 private:
     std::mutex object_mutex;
 
@@ -57,6 +60,8 @@ private:
     u32 system_frames = 0;
     /// Cumulative number of game frames (GSP frame submissions) since last reset
     u32 game_frames = 0;
+    /// Cumulative number of system frames, never reset
+    u64 total_system_frames = 0;
 
     /// Point when the previous system frame ended
     Clock::time_point previous_frame_end = reset_point;
@@ -14,6 +14,8 @@ enum class PacketType {
     Undefined = 0,
     ReadMemory,
     WriteMemory,
+    ReadMetrics,
+    ReadMetricName,
 };
 
 struct PacketHeader {
@@ -28,6 +30,8 @@ constexpr u32 MIN_PACKET_SIZE = sizeof(PacketHeader);
 constexpr u32 MAX_PACKET_DATA_SIZE = 32;
 constexpr u32 MAX_PACKET_SIZE = MIN_PACKET_SIZE + MAX_PACKET_DATA_SIZE;
 constexpr u32 MAX_READ_SIZE = MAX_PACKET_DATA_SIZE;
+/// A ReadMetrics reply holds the snapshot sequence and counter count, followed by counter values
+constexpr u32 MAX_METRICS_PER_PACKET = (MAX_PACKET_DATA_SIZE - sizeof(u32) * 2) / sizeof(u64);
 
 class Packet {
 public:
@@ -1,4 +1,7 @@
+#include <algorithm>
+#include <cstring>
 #include "common/logging/log.h"
+#include "common/metrics.h"
 #include "core/arm/arm_interface.h"
 #include "core/core.h"
 #include "core/hle/kernel/process.h"
@@ -52,6 +55,42 @@ void RPCServer::HandleWriteMemory(Packet& packet, u32 address, const u8* data, u
     packet.SendReply();
 }
 
+void RPCServer::HandleReadMetrics(Packet& packet, u32 first_index) {
+    const Common::Metrics::Snapshot snapshot = Common::Metrics::GetSnapshot();
+    const u32 sequence = static_cast<u32>(snapshot.sequence);
+    const u32 num_counters = static_cast<u32>(snapshot.values.size());
+    const u32 num_values =
+        first_index < num_counters ? std::min(num_counters - first_index, MAX_METRICS_PER_PACKET)
+                                   : 0;
+
+    u8* data = packet.GetPacketData().data();
+    std::memcpy(data, &sequence, sizeof(sequence));
+    std::memcpy(data + sizeof(u32), &num_counters, sizeof(num_counters));
+    if (num_values > 0) {
+        std::memcpy(data + sizeof(u32) * 2, snapshot.values.data() + first_index,
+                    num_values * sizeof(u64));
+    }
+    packet.SetPacketDataSize(static_cast<u32>(sizeof(u32) * 2 + num_values * sizeof(u64)));
+    packet.SendReply();
+}
+
+void RPCServer::HandleReadMetricName(Packet& packet, u32 index, u32 offset) {
+    const Common::Metrics::Snapshot snapshot = Common::Metrics::GetSnapshot();
+    u32 name_size = 0;
+    if (index < snapshot.names.size()) {
+        // Names longer than a packet are read in several requests, a reply shorter than a full
+        // packet ends the name
+        const std::string& name = snapshot.names[index];
+        if (offset < name.size()) {
+            name_size =
+                static_cast<u32>(std::min<std::size_t>(name.size() - offset, MAX_PACKET_DATA_SIZE));
+            std::memcpy(packet.GetPacketData().data(), name.data() + offset, name_size);
+        }
+    }
+    packet.SetPacketDataSize(name_size);
+    packet.SendReply();
+}
+
 bool RPCServer::ValidatePacket(const PacketHeader& packet_header) {
     if (packet_header.version <= CURRENT_VERSION) {
         switch (packet_header.packet_type) {
@@ -61,6 +100,12 @@ bool RPCServer::ValidatePacket(const PacketHeader& packet_header) {
                 return true;
             }
             break;
+        case PacketType::ReadMetrics:
+        case PacketType::ReadMetricName:
+            if (packet_header.packet_size >= sizeof(u32)) {
+                return true;
+            }
+            break;
         default:
             break;
         }
@@ -72,12 +117,15 @@ void RPCServer::HandleSingleRequest(std::unique_ptr<Packet> request_packet) {
     bool success = false;
 
     if (ValidatePacket(request_packet->GetHeader())) {
-        // Currently, all request types use the address/data_size wire format
+        // Memory requests use the address/data_size wire format, metrics requests carry a
+        // counter index in place of the address and an optional name offset in place of the size
         u32 address = 0;
         u32 data_size = 0;
         std::memcpy(&address, request_packet->GetPacketData().data(), sizeof(address));
-        std::memcpy(&data_size, request_packet->GetPacketData().data() + sizeof(address),
-                    sizeof(data_size));
+        if (request_packet->GetPacketDataSize() >= sizeof(u32) * 2) {
+            std::memcpy(&data_size, request_packet->GetPacketData().data() + sizeof(address),
+                        sizeof(data_size));
+        }
 
         switch (request_packet->GetPacketType()) {
         case PacketType::ReadMemory:
@@ -93,6 +141,14 @@ void RPCServer::HandleSingleRequest(std::unique_ptr<Packet> request_packet) {
                 success = true;
             }
             break;
+        case PacketType::ReadMetrics:
+            HandleReadMetrics(*request_packet, address);
+            success = true;
+            break;
+        case PacketType::ReadMetricName:
+            HandleReadMetricName(*request_packet, address, data_size);
+            success = true;
+            break;
         default:
             break;
         }
@@ -28,6 +28,8 @@ private:
     void Stop();
     void HandleReadMemory(Packet& packet, u32 address, u32 data_size);
     void HandleWriteMemory(Packet& packet, u32 address, const u8* data, u32 data_size);
+    void HandleReadMetrics(Packet& packet, u32 first_index);
+    void HandleReadMetricName(Packet& packet, u32 index, u32 offset);
     bool ValidatePacket(const PacketHeader& packet_header);
     void HandleSingleRequest(std::unique_ptr<Packet> request);
     void HandleRequestsLoop();
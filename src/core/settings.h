@@ -126,6 +126,10 @@ struct Values {
 
     // Core
     bool use_cpu_jit;
+    bool use_idle_loop_skip;
+    /// Comma separated list of the hexadecimal ids of titles that must not skip idle loops
+    std::string idle_loop_skip_disabled_titles;
+    bool use_boot_cache;
 
     // Data Storage
     bool use_virtual_sd;
@@ -142,6 +146,8 @@ struct Values {
     bool shaders_accurate_gs;
     bool shaders_accurate_mul;
     bool use_shader_jit;
+    bool use_gpu_thread;
+    bool use_disk_shader_cache;
     u16 resolution_factor;
     bool vsync_enabled;
     bool use_frame_limit;
@@ -0,0 +1,44 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+#include "common/host_memory.h"
+
+namespace Common {
+
+TEST_CASE("HostMemory::CreateImage", "[common]") {
+    constexpr std::size_t size = 0x10000;
+    HostMemory memory(size);
+    REQUIRE(memory.size() == size);
+    REQUIRE(memory.data()[0] == 0);
+    REQUIRE(memory.data()[size - 1] == 0);
+
+    memory.data()[0] = 1;
+    u8* const pointer = memory.data();
+    const auto image = memory.CreateImage();
+    REQUIRE(image->size() == size);
+    // Capturing must not move the memory, as emulated page tables point into it
+    REQUIRE(memory.data() == pointer);
+    REQUIRE(memory.data()[0] == 1);
+
+    // Writes after the capture do not leak into copies made from the image
+    memory.data()[0] = 2;
+    HostMemory copy(image);
+    REQUIRE(copy.size() == size);
+    REQUIRE(copy.data()[0] == 1);
+
+    copy.data()[size - 1] = 3;
+    REQUIRE(memory.data()[size - 1] == 0);
+    REQUIRE(HostMemory(image).data()[size - 1] == 0);
+
+    // Capturing a copy again keeps both the old and the new contents intact
+    const auto second_image = copy.CreateImage();
+    copy.data()[0] = 4;
+    REQUIRE(HostMemory(second_image).data()[0] == 1);
+    REQUIRE(HostMemory(second_image).data()[size - 1] == 3);
+    REQUIRE(HostMemory(image).data()[size - 1] == 0);
+    REQUIRE(memory.data()[0] == 2);
+}
+
+} // namespace Common
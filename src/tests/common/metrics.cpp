@@ -0,0 +1,62 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <string>
+#include <thread>
+#include <catch2/catch.hpp>
+#include "common/metrics.h"
+
+namespace Common::Metrics {
+
+TEST_CASE("Metrics::Snapshot", "[common]") {
+    const CounterId counter = RegisterCounter("tests.counter");
+    const CounterId other_counter = RegisterCounter("tests.other_counter");
+    REQUIRE(counter != other_counter);
+    REQUIRE(RegisterCounter("tests.counter") == counter);
+
+    TakeSnapshot();
+    const Snapshot before = GetSnapshot();
+    REQUIRE(before.names[counter] == "tests.counter");
+
+    Increment(counter);
+    Increment(other_counter, 5);
+    // Counts of exited threads must not be lost
+    std::thread([&] {
+        Increment(counter, 10);
+        Increment(other_counter);
+    }).join();
+
+    // Nothing is visible until the next snapshot
+    REQUIRE(GetSnapshot().values == before.values);
+
+    TakeSnapshot();
+    const Snapshot after = GetSnapshot();
+    REQUIRE(after.sequence == before.sequence + 1);
+    REQUIRE(after.values[counter] - before.values[counter] == 11);
+    REQUIRE(after.values[other_counter] - before.values[other_counter] == 6);
+    REQUIRE(after.frame_values[counter] == 11);
+    REQUIRE(after.frame_values[other_counter] == 6);
+
+    TakeSnapshot();
+    REQUIRE(GetSnapshot().frame_values[counter] == 0);
+}
+
+TEST_CASE("Metrics::RegisterCounter[LongNames]", "[common]") {
+    // Both names are longer than an RPC packet and share the first 32 bytes
+    const std::string name = "tests.a_counter_with_a_long_name.first";
+    const std::string other_name = "tests.a_counter_with_a_long_name.second";
+    REQUIRE(name.compare(0, 32, other_name, 0, 32) == 0);
+
+    const CounterId counter = RegisterCounter(name);
+    const CounterId other_counter = RegisterCounter(other_name);
+    REQUIRE(counter != other_counter);
+    REQUIRE(RegisterCounter(other_name) == other_counter);
+
+    TakeSnapshot();
+    const Snapshot snapshot = GetSnapshot();
+    REQUIRE(snapshot.names[counter] == name);
+    REQUIRE(snapshot.names[other_counter] == other_name);
+}
+
+} // namespace Common::Metrics
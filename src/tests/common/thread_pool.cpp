@@ -0,0 +1,113 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <atomic>
+#include <functional>
+#include <future>
+#include <thread>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "common/thread_pool.h"
+
+namespace Common {
+
+TEST_CASE("ThreadPool::ParallelFor", "[common]") {
+    for (std::size_t num_workers : {0, 1, 3}) {
+        ThreadPool pool(num_workers);
+        REQUIRE(pool.NumWorkers() == num_workers);
+
+        // Run several jobs back to back to make sure the pool can be reused
+        for (std::size_t count : {0, 1, 7, 1000}) {
+            std::vector<std::atomic<int>> calls(count);
+            pool.ParallelFor(count, [&](std::size_t i) { ++calls[i]; });
+            for (std::size_t i = 0; i < count; ++i) {
+                REQUIRE(calls[i] == 1);
+            }
+        }
+    }
+}
+
+TEST_CASE("ThreadPool::ParallelFor[ConcurrentSubmitters]", "[common]") {
+    ThreadPool pool(3);
+    constexpr std::size_t count = 1000;
+    std::vector<std::atomic<int>> calls_a(count);
+    std::vector<std::atomic<int>> calls_b(count);
+
+    // Both threads keep submitting jobs, which the pool has to process one after another
+    const auto Submit = [&pool](std::vector<std::atomic<int>>& calls) {
+        for (int job = 0; job < 50; ++job) {
+            pool.ParallelFor(count, [&calls](std::size_t i) { ++calls[i]; });
+        }
+    };
+    std::thread other_thread(Submit, std::ref(calls_b));
+    Submit(calls_a);
+    other_thread.join();
+
+    for (std::size_t i = 0; i < count; ++i) {
+        REQUIRE(calls_a[i] == 50);
+        REQUIRE(calls_b[i] == 50);
+    }
+}
+
+TEST_CASE("ThreadPool::ParallelFor[BusyWorkers]", "[common]") {
+    ThreadPool pool(1);
+
+    // The only worker is stuck in a task until the job is done, so the job must not wait for it
+    std::promise<void> job_done;
+    std::future<void> task = pool.Submit([done = job_done.get_future()]() { done.wait(); });
+
+    std::vector<std::atomic<int>> calls(100);
+    pool.ParallelFor(calls.size(), [&](std::size_t i) { ++calls[i]; });
+    job_done.set_value();
+    task.get();
+
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        REQUIRE(calls[i] == 1);
+    }
+
+    // The worker takes part in jobs again once it is free
+    pool.ParallelFor(calls.size(), [&](std::size_t i) { ++calls[i]; });
+    for (std::size_t i = 0; i < calls.size(); ++i) {
+        REQUIRE(calls[i] == 2);
+    }
+}
+
+TEST_CASE("ThreadPool::Submit", "[common]") {
+    for (std::size_t num_workers : {0, 1, 3}) {
+        ThreadPool pool(num_workers);
+
+        std::vector<std::future<std::size_t>> results;
+        for (std::size_t i = 0; i < 100; ++i) {
+            results.push_back(pool.Submit([i] { return i * i; }));
+        }
+
+        // Jobs can run while tasks are queued
+        std::vector<std::atomic<int>> calls(100);
+        pool.ParallelFor(calls.size(), [&](std::size_t i) { ++calls[i]; });
+
+        for (std::size_t i = 0; i < results.size(); ++i) {
+            REQUIRE(results[i].get() == i * i);
+            REQUIRE(calls[i] == 1);
+        }
+    }
+}
+
+TEST_CASE("ThreadPool::Submit[Shutdown]", "[common]") {
+    std::atomic<int> calls{0};
+    std::vector<std::future<void>> results;
+    {
+        ThreadPool pool(2);
+        for (int i = 0; i < 50; ++i) {
+            results.push_back(pool.Submit([&calls] { ++calls; }));
+        }
+    }
+
+    // Tasks still queued when the pool is destroyed are run rather than dropped
+    REQUIRE(calls == 50);
+    for (auto& result : results) {
+        REQUIRE_NOTHROW(result.get());
+    }
+}
+
+} // namespace Common
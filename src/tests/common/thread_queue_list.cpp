@@ -0,0 +1,52 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <catch2/catch.hpp>
+#include "common/thread_queue_list.h"
+
+namespace Common {
+
+TEST_CASE("ThreadQueueList", "[common]") {
+    ThreadQueueList<int, 64> queue;
+    REQUIRE(queue.get_first() == 0);
+
+    queue.push_back(40, 1);
+    queue.push_back(10, 2);
+    queue.push_back(63, 3);
+    queue.push_back(10, 4);
+    queue.push_front(10, 5);
+
+    SECTION("pops in priority order, then in queue order") {
+        CHECK(queue.get_first() == 5);
+        CHECK(queue.pop_first() == 5);
+        CHECK(queue.pop_first() == 2);
+        CHECK(queue.pop_first() == 4);
+        CHECK(queue.empty(10));
+        CHECK(queue.pop_first() == 1);
+        CHECK(queue.pop_first() == 3);
+        CHECK(queue.pop_first() == 0);
+    }
+
+    SECTION("only pops threads of a better priority") {
+        CHECK(queue.pop_first_better(10) == 0);
+        CHECK(queue.pop_first_better(63) == 5);
+        queue.remove(10, 2);
+        queue.remove(10, 4);
+        CHECK(queue.pop_first_better(40) == 0);
+        CHECK(queue.pop_first_better(41) == 1);
+        CHECK(queue.get_first() == 3);
+    }
+
+    SECTION("moves threads between priorities") {
+        queue.move(3, 63, 0);
+        CHECK(queue.pop_first() == 3);
+        CHECK(queue.contains(1) == 40);
+        queue.rotate(10);
+        CHECK(queue.pop_first() == 2);
+        queue.clear();
+        CHECK(queue.get_first() == 0);
+    }
+}
+
+} // namespace Common
@@ -0,0 +1,107 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstring>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "core/arm/dyncom/arm_dyncom.h"
+#include "core/arm/idle_loop_detector.h"
+#include "core/memory.h"
+#include "tests/core/arm/arm_test_common.h"
+
+namespace ArmTests {
+
+TEST_CASE("IdleLoopDetector", "[core][arm]") {
+    constexpr VAddr CODE_ADDRESS = 0x10000000;
+    constexpr VAddr DATA_ADDRESS = CODE_ADDRESS + 0x800;
+
+    TestEnvironment test_env(false);
+    Memory::MemorySystem& memory = test_env.GetMemory();
+    std::vector<u8> ram(Memory::PAGE_SIZE);
+    memory.MapMemoryRegion(*memory.GetCurrentPageTable(), CODE_ADDRESS, Memory::PAGE_SIZE,
+                           ram.data());
+
+    const auto write_code = [&](std::initializer_list<u32> code) {
+        std::memcpy(ram.data(), code.begin(), code.size() * sizeof(u32));
+    };
+    const auto write_data = [&](u32 value) {
+        std::memcpy(ram.data() + (DATA_ADDRESS - CODE_ADDRESS), &value, sizeof(value));
+    };
+
+    ARM_DynCom dyncom(nullptr, memory, USER32MODE);
+    dyncom.SetPC(CODE_ADDRESS);
+    dyncom.SetReg(1, DATA_ADDRESS);
+    Core::IdleLoopDetector detector(memory);
+
+    SECTION("polling loop") {
+        write_code({
+            0xE5910000, // ldr r0, [r1]
+            0xE3500000, // cmp r0, #0
+            0x0AFFFFFC, // beq loop
+        });
+
+        write_data(0);
+        CHECK(detector.IsIdle(dyncom));
+
+        // The loop would exit on its next iteration
+        write_data(1);
+        CHECK(!detector.IsIdle(dyncom));
+
+        // Only the start of the loop is recognized
+        write_data(0);
+        dyncom.SetPC(CODE_ADDRESS + 4);
+        CHECK(!detector.IsIdle(dyncom));
+    }
+
+    SECTION("halfword flag test") {
+        write_code({
+            0xE1D100B2, // ldrh r0, [r1, #2]
+            0xE3100001, // tst r0, #1
+            0x1AFFFFFC, // bne loop
+        });
+
+        write_data(0x00010000);
+        CHECK(detector.IsIdle(dyncom));
+        write_data(0x00020000);
+        CHECK(!detector.IsIdle(dyncom));
+    }
+
+    SECTION("loops with side effects") {
+        write_code({
+            0xE5810000, // str r0, [r1]
+            0xEAFFFFFD, // b loop
+        });
+        CHECK(!detector.IsIdle(dyncom));
+    }
+
+    SECTION("memory mapped I/O") {
+        // The test environment maps everything outside of the RAM page as I/O
+        constexpr VAddr IO_ADDRESS = CODE_ADDRESS + Memory::PAGE_SIZE;
+        REQUIRE(memory.GetCurrentPageTable()->attributes[IO_ADDRESS >> Memory::PAGE_BITS] ==
+                Memory::PageType::Special);
+
+        write_code({
+            0xE5910000, // ldr r0, [r1]
+            0xE3500000, // cmp r0, #0
+            0x0AFFFFFC, // beq loop
+        });
+        dyncom.SetReg(1, IO_ADDRESS);
+        CHECK(!detector.IsIdle(dyncom));
+    }
+
+    SECTION("unmapped memory") {
+        constexpr VAddr UNMAPPED_ADDRESS = CODE_ADDRESS + Memory::PAGE_SIZE;
+        memory.UnmapRegion(*memory.GetCurrentPageTable(), UNMAPPED_ADDRESS, Memory::PAGE_SIZE);
+
+        write_code({
+            0xE5910000, // ldr r0, [r1]
+            0xE3500000, // cmp r0, #0
+            0x0AFFFFFC, // beq loop
+        });
+        dyncom.SetReg(1, UNMAPPED_ADDRESS);
+        CHECK(!detector.IsIdle(dyncom));
+    }
+}
+
+} // namespace ArmTests
@@ -0,0 +1,46 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <thread>
+#include <catch2/catch.hpp>
+#include "core/core.h"
+#include "core/hw/gpu.h"
+#include "core/hw/lcd.h"
+#include "video_core/pica_state.h"
+#include "video_core/video_core.h"
+
+namespace Core {
+
+TEST_CASE("System::MakeCurrent", "[core]") {
+    System& default_system = System::GetInstance();
+    System other_system;
+
+    System* bound_system = nullptr;
+    Pica::State* bound_pica_state = nullptr;
+    GPU::Regs* bound_gpu_regs = nullptr;
+    LCD::Regs* bound_lcd_regs = nullptr;
+    std::thread thread([&] {
+        other_system.MakeCurrent();
+        bound_system = &System::GetInstance();
+        bound_pica_state = &Pica::GetState();
+        bound_gpu_regs = &GPU::GetRegs();
+        bound_lcd_regs = &LCD::GetRegs();
+    });
+    thread.join();
+
+    // The other thread sees the state of the console bound to it
+    REQUIRE(bound_system == &other_system);
+    REQUIRE(bound_pica_state == other_system.VideoContext().pica_state.get());
+    REQUIRE(bound_gpu_regs == &other_system.GPUContext().regs);
+    REQUIRE(bound_lcd_regs == &other_system.LCDRegs());
+
+    // While this thread still uses the default instance
+    REQUIRE(&System::GetInstance() == &default_system);
+    REQUIRE(&Pica::GetState() == default_system.VideoContext().pica_state.get());
+    REQUIRE(&Pica::GetState() != bound_pica_state);
+    REQUIRE(&GPU::GetRegs() != bound_gpu_regs);
+    REQUIRE(&LCD::GetRegs() != bound_lcd_regs);
+}
+
+} // namespace Core
@@ -6,6 +6,7 @@
 
 #include <array>
 #include <bitset>
+#include <chrono>
 #include <string>
 #include "common/file_util.h"
 #include "core/core.h"
@@ -226,3 +227,55 @@ TEST_CASE("CoreTiming[ChainScheduling]", "[core]") {
     REQUIRE(0 == reschedules);
     REQUIRE(MAX_SLICE_LENGTH == timing.GetDowncount());
 }
+
+TEST_CASE("CoreTiming[UnscheduleOrder]", "[core]") {
+    Core::Timing timing;
+
+    Core::TimingEventType* cb_a = timing.RegisterEvent("callbackA", CallbackTemplate<0>);
+    Core::TimingEventType* cb_b = timing.RegisterEvent("callbackB", CallbackTemplate<1>);
+    Core::TimingEventType* cb_c = timing.RegisterEvent("callbackC", CallbackTemplate<2>);
+
+    // Enter slice 0
+    timing.Advance();
+
+    // Cancelling events from the middle of the queue must keep the order of the others
+    timing.ScheduleEvent(300, cb_a, CB_IDS[0]);
+    timing.ScheduleEvent(100, cb_b, CB_IDS[1]);
+    timing.ScheduleEvent(200, cb_c, CB_IDS[2]);
+    timing.ScheduleEvent(150, cb_a, CB_IDS[3]);
+    timing.ScheduleEvent(250, cb_a, CB_IDS[3]);
+    timing.UnscheduleEvent(cb_a, CB_IDS[3]);
+    timing.UnscheduleEvent(cb_c, CB_IDS[0]); // Not scheduled
+    REQUIRE(100 == timing.GetDowncount());
+
+    AdvanceAndCheck(timing, 1, 100);
+    AdvanceAndCheck(timing, 2, 100);
+    AdvanceAndCheck(timing, 0, MAX_SLICE_LENGTH);
+}
+
+// Not run by default, use the [benchmark] tag to run it
+TEST_CASE("CoreTiming[RescheduleBenchmark]", "[core][.][benchmark]") {
+    constexpr int iterations = 200000;
+
+    for (u64 num_events : {8, 32, 128, 512}) {
+        Core::Timing timing;
+        Core::TimingEventType* type = timing.RegisterEvent("wakeup", [](u64, s64) {});
+        timing.Advance();
+        for (u64 i = 0; i < num_events; ++i) {
+            timing.ScheduleEvent(1000000 + i, type, i);
+        }
+
+        // Mimics threads cancelling and rearming their wakeup events
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            const u64 id = (i * 7919) % num_events;
+            timing.UnscheduleEvent(type, id);
+            timing.ScheduleEvent(1000000 + i % 1000, type, id);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const double ns_per_iteration =
+            std::chrono::duration<double, std::nano>(end - start).count() / iterations;
+        WARN(num_events << " events: " << ns_per_iteration << " ns per unschedule + schedule");
+    }
+}
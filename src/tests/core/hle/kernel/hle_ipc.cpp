@@ -2,10 +2,12 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <chrono>
 #include <catch2/catch.hpp>
 #include "core/core.h"
 #include "core/core_timing.h"
 #include "core/hle/ipc.h"
+#include "core/hle/ipc_helpers.h"
 #include "core/hle/kernel/client_port.h"
 #include "core/hle/kernel/client_session.h"
 #include "core/hle/kernel/event.h"
@@ -13,6 +15,7 @@
 #include "core/hle/kernel/hle_ipc.h"
 #include "core/hle/kernel/process.h"
 #include "core/hle/kernel/server_session.h"
+#include "core/hle/service/service.h"
 
 namespace Kernel {
 
@@ -176,6 +179,7 @@ TEST_CASE("HLERequestContext::PopulateFromIncomingCommandBuffer", "[core][kernel
         context.GetMappedBuffer(0).Read(other_buffer.data(), 0, buffer->size());
 
         CHECK(other_buffer == *buffer);
+        CHECK(context.GetMappedBuffer(0).GetReadPointer() == buffer->data());
 
         REQUIRE(process->vm_manager.UnmapRange(target_address, buffer->size()) == RESULT_SUCCESS);
     }
@@ -373,4 +377,120 @@ TEST_CASE("HLERequestContext::WriteToOutgoingCommandBuffer", "[core][kernel]") {
     }
 }
 
+TEST_CASE("HLERequestContext::Reset", "[core][kernel]") {
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    auto [server, client] = kernel.CreateSessionPair();
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+
+    auto a = MakeObject(kernel);
+    const u32_le input[]{
+        IPC::MakeHeader(0, 0, 2),
+        IPC::CopyHandleDesc(1),
+        process->handle_table.Create(a).Unwrap(),
+    };
+    const long use_count = a.use_count();
+
+    auto context = kernel.AcquireRequestContext(server, nullptr);
+    context->PopulateFromIncomingCommandBuffer(input, *process);
+    HLERequestContext* const first_context = context.get();
+    kernel.ReleaseRequestContext(std::move(context));
+
+    // The pool must not keep the objects of finished requests alive
+    CHECK(a.use_count() == use_count);
+
+    context = kernel.AcquireRequestContext(server, nullptr);
+    CHECK(context.get() == first_context);
+    CHECK(context->Session() == server);
+    CHECK(context->CommandBuffer()[0] == 0);
+    CHECK(context->AddOutgoingHandle(a) == 0);
+}
+
+namespace {
+
+class EchoService : public Service::ServiceFramework<EchoService> {
+public:
+    EchoService() : ServiceFramework("echo") {
+        static const FunctionInfo functions[] = {
+            {0x00010082, &EchoService::Echo, "Echo"},
+        };
+        RegisterHandlers(functions);
+    }
+
+private:
+    void Echo(HLERequestContext& ctx) {
+        IPC::RequestParser rp(ctx, 0x0001, 2, 2);
+        const u32 a = rp.Pop<u32>();
+        const u32 b = rp.Pop<u32>();
+        const std::vector<u8>& data = rp.PopStaticBuffer();
+
+        IPC::RequestBuilder rb = rp.MakeBuilder(3, 0);
+        rb.Push(RESULT_SUCCESS);
+        rb.Push(a + b);
+        rb.Push(static_cast<u32>(data.size()));
+    }
+};
+
+} // Anonymous namespace
+
+// Not run by default, use the [benchmark] tag to run it
+TEST_CASE("HLERequestContext[RoundTripBenchmark]", "[core][kernel][.][benchmark]") {
+    constexpr int iterations = 200000;
+
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    // Structured bindings can't be captured by the lambdas below
+    const auto session_pair = kernel.CreateSessionPair();
+    const auto& server = session_pair.first;
+    auto process = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    auto service = std::make_shared<EchoService>();
+
+    auto buffer = std::make_shared<std::vector<u8>>(Memory::PAGE_SIZE);
+    const VAddr target_address = 0x10000000;
+    auto result = process->vm_manager.MapBackingMemory(target_address, buffer->data(),
+                                                       buffer->size(), MemoryState::Private);
+    REQUIRE(result.Code() == RESULT_SUCCESS);
+
+    const u32_le input[]{
+        IPC::MakeHeader(0x0001, 2, 2),
+        1,
+        2,
+        IPC::StaticBufferDesc(0x100, 0),
+        target_address,
+    };
+    std::array<u32_le, IPC::COMMAND_BUFFER_LENGTH + 2 * IPC::MAX_STATIC_BUFFERS> output{};
+
+    const auto measure = [&](const char* name, auto&& round_trip) {
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            round_trip();
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        CHECK(output[2] == 3);
+        const double seconds = std::chrono::duration<double>(end - start).count();
+        WARN(name << ": " << iterations / seconds << " round-trips per second");
+    };
+
+    // Builds a new context for every request, like the kernel used to
+    measure("new context", [&] {
+        HLERequestContext context(kernel, server, nullptr);
+        context.PopulateFromIncomingCommandBuffer(input, *process);
+        service->HandleSyncRequest(context);
+        context.WriteToOutgoingCommandBuffer(output.data(), *process);
+    });
+
+    measure("pooled context", [&] {
+        auto context = kernel.AcquireRequestContext(server, nullptr);
+        context->PopulateFromIncomingCommandBuffer(input, *process);
+        service->HandleSyncRequest(*context);
+        context->WriteToOutgoingCommandBuffer(output.data(), *process);
+        kernel.ReleaseRequestContext(std::move(context));
+    });
+
+    REQUIRE(process->vm_manager.UnmapRange(target_address, buffer->size()) == RESULT_SUCCESS);
+}
+
 } // namespace Kernel
@@ -0,0 +1,184 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <vector>
+#include <catch2/catch.hpp>
+#include <fmt/format.h>
+#include "common/common_paths.h"
+#include "common/file_util.h"
+#include "core/file_sys/ncch_container.h"
+#include "core/loader/boot_cache.h"
+#include "core/loader/loader.h"
+#include "core/loader/ncch.h"
+#include "core/settings.h"
+
+namespace Loader {
+
+namespace {
+
+// Program ids that no real title uses, so the tests never touch the entry of an installed game
+constexpr u64 TEST_PROGRAM_ID = 0x0004000000B0C000;
+constexpr u64 TEST_NCCH_PROGRAM_ID = 0x0004000000B0C100;
+
+std::string GetEntryPath(u64 program_id) {
+    return fmt::format("{}{}" DIR_SEP "{:016X}.bin",
+                       FileUtil::GetUserPath(FileUtil::UserPath::CacheDir), BOOT_CACHE_DIR,
+                       program_id);
+}
+
+std::vector<u8> MakeCode(u8 seed) {
+    std::vector<u8> code(0x1000);
+    for (std::size_t i = 0; i < code.size(); ++i) {
+        code[i] = static_cast<u8>(i * 7 + seed);
+    }
+    return code;
+}
+
+/// Writes an unencrypted NCCH whose ExeFS only holds an uncompressed .code section
+void WriteNCCH(const std::string& path, u64 program_id, const std::vector<u8>& code) {
+    constexpr u32 BLOCK_SIZE = 0x200;
+
+    NCCH_Header ncch_header;
+    ExHeader_Header exheader_header;
+    ExeFs_Header exefs_header;
+    std::memset(&ncch_header, 0, sizeof(ncch_header));
+    std::memset(&exheader_header, 0, sizeof(exheader_header));
+    std::memset(&exefs_header, 0, sizeof(exefs_header));
+
+    ncch_header.magic = MakeMagic('N', 'C', 'C', 'H');
+    ncch_header.program_id = program_id;
+    ncch_header.extended_header_size = 0x400;
+    ncch_header.no_crypto.Assign(1);
+    ncch_header.exefs_offset = (sizeof(ncch_header) + sizeof(exheader_header)) / BLOCK_SIZE;
+    ncch_header.exefs_size =
+        static_cast<u32>((sizeof(exefs_header) + code.size() + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+    exheader_header.codeset_info.text.code_size = static_cast<u32>(code.size());
+
+    std::strcpy(exefs_header.section[0].name, ".code");
+    exefs_header.section[0].size = static_cast<u32>(code.size());
+
+    FileUtil::IOFile file(path, "wb");
+    REQUIRE(file.WriteObject(ncch_header) == 1);
+    REQUIRE(file.WriteObject(exheader_header) == 1);
+    REQUIRE(file.WriteObject(exefs_header) == 1);
+    REQUIRE(file.WriteBytes(code.data(), code.size()) == code.size());
+}
+
+} // Anonymous namespace
+
+TEST_CASE("BootCache::Load", "[core][loader]") {
+    const std::string entry_path = GetEntryPath(TEST_PROGRAM_ID);
+    FileUtil::Delete(entry_path);
+
+    const std::vector<u8> code = MakeCode(1);
+    constexpr u64 content_hash = 0x0123456789ABCDEF;
+    std::vector<u8> loaded;
+
+    SECTION("missing entry") {
+        REQUIRE(!BootCache::Load(TEST_PROGRAM_ID, content_hash, loaded));
+    }
+
+    SECTION("stored entry is hit") {
+        BootCache::Store(TEST_PROGRAM_ID, content_hash, code);
+        REQUIRE(BootCache::Load(TEST_PROGRAM_ID, content_hash, loaded));
+        REQUIRE(loaded == code);
+
+        // Storing again replaces the entry
+        const std::vector<u8> new_code = MakeCode(2);
+        BootCache::Store(TEST_PROGRAM_ID, content_hash, new_code);
+        REQUIRE(BootCache::Load(TEST_PROGRAM_ID, content_hash, loaded));
+        REQUIRE(loaded == new_code);
+    }
+
+    SECTION("content hash mismatch") {
+        BootCache::Store(TEST_PROGRAM_ID, content_hash, code);
+        REQUIRE(!BootCache::Load(TEST_PROGRAM_ID, content_hash + 1, loaded));
+    }
+
+    SECTION("size mismatch") {
+        BootCache::Store(TEST_PROGRAM_ID, content_hash, code);
+        {
+            FileUtil::IOFile file(entry_path, "ab");
+            const u8 extra = 0;
+            REQUIRE(file.WriteBytes(&extra, 1) == 1);
+        }
+        REQUIRE(!BootCache::Load(TEST_PROGRAM_ID, content_hash, loaded));
+    }
+
+    SECTION("corrupted code") {
+        BootCache::Store(TEST_PROGRAM_ID, content_hash, code);
+        {
+            FileUtil::IOFile file(entry_path, "r+b");
+            const u8 flipped = static_cast<u8>(~code.back());
+            REQUIRE(file.Seek(-1, SEEK_END));
+            REQUIRE(file.WriteBytes(&flipped, 1) == 1);
+        }
+        REQUIRE(!BootCache::Load(TEST_PROGRAM_ID, content_hash, loaded));
+        REQUIRE(loaded.empty());
+    }
+
+    FileUtil::Delete(entry_path);
+}
+
+TEST_CASE("BootCache::Load[NCCH]", "[core][loader]") {
+    const std::string test_dir = "./boot_cache_test";
+    const std::string ncch_path = test_dir + "/title.cxi";
+    const std::string entry_path = GetEntryPath(TEST_NCCH_PROGRAM_ID);
+    const bool use_boot_cache = Settings::values.use_boot_cache;
+
+    FileUtil::CreateDir(test_dir);
+    FileUtil::Delete(entry_path);
+    Settings::values.use_boot_cache = true;
+
+    const std::vector<u8> code = MakeCode(3);
+    WriteNCCH(ncch_path, TEST_NCCH_PROGRAM_ID, code);
+
+    std::vector<u8> loaded;
+
+    SECTION("code is stored and read back") {
+        AppLoader_NCCH loader(FileUtil::IOFile(ncch_path, "rb"), ncch_path);
+        REQUIRE(loader.ReadCode(loaded) == ResultStatus::Success);
+        REQUIRE(loaded == code);
+        REQUIRE(FileUtil::Exists(entry_path));
+
+        // Replace the cached code to tell a cache hit apart from reading the NCCH again
+        FileSys::NCCHContainer ncch(ncch_path);
+        REQUIRE(ncch.Load() == ResultStatus::Success);
+        const std::vector<u8> cached_code = MakeCode(4);
+        BootCache::Store(TEST_NCCH_PROGRAM_ID, BootCache::ComputeContentHash(ncch), cached_code);
+
+        AppLoader_NCCH second_loader(FileUtil::IOFile(ncch_path, "rb"), ncch_path);
+        REQUIRE(second_loader.ReadCode(loaded) == ResultStatus::Success);
+        REQUIRE(loaded == cached_code);
+    }
+
+    SECTION("tainted container bypasses the cache") {
+        FileUtil::CreateDir(ncch_path + ".exefsdir");
+
+        FileSys::NCCHContainer ncch(ncch_path);
+        REQUIRE(ncch.Load() == ResultStatus::Success);
+        REQUIRE(ncch.IsTainted());
+        BootCache::Store(TEST_NCCH_PROGRAM_ID, BootCache::ComputeContentHash(ncch), MakeCode(4));
+
+        AppLoader_NCCH loader(FileUtil::IOFile(ncch_path, "rb"), ncch_path);
+        REQUIRE(loader.ReadCode(loaded) == ResultStatus::Success);
+        REQUIRE(loaded == code);
+
+        // Nothing is written back for a tainted container
+        FileUtil::Delete(entry_path);
+        AppLoader_NCCH second_loader(FileUtil::IOFile(ncch_path, "rb"), ncch_path);
+        REQUIRE(second_loader.ReadCode(loaded) == ResultStatus::Success);
+        REQUIRE(!FileUtil::Exists(entry_path));
+    }
+
+    Settings::values.use_boot_cache = use_boot_cache;
+    FileUtil::Delete(entry_path);
+    FileUtil::DeleteDirRecursively(test_dir);
+}
+
+} // namespace Loader
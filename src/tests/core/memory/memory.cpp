@@ -2,6 +2,8 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <cstring>
+#include <vector>
 #include <catch2/catch.hpp>
 #include "core/core.h"
 #include "core/core_timing.h"
@@ -54,3 +56,75 @@ TEST_CASE("Memory::IsValidVirtualAddress", "[core][memory]") {
         CHECK(Memory::IsValidVirtualAddress(*process, Memory::CONFIG_MEMORY_VADDR) == false);
     }
 }
+
+TEST_CASE("Memory::RasterizerMarkRegionCached", "[core][memory]") {
+    Core::Timing timing;
+    Memory::MemorySystem memory;
+    Kernel::KernelSystem kernel(memory, timing, [] {}, 0);
+    auto process_a = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    auto process_b = kernel.CreateProcess(kernel.CreateCodeSet("", 0));
+    const u32 vram_page = Memory::VRAM_VADDR >> Memory::PAGE_BITS;
+    for (const auto& process : {process_a, process_b}) {
+        kernel.HandleSpecialMapping(process->vm_manager,
+                                    {Memory::VRAM_VADDR, Memory::VRAM_SIZE, false, false});
+    }
+    auto& page_table_a = process_a->vm_manager.page_table;
+    auto& page_table_b = process_b->vm_manager.page_table;
+    kernel.SetCurrentProcess(process_a);
+
+    SECTION("the current page table is updated right away") {
+        memory.RasterizerMarkRegionCached(Memory::VRAM_PADDR, Memory::PAGE_SIZE, true);
+        CHECK(page_table_a.attributes[vram_page] == Memory::PageType::RasterizerCachedMemory);
+        CHECK(page_table_a.pointers[vram_page] == nullptr);
+
+        memory.RasterizerMarkRegionCached(Memory::VRAM_PADDR, Memory::PAGE_SIZE, false);
+        CHECK(page_table_a.attributes[vram_page] == Memory::PageType::Memory);
+        CHECK(page_table_a.pointers[vram_page] != nullptr);
+    }
+
+    SECTION("every page touched by the region is marked") {
+        memory.RasterizerMarkRegionCached(Memory::VRAM_PADDR + Memory::PAGE_SIZE + 0x10,
+                                          Memory::PAGE_SIZE * 2, true);
+        CHECK(page_table_a.attributes[vram_page] == Memory::PageType::Memory);
+        for (u32 page = vram_page + 1; page <= vram_page + 3; ++page) {
+            CHECK(page_table_a.attributes[page] == Memory::PageType::RasterizerCachedMemory);
+            CHECK(page_table_a.pointers[page] == nullptr);
+        }
+        CHECK(page_table_a.attributes[vram_page + 4] == Memory::PageType::Memory);
+
+        memory.RasterizerMarkRegionCached(Memory::VRAM_PADDR, Memory::VRAM_SIZE, false);
+        for (u32 page = vram_page + 1; page <= vram_page + 3; ++page) {
+            CHECK(page_table_a.attributes[page] == Memory::PageType::Memory);
+            CHECK(page_table_a.pointers[page] ==
+                  page_table_a.pointers[vram_page] + (page - vram_page) * Memory::PAGE_SIZE);
+        }
+    }
+
+    SECTION("other page tables catch up when they become current") {
+        memory.RasterizerMarkRegionCached(Memory::VRAM_PADDR, Memory::PAGE_SIZE, true);
+        kernel.SetCurrentProcess(process_b);
+        CHECK(page_table_b.attributes[vram_page] == Memory::PageType::RasterizerCachedMemory);
+        CHECK(page_table_b.attributes[vram_page + 1] == Memory::PageType::Memory);
+
+        memory.RasterizerMarkRegionCached(Memory::VRAM_PADDR, Memory::PAGE_SIZE, false);
+        kernel.SetCurrentProcess(process_a);
+        CHECK(page_table_a.attributes[vram_page] == Memory::PageType::Memory);
+        CHECK(page_table_a.pointers[vram_page] != nullptr);
+    }
+}
+
+TEST_CASE("Memory::MemorySystem::CaptureRam", "[core][memory]") {
+    Memory::MemorySystem memory;
+    u8* const fcram = memory.GetFCRAMPointer(0);
+    fcram[0x1000] = 0xAB;
+
+    const Memory::MemorySystem::RamImage image = memory.CaptureRam();
+    // Page tables point into the RAM, so it must stay in place
+    CHECK(memory.GetFCRAMPointer(0) == fcram);
+    fcram[0x1000] = 0xCD;
+
+    Memory::MemorySystem copy(image);
+    CHECK(copy.GetFCRAMPointer(0x1000)[0] == 0xAB);
+    copy.GetFCRAMPointer(0x2000)[0] = 0xEF;
+    CHECK(fcram[0x2000] == 0);
+}
@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <cmath>
 #include <memory>
+#include <vector>
 #include <catch2/catch.hpp>
 #include <nihstro/inline_assembly.h>
 #include "video_core/shader/shader_jit_x64_compiler.h"
@@ -47,6 +48,22 @@ public:
         return shader_unit.registers.output[0].x.ToFloat32();
     }
 
+    std::vector<float> RunBatch(const std::vector<float>& inputs) {
+        Pica::Shader::ShaderSetup shader_setup;
+        std::vector<Pica::Shader::UnitState> shader_units(inputs.size());
+
+        for (std::size_t i = 0; i < inputs.size(); ++i) {
+            shader_units[i].registers.input[0].x = float24::FromFloat32(inputs[i]);
+        }
+        shader->RunBatch(shader_setup, shader_units.data(), shader_units.size(), 0);
+
+        std::vector<float> outputs;
+        for (const auto& shader_unit : shader_units) {
+            outputs.push_back(shader_unit.registers.output[0].x.ToFloat32());
+        }
+        return outputs;
+    }
+
 public:
     std::unique_ptr<JitShader> shader;
 };
@@ -89,3 +106,24 @@ TEST_CASE("EX2", "[video_core][shader][shader_jit]") {
     REQUIRE(shader.Run(79.7262742773f) == Approx(1.e24f));
     REQUIRE(std::isinf(shader.Run(800.f)));
 }
+
+TEST_CASE("Batched invocations", "[video_core][shader][shader_jit]") {
+    const auto sh_input = SourceRegister::MakeInput(0);
+    const auto sh_output = DestRegister::MakeOutput(0);
+
+    auto shader = ShaderTest({
+        // clang-format off
+        {OpCode::Id::EX2, sh_output, sh_input},
+        {OpCode::Id::END},
+        // clang-format on
+    });
+
+    const std::vector<float> inputs{0.f, 1.f, 2.f, 6.f, -1.f};
+    const auto outputs = shader.RunBatch(inputs);
+
+    REQUIRE(outputs.size() == inputs.size());
+    for (std::size_t i = 0; i < inputs.size(); ++i) {
+        REQUIRE(outputs[i] == Approx(shader.Run(inputs[i])));
+    }
+    REQUIRE(outputs[3] == Approx(64.f));
+}
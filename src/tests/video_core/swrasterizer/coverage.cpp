@@ -0,0 +1,65 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <random>
+#include <catch2/catch.hpp>
+#include "common/x64/cpu_detect.h"
+#include "video_core/swrasterizer/coverage.h"
+
+using namespace Pica::Rasterizer;
+
+static void CheckEquivalence(SpanCoverageFunc func) {
+    std::mt19937 rng(1234);
+    // Rasterizer coordinates are 12.4 fixed point values within the 1024x1024 guard band
+    std::uniform_int_distribution<int> coord(0, 0x3FFF);
+    std::uniform_int_distribution<int> bias(-1, 0);
+
+    for (int iteration = 0; iteration < 10000; ++iteration) {
+        std::array<EdgeFunction, 3> edges;
+        for (auto& edge : edges) {
+            const int x0 = coord(rng);
+            const int y0 = coord(rng);
+            edge = {x0, y0, coord(rng) - x0, coord(rng) - y0, bias(rng)};
+        }
+        const int x = coord(rng) | 8;
+        const int y = coord(rng) | 8;
+
+        SpanCoverage expected;
+        SpanCoverage result;
+        EvaluateSpanCoverage_Scalar(edges, x, y, expected);
+        func(edges, x, y, result);
+
+        REQUIRE(result.mask == expected.mask);
+        REQUIRE(result.w == expected.w);
+
+        // The reference matches the signed area computation of the per-pixel rasterizer
+        for (std::size_t i = 0; i < SPAN_SIZE; ++i) {
+            const int px = x + static_cast<int>(i) * 0x10;
+            bool covered = true;
+            for (std::size_t e = 0; e < 3; ++e) {
+                const auto& edge = edges[e];
+                const int w = edge.bias + edge.dx * (y - edge.y0) - edge.dy * (px - edge.x0);
+                REQUIRE(expected.w[e][i] == w);
+                covered = covered && w >= 0;
+            }
+            REQUIRE(((expected.mask >> i) & 1) == (covered ? 1u : 0u));
+        }
+    }
+}
+
+TEST_CASE("SpanCoverage_SSE41", "[video_core][swrasterizer]") {
+    if (!Common::GetCPUCaps().sse4_1) {
+        WARN("SSE4.1 not supported by host CPU, skipping");
+        return;
+    }
+    CheckEquivalence(EvaluateSpanCoverage_SSE41);
+}
+
+TEST_CASE("SpanCoverage_AVX2", "[video_core][swrasterizer]") {
+    if (!Common::GetCPUCaps().avx2) {
+        WARN("AVX2 not supported by host CPU, skipping");
+        return;
+    }
+    CheckEquivalence(EvaluateSpanCoverage_AVX2);
+}
@@ -0,0 +1,145 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <random>
+#include <vector>
+#include <catch2/catch.hpp>
+#include "video_core/texture/texture_decode.h"
+#ifdef ARCHITECTURE_x86_64
+#include "common/x64/cpu_detect.h"
+#endif
+
+using namespace Pica::Texture;
+using TextureFormat = Pica::TexturingRegs::TextureFormat;
+
+static constexpr std::array<TextureFormat, 14> formats = {
+    TextureFormat::RGBA8, TextureFormat::RGB8,   TextureFormat::RGB5A1, TextureFormat::RGB565,
+    TextureFormat::RGBA4, TextureFormat::IA8,    TextureFormat::RG8,    TextureFormat::I8,
+    TextureFormat::A8,    TextureFormat::IA4,    TextureFormat::I4,     TextureFormat::A4,
+    TextureFormat::ETC1,  TextureFormat::ETC1A4,
+};
+
+static std::vector<u8> RandomBytes(std::mt19937& rng, std::size_t size) {
+    std::uniform_int_distribution<int> byte(0, 255);
+    std::vector<u8> data(size);
+    for (auto& value : data) {
+        value = static_cast<u8>(byte(rng));
+    }
+    return data;
+}
+
+static void CheckEquivalence(TileDecodeFunc func) {
+    std::mt19937 rng(1234);
+    for (TextureFormat format : formats) {
+        TextureInfo info{};
+        info.format = format;
+
+        for (int iteration = 0; iteration < 100; ++iteration) {
+            const std::vector<u8> tile = RandomBytes(rng, CalculateTileSize(format));
+            std::array<u8, 8 * 8 * 4> result;
+            func(format, tile.data(), result.data(), 8 * 4);
+
+            for (unsigned int y = 0; y < 8; ++y) {
+                for (unsigned int x = 0; x < 8; ++x) {
+                    auto expected = LookupTexelInTile(tile.data(), x, y, info, false);
+                    INFO("format " << static_cast<int>(format) << ", texel " << x << ", " << y);
+                    REQUIRE(std::memcmp(&result[(y * 8 + x) * 4], expected.AsArray(), 4) == 0);
+                }
+            }
+        }
+    }
+}
+
+TEST_CASE("DecodeTile_Scalar", "[video_core][texture]") {
+    CheckEquivalence(DecodeTile_Scalar);
+}
+
+#ifdef ARCHITECTURE_x86_64
+TEST_CASE("DecodeTile_SSSE3", "[video_core][texture]") {
+    if (!Common::GetCPUCaps().ssse3) {
+        WARN("SSSE3 not supported by host CPU, skipping");
+        return;
+    }
+    CheckEquivalence(DecodeTile_SSSE3);
+}
+
+TEST_CASE("DecodeTile_AVX2", "[video_core][texture]") {
+    if (!Common::GetCPUCaps().avx2) {
+        WARN("AVX2 not supported by host CPU, skipping");
+        return;
+    }
+    CheckEquivalence(DecodeTile_AVX2);
+}
+#endif
+
+TEST_CASE("DecodeTextureRect", "[video_core][texture]") {
+    std::mt19937 rng(5678);
+    for (TextureFormat format : formats) {
+        TextureInfo info{};
+        info.width = 64;
+        info.height = 32;
+        info.format = format;
+        info.SetDefaultStride();
+        const std::vector<u8> texture = RandomBytes(rng, info.stride * info.height / 8);
+
+        // Rectangles that start and end inside of tiles, written with flipped rows
+        const unsigned int x0 = 3, y0 = 5, x1 = 61, y1 = 30;
+        const std::ptrdiff_t row_size = (x1 - x0) * 4;
+        std::vector<u8> result(row_size * (y1 - y0));
+        DecodeTextureRect(texture.data(), info, x0, y0, x1, y1,
+                          &result[(y1 - y0 - 1) * row_size], -row_size);
+
+        for (unsigned int y = y0; y < y1; ++y) {
+            for (unsigned int x = x0; x < x1; ++x) {
+                auto expected = LookupTexture(texture.data(), x, y, info);
+                const std::size_t offset = (y1 - 1 - y) * row_size + (x - x0) * 4;
+                INFO("format " << static_cast<int>(format) << ", texel " << x << ", " << y);
+                REQUIRE(std::memcmp(&result[offset], expected.AsArray(), 4) == 0);
+            }
+        }
+    }
+}
+
+// Not run by default, use the [benchmark] tag to run it
+TEST_CASE("DecodeTextureRect[Benchmark]", "[video_core][texture][.][benchmark]") {
+    constexpr unsigned int size = 512;
+    constexpr int iterations = 20;
+    std::mt19937 rng(1234);
+    std::vector<u8> result(size * size * 4);
+
+    for (TextureFormat format : formats) {
+        TextureInfo info{};
+        info.width = size;
+        info.height = size;
+        info.format = format;
+        info.SetDefaultStride();
+        const std::vector<u8> texture = RandomBytes(rng, info.stride * info.height / 8);
+
+        const auto start = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            for (unsigned int y = 0; y < size; ++y) {
+                for (unsigned int x = 0; x < size; ++x) {
+                    auto texel = LookupTexture(texture.data(), x, y, info);
+                    std::memcpy(&result[(y * size + x) * 4], texel.AsArray(), 4);
+                }
+            }
+        }
+        const auto middle = std::chrono::steady_clock::now();
+        for (int i = 0; i < iterations; ++i) {
+            DecodeTextureRect(texture.data(), info, 0, 0, size, size, result.data(), size * 4);
+        }
+        const auto end = std::chrono::steady_clock::now();
+
+        const auto ns_per_texel = [](auto duration) {
+            return std::chrono::duration<double, std::nano>(duration).count() /
+                   (iterations * size * size);
+        };
+        WARN("format " << static_cast<int>(format) << ": " << ns_per_texel(middle - start)
+                       << " ns per texel looked up, " << ns_per_texel(end - middle)
+                       << " ns per texel decoded by tile");
+    }
+}
@@ -2,14 +2,20 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <array>
+#include <bitset>
 #include <cstddef>
 #include <memory>
 #include <utility>
+#include <vector>
 #include "common/assert.h"
 #include "common/logging/log.h"
+#include "common/metrics.h"
 #include "common/microprofile.h"
+#include "common/thread_pool.h"
 #include "common/vector_math.h"
+#include "core/core.h"
 #include "core/hle/service/gsp/gsp.h"
 #include "core/hw/gpu.h"
 #include "core/memory.h"
@@ -38,11 +44,115 @@ static const u32 expand_bits_to_bytes[] = {
 
 MICROPROFILE_DEFINE(GPU_Drawing, "GPU", "Drawing", MP_RGB(50, 50, 240));
 
+/// Batches with fewer vertices are shaded on the calling thread, as splitting them up would cost
+/// more than it saves
+constexpr u32 PARALLEL_SHADING_MIN_VERTICES = 1024;
+/// Number of consecutive vertices shaded by each work item of a parallel batch
+constexpr std::size_t PARALLEL_SHADING_CHUNK_SIZE = 256;
+/// Number of vertices a work item hands to the shader engine in a single call
+constexpr std::size_t PARALLEL_SHADING_RUN_SIZE = 16;
+
+/// Vertex ids shaded by the current parallel batch and their shader outputs, in the same order.
+/// These belong to the thread submitting the batch, as each console processes commands on its own.
+static thread_local std::vector<u32> batch_vertices;
+static thread_local std::vector<Shader::AttributeBuffer> batch_outputs;
+/// Maps vertex ids relative to the smallest one of an indexed batch to their batch_vertices slot
+static thread_local std::vector<u32> batch_vertex_slots;
+
+/**
+ * Runs the vertex shader of a non-geometry-shader batch on the worker pool and submits the results
+ * to the geometry pipeline in draw order. Every distinct vertex is shaded exactly once, with each
+ * work item using its own UnitStates for a contiguous range of vertices.
+ */
+static void ProcessBatchParallel(Common::ThreadPool& pool, const VertexLoader& loader,
+                                 u32 base_address, bool is_indexed, const u8* index_address_8,
+                                 bool index_u16) {
+    State& state = GetState();
+    const auto& regs = state.regs;
+    const u32 num_vertices = regs.pipeline.num_vertices;
+    const u16* index_address_16 = reinterpret_cast<const u16*>(index_address_8);
+
+    const auto GetVertex = [&](u32 index) -> u32 {
+        return index_u16 ? index_address_16[index] : index_address_8[index];
+    };
+
+    batch_vertices.clear();
+    u32 min_vertex = 0;
+    if (is_indexed) {
+        // Indices are at most 16 bits wide, so a direct lookup table over the referenced range
+        // is small enough to deduplicate them.
+        min_vertex = GetVertex(0);
+        u32 max_vertex = min_vertex;
+        for (u32 index = 1; index < num_vertices; ++index) {
+            const u32 vertex = GetVertex(index);
+            min_vertex = std::min(min_vertex, vertex);
+            max_vertex = std::max(max_vertex, vertex);
+        }
+
+        batch_vertex_slots.assign(max_vertex - min_vertex + 1, UINT32_MAX);
+        for (u32 index = 0; index < num_vertices; ++index) {
+            const u32 vertex = GetVertex(index);
+            u32& slot = batch_vertex_slots[vertex - min_vertex];
+            if (slot == UINT32_MAX) {
+                slot = static_cast<u32>(batch_vertices.size());
+                batch_vertices.push_back(vertex);
+            }
+        }
+    } else {
+        for (u32 index = 0; index < num_vertices; ++index) {
+            batch_vertices.push_back(index + regs.pipeline.vertex_offset);
+        }
+    }
+
+    batch_outputs.resize(batch_vertices.size());
+
+    // Workers reach the buffers of the submitting thread and the console's state through these
+    const std::vector<u32>& vertices = batch_vertices;
+    std::vector<Shader::AttributeBuffer>& outputs = batch_outputs;
+    Core::System& system = Core::System::GetInstance();
+
+    auto* shader_engine = Shader::GetEngine();
+    const std::size_t num_chunks =
+        (batch_vertices.size() + PARALLEL_SHADING_CHUNK_SIZE - 1) / PARALLEL_SHADING_CHUNK_SIZE;
+    pool.ParallelFor(num_chunks, [&](std::size_t chunk) {
+        system.MakeCurrent();
+        std::array<Shader::UnitState, PARALLEL_SHADING_RUN_SIZE> shader_units;
+        // Memory accesses are only tracked while recording, which takes the serial path
+        DebugUtils::MemoryAccessTracker memory_accesses;
+
+        const std::size_t begin = chunk * PARALLEL_SHADING_CHUNK_SIZE;
+        const std::size_t end = std::min(begin + PARALLEL_SHADING_CHUNK_SIZE, vertices.size());
+        for (std::size_t run_begin = begin; run_begin < end;
+             run_begin += PARALLEL_SHADING_RUN_SIZE) {
+            const std::size_t run_size = std::min(PARALLEL_SHADING_RUN_SIZE, end - run_begin);
+
+            for (std::size_t i = 0; i < run_size; ++i) {
+                const std::size_t slot = run_begin + i;
+                Shader::AttributeBuffer input;
+                loader.LoadVertex(base_address, static_cast<int>(slot), vertices[slot], input,
+                                  memory_accesses);
+                shader_units[i].LoadInput(regs.vs, input);
+            }
+
+            shader_engine->RunBatch(state.vs, shader_units.data(), run_size);
+
+            for (std::size_t i = 0; i < run_size; ++i) {
+                shader_units[i].WriteOutput(regs.vs, outputs[run_begin + i]);
+            }
+        }
+    });
+
+    for (u32 index = 0; index < num_vertices; ++index) {
+        const u32 slot = is_indexed ? batch_vertex_slots[GetVertex(index) - min_vertex] : index;
+        state.geometry_pipeline.SubmitVertex(batch_outputs[slot]);
+    }
+}
+
 static const char* GetShaderSetupTypeName(Shader::ShaderSetup& setup) {
-    if (&setup == &g_state.vs) {
+    if (&setup == &GetState().vs) {
         return "vertex shader";
     }
-    if (&setup == &g_state.gs) {
+    if (&setup == &GetState().gs) {
         return "geometry shader";
     }
     return "unknown shader";
@@ -108,8 +218,64 @@ static void WriteUniformFloatReg(ShaderRegs& config, Shader::ShaderSetup& setup,
     }
 }
 
-static void WritePicaReg(u32 id, u32 value, u32 mask) {
-    auto& regs = g_state.regs;
+/**
+ * Registers whose writes do more than storing a value: triggers, registers that reset a unit, and
+ * the ports that uniforms, shader code, default attributes and LUT entries are written through.
+ */
+static const std::bitset<Regs::NUM_REGS> registers_with_side_effects = [] {
+    std::bitset<Regs::NUM_REGS> result;
+    const auto Mark = [&result](u32 first, u32 last) {
+        for (u32 id = first; id <= last; ++id) {
+            result.set(id);
+        }
+    };
+    const auto MarkOne = [&Mark](u32 id) { Mark(id, id); };
+
+    MarkOne(PICA_REG_INDEX(trigger_irq));
+    Mark(PICA_REG_INDEX_WORKAROUND(texturing.proctex_lut_data[0], 0xb0),
+         PICA_REG_INDEX_WORKAROUND(texturing.proctex_lut_data[7], 0xb7));
+    Mark(PICA_REG_INDEX_WORKAROUND(texturing.fog_lut_data[0], 0xe8),
+         PICA_REG_INDEX_WORKAROUND(texturing.fog_lut_data[7], 0xef));
+    Mark(PICA_REG_INDEX_WORKAROUND(lighting.lut_data[0], 0x1c8),
+         PICA_REG_INDEX_WORKAROUND(lighting.lut_data[7], 0x1cf));
+
+    MarkOne(PICA_REG_INDEX(pipeline.vs_default_attributes_setup.index));
+    Mark(PICA_REG_INDEX_WORKAROUND(pipeline.vs_default_attributes_setup.set_value[0], 0x233),
+         PICA_REG_INDEX_WORKAROUND(pipeline.vs_default_attributes_setup.set_value[2], 0x235));
+    Mark(PICA_REG_INDEX_WORKAROUND(pipeline.command_buffer.trigger[0], 0x23c),
+         PICA_REG_INDEX_WORKAROUND(pipeline.command_buffer.trigger[1], 0x23d));
+    MarkOne(PICA_REG_INDEX(pipeline.trigger_draw));
+    MarkOne(PICA_REG_INDEX(pipeline.trigger_draw_indexed));
+    MarkOne(PICA_REG_INDEX(pipeline.triangle_topology));
+    MarkOne(PICA_REG_INDEX(pipeline.restart_primitive));
+
+    MarkOne(PICA_REG_INDEX(gs.bool_uniforms));
+    Mark(PICA_REG_INDEX_WORKAROUND(gs.int_uniforms[0], 0x281),
+         PICA_REG_INDEX_WORKAROUND(gs.int_uniforms[3], 0x284));
+    Mark(PICA_REG_INDEX_WORKAROUND(gs.uniform_setup.set_value[0], 0x291),
+         PICA_REG_INDEX_WORKAROUND(gs.uniform_setup.set_value[7], 0x298));
+    Mark(PICA_REG_INDEX_WORKAROUND(gs.program.set_word[0], 0x29c),
+         PICA_REG_INDEX_WORKAROUND(gs.program.set_word[7], 0x2a3));
+    Mark(PICA_REG_INDEX_WORKAROUND(gs.swizzle_patterns.set_word[0], 0x2a6),
+         PICA_REG_INDEX_WORKAROUND(gs.swizzle_patterns.set_word[7], 0x2ad));
+
+    MarkOne(PICA_REG_INDEX(vs.bool_uniforms));
+    Mark(PICA_REG_INDEX_WORKAROUND(vs.int_uniforms[0], 0x2b1),
+         PICA_REG_INDEX_WORKAROUND(vs.int_uniforms[3], 0x2b4));
+    Mark(PICA_REG_INDEX_WORKAROUND(vs.uniform_setup.set_value[0], 0x2c1),
+         PICA_REG_INDEX_WORKAROUND(vs.uniform_setup.set_value[7], 0x2c8));
+    Mark(PICA_REG_INDEX_WORKAROUND(vs.program.set_word[0], 0x2cc),
+         PICA_REG_INDEX_WORKAROUND(vs.program.set_word[7], 0x2d3));
+    Mark(PICA_REG_INDEX_WORKAROUND(vs.swizzle_patterns.set_word[0], 0x2d6),
+         PICA_REG_INDEX_WORKAROUND(vs.swizzle_patterns.set_word[7], 0x2dd));
+    return result;
+}();
+
+static const Common::Metrics::CounterId filtered_write_counter =
+    Common::Metrics::RegisterCounter("pica.filtered_register_writes");
+
+static void WritePicaReg(State& state, u32 id, u32 value, u32 mask) {
+    auto& regs = state.regs;
 
     if (id >= Regs::NUM_REGS) {
         LOG_ERROR(
@@ -135,24 +301,33 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
         g_debug_context->OnEvent(DebugContext::Event::PicaCommandLoaded,
                                  reinterpret_cast<void*>(&id));
 
+    // Games rewrite a lot of unchanged state, and the renderer doesn't need to hear about that
+    if (regs.reg_array[id] == old_value && !registers_with_side_effects[id]) {
+        Common::Metrics::Increment(filtered_write_counter);
+        if (g_debug_context)
+            g_debug_context->OnEvent(DebugContext::Event::PicaCommandProcessed,
+                                     reinterpret_cast<void*>(&id));
+        return;
+    }
+
     switch (id) {
     // Trigger IRQ
     case PICA_REG_INDEX(trigger_irq):
-        Service::GSP::SignalInterrupt(Service::GSP::InterruptId::P3D);
+        GPU::SignalInterrupt(Service::GSP::InterruptId::P3D);
         break;
 
     case PICA_REG_INDEX(pipeline.triangle_topology):
-        g_state.primitive_assembler.Reconfigure(regs.pipeline.triangle_topology);
+        state.primitive_assembler.Reconfigure(regs.pipeline.triangle_topology);
         break;
 
     case PICA_REG_INDEX(pipeline.restart_primitive):
-        g_state.primitive_assembler.Reset();
+        state.primitive_assembler.Reset();
         break;
 
     case PICA_REG_INDEX(pipeline.vs_default_attributes_setup.index):
-        g_state.immediate.current_attribute = 0;
-        g_state.immediate.reset_geometry_pipeline = true;
-        g_state.default_attr_counter = 0;
+        state.immediate.current_attribute = 0;
+        state.immediate.reset_geometry_pipeline = true;
+        state.default_attr_counter = 0;
         break;
 
     // Load default vertex input attributes
@@ -161,14 +336,14 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(pipeline.vs_default_attributes_setup.set_value[2], 0x235): {
         // TODO: Does actual hardware indeed keep an intermediate buffer or does
         //       it directly write the values?
-        g_state.default_attr_write_buffer[g_state.default_attr_counter++] = value;
+        state.default_attr_write_buffer[state.default_attr_counter++] = value;
 
         // Default attributes are written in a packed format such that four float24 values are
         // encoded in
         // three 32-bit numbers. We write to internal memory once a full such vector is
         // written.
-        if (g_state.default_attr_counter >= 3) {
-            g_state.default_attr_counter = 0;
+        if (state.default_attr_counter >= 3) {
+            state.default_attr_counter = 0;
 
             auto& setup = regs.pipeline.vs_default_attributes_setup;
 
@@ -180,12 +355,12 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
             Common::Vec4<float24> attribute;
 
             // NOTE: The destination component order indeed is "backwards"
-            attribute.w = float24::FromRaw(g_state.default_attr_write_buffer[0] >> 8);
-            attribute.z = float24::FromRaw(((g_state.default_attr_write_buffer[0] & 0xFF) << 16) |
-                                           ((g_state.default_attr_write_buffer[1] >> 16) & 0xFFFF));
-            attribute.y = float24::FromRaw(((g_state.default_attr_write_buffer[1] & 0xFFFF) << 8) |
-                                           ((g_state.default_attr_write_buffer[2] >> 24) & 0xFF));
-            attribute.x = float24::FromRaw(g_state.default_attr_write_buffer[2] & 0xFFFFFF);
+            attribute.w = float24::FromRaw(state.default_attr_write_buffer[0] >> 8);
+            attribute.z = float24::FromRaw(((state.default_attr_write_buffer[0] & 0xFF) << 16) |
+                                           ((state.default_attr_write_buffer[1] >> 16) & 0xFFFF));
+            attribute.y = float24::FromRaw(((state.default_attr_write_buffer[1] & 0xFFFF) << 8) |
+                                           ((state.default_attr_write_buffer[2] >> 24) & 0xFF));
+            attribute.x = float24::FromRaw(state.default_attr_write_buffer[2] & 0xFFFFFF);
 
             LOG_TRACE(HW_GPU, "Set default VS attribute {:x} to ({} {} {} {})", (int)setup.index,
                       attribute.x.ToFloat32(), attribute.y.ToFloat32(), attribute.z.ToFloat32(),
@@ -193,15 +368,15 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
 
             // TODO: Verify that this actually modifies the register!
             if (setup.index < 15) {
-                g_state.input_default_attributes.attr[setup.index] = attribute;
+                state.input_default_attributes.attr[setup.index] = attribute;
                 setup.index++;
             } else {
                 // Put each attribute into an immediate input buffer.  When all specified immediate
                 // attributes are present, the Vertex Shader is invoked and everything is sent to
                 // the primitive assembler.
 
-                auto& immediate_input = g_state.immediate.input_vertex;
-                auto& immediate_attribute_id = g_state.immediate.current_attribute;
+                auto& immediate_input = state.immediate.input_vertex;
+                auto& immediate_attribute_id = state.immediate.current_attribute;
 
                 immediate_input.attr[immediate_attribute_id] = attribute;
 
@@ -214,7 +389,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
                     Shader::OutputVertex::ValidateSemantics(regs.rasterizer);
 
                     auto* shader_engine = Shader::GetEngine();
-                    shader_engine->SetupBatch(g_state.vs, regs.vs.main_offset);
+                    shader_engine->SetupBatch(state.vs, regs.vs.main_offset);
 
                     // Send to vertex shader
                     if (g_debug_context)
@@ -224,22 +399,22 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
                     Shader::AttributeBuffer output{};
 
                     shader_unit.LoadInput(regs.vs, immediate_input);
-                    shader_engine->Run(g_state.vs, shader_unit);
+                    shader_engine->Run(state.vs, shader_unit);
                     shader_unit.WriteOutput(regs.vs, output);
 
                     // Send to geometry pipeline
-                    if (g_state.immediate.reset_geometry_pipeline) {
-                        g_state.geometry_pipeline.Reconfigure();
-                        g_state.immediate.reset_geometry_pipeline = false;
+                    if (state.immediate.reset_geometry_pipeline) {
+                        state.geometry_pipeline.Reconfigure();
+                        state.immediate.reset_geometry_pipeline = false;
                     }
-                    ASSERT(!g_state.geometry_pipeline.NeedIndexInput());
-                    g_state.geometry_pipeline.Setup(shader_engine);
-                    g_state.geometry_pipeline.SubmitVertex(output);
+                    ASSERT(!state.geometry_pipeline.NeedIndexInput());
+                    state.geometry_pipeline.Setup(shader_engine);
+                    state.geometry_pipeline.SubmitVertex(output);
 
                     // TODO: If drawing after every immediate mode triangle kills performance,
                     // change it to flush triangles whenever a drawing config register changes
                     // See: https://github.com/citra-emu/citra/pull/2866#issuecomment-327011550
-                    VideoCore::g_renderer->Rasterizer()->DrawTriangles();
+                    VideoCore::GetRenderer()->Rasterizer()->DrawTriangles();
                     if (g_debug_context) {
                         g_debug_context->OnEvent(DebugContext::Event::FinishedPrimitiveBatch,
                                                  nullptr);
@@ -258,10 +433,10 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(pipeline.command_buffer.trigger[1], 0x23d): {
         unsigned index =
             static_cast<unsigned>(id - PICA_REG_INDEX(pipeline.command_buffer.trigger[0]));
-        u32* head_ptr = (u32*)VideoCore::g_memory->GetPhysicalPointer(
+        u32* head_ptr = (u32*)VideoCore::GetMemory().GetPhysicalPointer(
             regs.pipeline.command_buffer.GetPhysicalAddress(index));
-        g_state.cmd_list.head_ptr = g_state.cmd_list.current_ptr = head_ptr;
-        g_state.cmd_list.length = regs.pipeline.command_buffer.GetSize(index) / sizeof(u32);
+        state.cmd_list.head_ptr = state.cmd_list.current_ptr = head_ptr;
+        state.cmd_list.length = regs.pipeline.command_buffer.GetSize(index) / sizeof(u32);
         break;
     }
 
@@ -276,7 +451,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
         if (g_debug_context)
             g_debug_context->OnEvent(DebugContext::Event::IncomingPrimitiveBatch, nullptr);
 
-        PrimitiveAssembler<Shader::OutputVertex>& primitive_assembler = g_state.primitive_assembler;
+        PrimitiveAssembler<Shader::OutputVertex>& primitive_assembler = state.primitive_assembler;
 
         bool accelerate_draw = VideoCore::g_hw_shader_enabled && primitive_assembler.IsEmpty();
 
@@ -301,7 +476,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
         bool is_indexed = (id == PICA_REG_INDEX(pipeline.trigger_draw_indexed));
 
         if (accelerate_draw &&
-            VideoCore::g_renderer->Rasterizer()->AccelerateDrawBatch(is_indexed)) {
+            VideoCore::GetRenderer()->Rasterizer()->AccelerateDrawBatch(is_indexed)) {
             if (g_debug_context) {
                 g_debug_context->OnEvent(DebugContext::Event::FinishedPrimitiveBatch, nullptr);
             }
@@ -318,7 +493,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
         // Load vertices
         const auto& index_info = regs.pipeline.index_array;
         const u8* index_address_8 =
-            VideoCore::g_memory->GetPhysicalPointer(base_address + index_info.offset);
+            VideoCore::GetMemory().GetPhysicalPointer(base_address + index_info.offset);
         const u16* index_address_16 = reinterpret_cast<const u16*>(index_address_8);
         bool index_u16 = index_info.format != 0;
 
@@ -329,7 +504,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
                     continue;
 
                 u8* texture_data =
-                    VideoCore::g_memory->GetPhysicalPointer(texture.config.GetPhysicalAddress());
+                    VideoCore::GetMemory().GetPhysicalPointer(texture.config.GetPhysicalAddress());
                 g_debug_context->recorder->MemoryAccessed(
                     texture_data,
                     Pica::TexturingRegs::NibblesPerPixel(texture.format) * texture.config.width /
@@ -353,73 +528,85 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
         auto* shader_engine = Shader::GetEngine();
         Shader::UnitState shader_unit;
 
-        shader_engine->SetupBatch(g_state.vs, regs.vs.main_offset);
+        shader_engine->SetupBatch(state.vs, regs.vs.main_offset);
 
-        g_state.geometry_pipeline.Reconfigure();
-        g_state.geometry_pipeline.Setup(shader_engine);
-        if (g_state.geometry_pipeline.NeedIndexInput())
+        state.geometry_pipeline.Reconfigure();
+        state.geometry_pipeline.Setup(shader_engine);
+        if (state.geometry_pipeline.NeedIndexInput())
             ASSERT(is_indexed);
 
-        for (unsigned int index = 0; index < regs.pipeline.num_vertices; ++index) {
-            // Indexed rendering doesn't use the start offset
-            unsigned int vertex =
-                is_indexed ? (index_u16 ? index_address_16[index] : index_address_8[index])
-                           : (index + regs.pipeline.vertex_offset);
+        Common::ThreadPool* const worker_pool = VideoCore::GetWorkerPool();
+        // Without a geometry shader, vertices only depend on their own inputs and can be shaded
+        // in any order. Debugging needs per-vertex events, which the serial path provides.
+        const bool shade_in_parallel = worker_pool != nullptr && !g_debug_context &&
+                                       regs.pipeline.use_gs == PipelineRegs::UseGS::No &&
+                                       regs.pipeline.num_vertices >= PARALLEL_SHADING_MIN_VERTICES;
 
-            bool vertex_cache_hit = false;
+        if (shade_in_parallel) {
+            ProcessBatchParallel(*worker_pool, loader, base_address, is_indexed, index_address_8,
+                                 index_u16);
+        } else {
+            for (unsigned int index = 0; index < regs.pipeline.num_vertices; ++index) {
+                // Indexed rendering doesn't use the start offset
+                unsigned int vertex =
+                    is_indexed ? (index_u16 ? index_address_16[index] : index_address_8[index])
+                               : (index + regs.pipeline.vertex_offset);
 
-            if (is_indexed) {
-                if (g_state.geometry_pipeline.NeedIndexInput()) {
-                    g_state.geometry_pipeline.SubmitIndex(vertex);
-                    continue;
-                }
+                bool vertex_cache_hit = false;
 
-                if (g_debug_context && Pica::g_debug_context->recorder) {
-                    int size = index_u16 ? 2 : 1;
-                    memory_accesses.AddAccess(base_address + index_info.offset + size * index,
-                                              size);
-                }
+                if (is_indexed) {
+                    if (state.geometry_pipeline.NeedIndexInput()) {
+                        state.geometry_pipeline.SubmitIndex(vertex);
+                        continue;
+                    }
 
-                for (unsigned int i = 0; i < VERTEX_CACHE_SIZE; ++i) {
-                    if (vertex_cache_valid[i] && vertex == vertex_cache_ids[i]) {
-                        vs_output = vertex_cache[i];
-                        vertex_cache_hit = true;
-                        break;
+                    if (g_debug_context && Pica::g_debug_context->recorder) {
+                        int size = index_u16 ? 2 : 1;
+                        memory_accesses.AddAccess(base_address + index_info.offset + size * index,
+                                                  size);
                     }
-                }
-            }
 
-            if (!vertex_cache_hit) {
-                // Initialize data for the current vertex
-                Shader::AttributeBuffer input;
-                loader.LoadVertex(base_address, index, vertex, input, memory_accesses);
+                    for (unsigned int i = 0; i < VERTEX_CACHE_SIZE; ++i) {
+                        if (vertex_cache_valid[i] && vertex == vertex_cache_ids[i]) {
+                            vs_output = vertex_cache[i];
+                            vertex_cache_hit = true;
+                            break;
+                        }
+                    }
+                }
 
-                // Send to vertex shader
-                if (g_debug_context)
-                    g_debug_context->OnEvent(DebugContext::Event::VertexShaderInvocation,
-                                             (void*)&input);
-                shader_unit.LoadInput(regs.vs, input);
-                shader_engine->Run(g_state.vs, shader_unit);
-                shader_unit.WriteOutput(regs.vs, vs_output);
+                if (!vertex_cache_hit) {
+                    // Initialize data for the current vertex
+                    Shader::AttributeBuffer input;
+                    loader.LoadVertex(base_address, index, vertex, input, memory_accesses);
 
-                if (is_indexed) {
-                    vertex_cache[vertex_cache_pos] = vs_output;
-                    vertex_cache_valid[vertex_cache_pos] = true;
-                    vertex_cache_ids[vertex_cache_pos] = vertex;
-                    vertex_cache_pos = (vertex_cache_pos + 1) % VERTEX_CACHE_SIZE;
+                    // Send to vertex shader
+                    if (g_debug_context)
+                        g_debug_context->OnEvent(DebugContext::Event::VertexShaderInvocation,
+                                                 (void*)&input);
+                    shader_unit.LoadInput(regs.vs, input);
+                    shader_engine->Run(state.vs, shader_unit);
+                    shader_unit.WriteOutput(regs.vs, vs_output);
+
+                    if (is_indexed) {
+                        vertex_cache[vertex_cache_pos] = vs_output;
+                        vertex_cache_valid[vertex_cache_pos] = true;
+                        vertex_cache_ids[vertex_cache_pos] = vertex;
+                        vertex_cache_pos = (vertex_cache_pos + 1) % VERTEX_CACHE_SIZE;
+                    }
                 }
-            }
 
-            // Send to geometry pipeline
-            g_state.geometry_pipeline.SubmitVertex(vs_output);
+                // Send to geometry pipeline
+                state.geometry_pipeline.SubmitVertex(vs_output);
+            }
         }
 
         for (auto& range : memory_accesses.ranges) {
             g_debug_context->recorder->MemoryAccessed(
-                VideoCore::g_memory->GetPhysicalPointer(range.first), range.second, range.first);
+                VideoCore::GetMemory().GetPhysicalPointer(range.first), range.second, range.first);
         }
 
-        VideoCore::g_renderer->Rasterizer()->DrawTriangles();
+        VideoCore::GetRenderer()->Rasterizer()->DrawTriangles();
         if (g_debug_context) {
             g_debug_context->OnEvent(DebugContext::Event::FinishedPrimitiveBatch, nullptr);
         }
@@ -428,7 +615,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     }
 
     case PICA_REG_INDEX(gs.bool_uniforms):
-        WriteUniformBoolReg(g_state.gs, g_state.regs.gs.bool_uniforms.Value());
+        WriteUniformBoolReg(state.gs, state.regs.gs.bool_uniforms.Value());
         break;
 
     case PICA_REG_INDEX_WORKAROUND(gs.int_uniforms[0], 0x281):
@@ -437,7 +624,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(gs.int_uniforms[3], 0x284): {
         unsigned index = (id - PICA_REG_INDEX_WORKAROUND(gs.int_uniforms[0], 0x281));
         auto values = regs.gs.int_uniforms[index];
-        WriteUniformIntReg(g_state.gs, index,
+        WriteUniformIntReg(state.gs, index,
                            Common::Vec4<u8>(values.x, values.y, values.z, values.w));
         break;
     }
@@ -450,8 +637,8 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(gs.uniform_setup.set_value[5], 0x296):
     case PICA_REG_INDEX_WORKAROUND(gs.uniform_setup.set_value[6], 0x297):
     case PICA_REG_INDEX_WORKAROUND(gs.uniform_setup.set_value[7], 0x298): {
-        WriteUniformFloatReg(g_state.regs.gs, g_state.gs, g_state.gs_float_regs_counter,
-                             g_state.gs_uniform_write_buffer, value);
+        WriteUniformFloatReg(state.regs.gs, state.gs, state.gs_float_regs_counter,
+                             state.gs_uniform_write_buffer, value);
         break;
     }
 
@@ -463,12 +650,12 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(gs.program.set_word[5], 0x2a1):
     case PICA_REG_INDEX_WORKAROUND(gs.program.set_word[6], 0x2a2):
     case PICA_REG_INDEX_WORKAROUND(gs.program.set_word[7], 0x2a3): {
-        u32& offset = g_state.regs.gs.program.offset;
+        u32& offset = state.regs.gs.program.offset;
         if (offset >= 4096) {
             LOG_ERROR(HW_GPU, "Invalid GS program offset {}", offset);
         } else {
-            g_state.gs.program_code[offset] = value;
-            g_state.gs.MarkProgramCodeDirty();
+            state.gs.program_code[offset] = value;
+            state.gs.MarkProgramCodeDirty();
             offset++;
         }
         break;
@@ -482,12 +669,12 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(gs.swizzle_patterns.set_word[5], 0x2ab):
     case PICA_REG_INDEX_WORKAROUND(gs.swizzle_patterns.set_word[6], 0x2ac):
     case PICA_REG_INDEX_WORKAROUND(gs.swizzle_patterns.set_word[7], 0x2ad): {
-        u32& offset = g_state.regs.gs.swizzle_patterns.offset;
-        if (offset >= g_state.gs.swizzle_data.size()) {
+        u32& offset = state.regs.gs.swizzle_patterns.offset;
+        if (offset >= state.gs.swizzle_data.size()) {
             LOG_ERROR(HW_GPU, "Invalid GS swizzle pattern offset {}", offset);
         } else {
-            g_state.gs.swizzle_data[offset] = value;
-            g_state.gs.MarkSwizzleDataDirty();
+            state.gs.swizzle_data[offset] = value;
+            state.gs.MarkSwizzleDataDirty();
             offset++;
         }
         break;
@@ -495,7 +682,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
 
     case PICA_REG_INDEX(vs.bool_uniforms):
         // TODO (wwylele): does regs.pipeline.gs_unit_exclusive_configuration affect this?
-        WriteUniformBoolReg(g_state.vs, g_state.regs.vs.bool_uniforms.Value());
+        WriteUniformBoolReg(state.vs, state.regs.vs.bool_uniforms.Value());
         break;
 
     case PICA_REG_INDEX_WORKAROUND(vs.int_uniforms[0], 0x2b1):
@@ -505,7 +692,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
         // TODO (wwylele): does regs.pipeline.gs_unit_exclusive_configuration affect this?
         unsigned index = (id - PICA_REG_INDEX_WORKAROUND(vs.int_uniforms[0], 0x2b1));
         auto values = regs.vs.int_uniforms[index];
-        WriteUniformIntReg(g_state.vs, index,
+        WriteUniformIntReg(state.vs, index,
                            Common::Vec4<u8>(values.x, values.y, values.z, values.w));
         break;
     }
@@ -519,8 +706,8 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(vs.uniform_setup.set_value[6], 0x2c7):
     case PICA_REG_INDEX_WORKAROUND(vs.uniform_setup.set_value[7], 0x2c8): {
         // TODO (wwylele): does regs.pipeline.gs_unit_exclusive_configuration affect this?
-        WriteUniformFloatReg(g_state.regs.vs, g_state.vs, g_state.vs_float_regs_counter,
-                             g_state.vs_uniform_write_buffer, value);
+        WriteUniformFloatReg(state.regs.vs, state.vs, state.vs_float_regs_counter,
+                             state.vs_uniform_write_buffer, value);
         break;
     }
 
@@ -532,15 +719,15 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(vs.program.set_word[5], 0x2d1):
     case PICA_REG_INDEX_WORKAROUND(vs.program.set_word[6], 0x2d2):
     case PICA_REG_INDEX_WORKAROUND(vs.program.set_word[7], 0x2d3): {
-        u32& offset = g_state.regs.vs.program.offset;
+        u32& offset = state.regs.vs.program.offset;
         if (offset >= 512) {
             LOG_ERROR(HW_GPU, "Invalid VS program offset {}", offset);
         } else {
-            g_state.vs.program_code[offset] = value;
-            g_state.vs.MarkProgramCodeDirty();
-            if (!g_state.regs.pipeline.gs_unit_exclusive_configuration) {
-                g_state.gs.program_code[offset] = value;
-                g_state.gs.MarkProgramCodeDirty();
+            state.vs.program_code[offset] = value;
+            state.vs.MarkProgramCodeDirty();
+            if (!state.regs.pipeline.gs_unit_exclusive_configuration) {
+                state.gs.program_code[offset] = value;
+                state.gs.MarkProgramCodeDirty();
             }
             offset++;
         }
@@ -555,15 +742,15 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(vs.swizzle_patterns.set_word[5], 0x2db):
     case PICA_REG_INDEX_WORKAROUND(vs.swizzle_patterns.set_word[6], 0x2dc):
     case PICA_REG_INDEX_WORKAROUND(vs.swizzle_patterns.set_word[7], 0x2dd): {
-        u32& offset = g_state.regs.vs.swizzle_patterns.offset;
-        if (offset >= g_state.vs.swizzle_data.size()) {
+        u32& offset = state.regs.vs.swizzle_patterns.offset;
+        if (offset >= state.vs.swizzle_data.size()) {
             LOG_ERROR(HW_GPU, "Invalid VS swizzle pattern offset {}", offset);
         } else {
-            g_state.vs.swizzle_data[offset] = value;
-            g_state.vs.MarkSwizzleDataDirty();
-            if (!g_state.regs.pipeline.gs_unit_exclusive_configuration) {
-                g_state.gs.swizzle_data[offset] = value;
-                g_state.gs.MarkSwizzleDataDirty();
+            state.vs.swizzle_data[offset] = value;
+            state.vs.MarkSwizzleDataDirty();
+            if (!state.regs.pipeline.gs_unit_exclusive_configuration) {
+                state.gs.swizzle_data[offset] = value;
+                state.gs.MarkSwizzleDataDirty();
             }
             offset++;
         }
@@ -582,7 +769,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
 
         ASSERT_MSG(lut_config.index < 256, "lut_config.index exceeded maximum value of 255!");
 
-        g_state.lighting.luts[lut_config.type][lut_config.index].raw = value;
+        state.lighting.luts[lut_config.type][lut_config.index].raw = value;
         lut_config.index.Assign(lut_config.index + 1);
         break;
     }
@@ -595,7 +782,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(texturing.fog_lut_data[5], 0xed):
     case PICA_REG_INDEX_WORKAROUND(texturing.fog_lut_data[6], 0xee):
     case PICA_REG_INDEX_WORKAROUND(texturing.fog_lut_data[7], 0xef): {
-        g_state.fog.lut[regs.texturing.fog_lut_offset % 128].raw = value;
+        state.fog.lut[regs.texturing.fog_lut_offset % 128].raw = value;
         regs.texturing.fog_lut_offset.Assign(regs.texturing.fog_lut_offset + 1);
         break;
     }
@@ -609,7 +796,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
     case PICA_REG_INDEX_WORKAROUND(texturing.proctex_lut_data[6], 0xb6):
     case PICA_REG_INDEX_WORKAROUND(texturing.proctex_lut_data[7], 0xb7): {
         auto& index = regs.texturing.proctex_lut_config.index;
-        auto& pt = g_state.proctex;
+        auto& pt = state.proctex;
 
         switch (regs.texturing.proctex_lut_config.ref_table.Value()) {
         case TexturingRegs::ProcTexLutTable::Noise:
@@ -635,7 +822,7 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
         break;
     }
 
-    VideoCore::g_renderer->Rasterizer()->NotifyPicaRegisterChanged(id);
+    VideoCore::GetRenderer()->Rasterizer()->NotifyPicaRegisterChanged(id);
 
     if (g_debug_context)
         g_debug_context->OnEvent(DebugContext::Event::PicaCommandProcessed,
@@ -643,23 +830,24 @@ static void WritePicaReg(u32 id, u32 value, u32 mask) {
 }
 
 void ProcessCommandList(const u32* list, u32 size) {
-    g_state.cmd_list.head_ptr = g_state.cmd_list.current_ptr = list;
-    g_state.cmd_list.length = size / sizeof(u32);
+    State& state = GetState();
+    state.cmd_list.head_ptr = state.cmd_list.current_ptr = list;
+    state.cmd_list.length = size / sizeof(u32);
 
-    while (g_state.cmd_list.current_ptr < g_state.cmd_list.head_ptr + g_state.cmd_list.length) {
+    while (state.cmd_list.current_ptr < state.cmd_list.head_ptr + state.cmd_list.length) {
 
         // Align read pointer to 8 bytes
-        if ((g_state.cmd_list.head_ptr - g_state.cmd_list.current_ptr) % 2 != 0)
-            ++g_state.cmd_list.current_ptr;
+        if ((state.cmd_list.head_ptr - state.cmd_list.current_ptr) % 2 != 0)
+            ++state.cmd_list.current_ptr;
 
-        u32 value = *g_state.cmd_list.current_ptr++;
-        const CommandHeader header = {*g_state.cmd_list.current_ptr++};
+        u32 value = *state.cmd_list.current_ptr++;
+        const CommandHeader header = {*state.cmd_list.current_ptr++};
 
-        WritePicaReg(header.cmd_id, value, header.parameter_mask);
+        WritePicaReg(state, header.cmd_id, value, header.parameter_mask);
 
         for (unsigned i = 0; i < header.extra_data_length; ++i) {
             u32 cmd = header.cmd_id + (header.group_commands ? i + 1 : 0);
-            WritePicaReg(cmd, *g_state.cmd_list.current_ptr++, header.parameter_mask);
+            WritePicaReg(state, cmd, *state.cmd_list.current_ptr++, header.parameter_mask);
         }
     }
 }
@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include <cstring>
+#include "core/core.h"
 #include "video_core/geometry_pipeline.h"
 #include "video_core/pica.h"
 #include "video_core/pica_state.h"
@@ -11,14 +12,12 @@
 
 namespace Pica {
 
-State g_state;
-
-void Init() {
-    g_state.Reset();
+State& GetState() {
+    return *Core::System::GetInstance().VideoContext().pica_state;
 }
 
-void Shutdown() {
-    Shader::Shutdown();
+void Init() {
+    GetState().Reset();
 }
 
 template <typename T>
@@ -31,7 +30,7 @@ State::State() : geometry_pipeline(*this) {
         using Pica::Shader::OutputVertex;
         auto AddTriangle = [this](const OutputVertex& v0, const OutputVertex& v1,
                                   const OutputVertex& v2) {
-            VideoCore::g_renderer->Rasterizer()->AddTriangle(v0, v1, v2);
+            VideoCore::GetRenderer()->Rasterizer()->AddTriangle(v0, v1, v2);
         };
         primitive_assembler.SubmitVertex(
             Shader::OutputVertex::FromAttributeBuffer(regs.rasterizer, vertex), AddTriangle);
@@ -39,8 +38,8 @@ State::State() : geometry_pipeline(*this) {
 
     auto SetWinding = [this]() { primitive_assembler.SetWinding(); };
 
-    g_state.gs_unit.SetVertexHandler(SubmitVertex, SetWinding);
-    g_state.geometry_pipeline.SetVertexHandler(SubmitVertex);
+    gs_unit.SetVertexHandler(SubmitVertex, SetWinding);
+    geometry_pipeline.SetVertexHandler(SubmitVertex);
 }
 
 void State::Reset() {
@@ -10,7 +10,4 @@ namespace Pica {
 /// Initialize Pica state
 void Init();
 
-/// Shutdown Pica state
-void Shutdown();
-
 } // namespace Pica
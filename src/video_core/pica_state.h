@@ -163,6 +163,7 @@ struct State {
     u32 default_attr_write_buffer[3]{};
 };
 
-extern State g_state; ///< Current Pica state
+/// Returns the Pica state of the console bound to the calling thread
+State& GetState();
 
 } // namespace Pica
@@ -15,7 +15,10 @@
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
 #include "common/vector_math.h"
+#include "core/core.h"
 #include "core/hw/gpu.h"
+#include "core/loader/loader.h"
+#include "core/settings.h"
 #include "video_core/pica_state.h"
 #include "video_core/regs_framebuffer.h"
 #include "video_core/regs_rasterizer.h"
@@ -45,10 +48,10 @@ static bool IsVendorAmd() {
 
 RasterizerOpenGL::RasterizerOpenGL(Frontend::EmuWindow& window)
     : is_amd(IsVendorAmd()), shader_dirty(true),
-      vertex_buffer(GL_ARRAY_BUFFER, VERTEX_BUFFER_SIZE, is_amd),
-      uniform_buffer(GL_UNIFORM_BUFFER, UNIFORM_BUFFER_SIZE, false),
-      index_buffer(GL_ELEMENT_ARRAY_BUFFER, INDEX_BUFFER_SIZE, false),
-      texture_buffer(GL_TEXTURE_BUFFER, TEXTURE_BUFFER_SIZE, false), emu_window{window} {
+      vertex_buffer(GL_ARRAY_BUFFER, VERTEX_BUFFER_SIZE, is_amd, true),
+      uniform_buffer(GL_UNIFORM_BUFFER, UNIFORM_BUFFER_SIZE, false, true),
+      index_buffer(GL_ELEMENT_ARRAY_BUFFER, INDEX_BUFFER_SIZE, false, true),
+      texture_buffer(GL_TEXTURE_BUFFER, TEXTURE_BUFFER_SIZE, false, true), emu_window{window} {
 
     allow_shadow = GLAD_GL_ARB_shader_image_load_store && GLAD_GL_ARB_shader_image_size &&
                    GLAD_GL_ARB_framebuffer_no_attachments;
@@ -157,6 +160,14 @@ RasterizerOpenGL::RasterizerOpenGL(Frontend::EmuWindow& window)
     shader_program_manager =
         std::make_unique<ShaderProgramManager>(GLAD_GL_ARB_separate_shader_objects, is_amd);
 
+    if (Settings::values.use_disk_shader_cache) {
+        u64 program_id;
+        if (Core::System::GetInstance().GetAppLoader().ReadProgramId(program_id) ==
+            Loader::ResultStatus::Success) {
+            shader_program_manager->LoadDiskCache(program_id);
+        }
+    }
+
     glEnable(GL_BLEND);
 
     SyncEntireState();
@@ -184,7 +195,7 @@ void RasterizerOpenGL::SyncEntireState() {
     SyncDepthOffset();
     SyncAlphaTest();
     SyncCombinerColor();
-    auto& tev_stages = Pica::g_state.regs.texturing.GetTevStages();
+    auto& tev_stages = Pica::GetState().regs.texturing.GetTevStages();
     for (std::size_t index = 0; index < tev_stages.size(); ++index)
         SyncTevConstColor(index, tev_stages[index]);
 
@@ -253,7 +264,7 @@ struct VertexArrayInfo {
 };
 
 RasterizerOpenGL::VertexArrayInfo RasterizerOpenGL::AnalyzeVertexArray(bool is_indexed) {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     const auto& vertex_attributes = regs.pipeline.vertex_attributes;
 
     u32 vertex_min;
@@ -261,7 +272,7 @@ RasterizerOpenGL::VertexArrayInfo RasterizerOpenGL::AnalyzeVertexArray(bool is_i
     if (is_indexed) {
         const auto& index_info = regs.pipeline.index_array;
         PAddr address = vertex_attributes.GetPhysicalBaseAddress() + index_info.offset;
-        const u8* index_address_8 = VideoCore::g_memory->GetPhysicalPointer(address);
+        const u8* index_address_8 = VideoCore::GetMemory().GetPhysicalPointer(address);
         const u16* index_address_16 = reinterpret_cast<const u16*>(index_address_8);
         bool index_u16 = index_info.format != 0;
 
@@ -293,7 +304,7 @@ RasterizerOpenGL::VertexArrayInfo RasterizerOpenGL::AnalyzeVertexArray(bool is_i
 void RasterizerOpenGL::SetupVertexArray(u8* array_ptr, GLintptr buffer_offset,
                                         GLuint vs_input_index_min, GLuint vs_input_index_max) {
     MICROPROFILE_SCOPE(OpenGL_VAO);
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     const auto& vertex_attributes = regs.pipeline.vertex_attributes;
     PAddr base_address = vertex_attributes.GetPhysicalBaseAddress();
 
@@ -342,7 +353,7 @@ void RasterizerOpenGL::SetupVertexArray(u8* array_ptr, GLintptr buffer_offset,
         u32 data_size = loader.byte_count * vertex_num;
 
         res_cache.FlushRegion(data_addr, data_size, nullptr);
-        std::memcpy(array_ptr, VideoCore::g_memory->GetPhysicalPointer(data_addr), data_size);
+        std::memcpy(array_ptr, VideoCore::GetMemory().GetPhysicalPointer(data_addr), data_size);
 
         array_ptr += data_size;
         buffer_offset += data_size;
@@ -361,7 +372,7 @@ void RasterizerOpenGL::SetupVertexArray(u8* array_ptr, GLintptr buffer_offset,
         if (vertex_attributes.IsDefaultAttribute(i)) {
             u32 reg = regs.vs.GetRegisterForAttribute(i);
             if (!enable_attributes[reg]) {
-                const auto& attr = Pica::g_state.input_default_attributes.attr[i];
+                const auto& attr = Pica::GetState().input_default_attributes.attr[i];
                 glVertexAttrib4f(reg, attr.x.ToFloat32(), attr.y.ToFloat32(), attr.z.ToFloat32(),
                                  attr.w.ToFloat32());
             }
@@ -371,25 +382,26 @@ void RasterizerOpenGL::SetupVertexArray(u8* array_ptr, GLintptr buffer_offset,
 
 bool RasterizerOpenGL::SetupVertexShader() {
     MICROPROFILE_SCOPE(OpenGL_VS);
-    PicaVSConfig vs_config(Pica::g_state.regs, Pica::g_state.vs);
-    return shader_program_manager->UseProgrammableVertexShader(vs_config, Pica::g_state.vs);
+    PicaVSConfig vs_config(Pica::GetState().regs, Pica::GetState().vs);
+    return shader_program_manager->UseProgrammableVertexShader(vs_config, Pica::GetState().vs);
 }
 
 bool RasterizerOpenGL::SetupGeometryShader() {
     MICROPROFILE_SCOPE(OpenGL_GS);
-    const auto& regs = Pica::g_state.regs;
+    auto& pica_state = Pica::GetState();
+    const auto& regs = pica_state.regs;
     if (regs.pipeline.use_gs == Pica::PipelineRegs::UseGS::No) {
         PicaFixedGSConfig gs_config(regs);
         shader_program_manager->UseFixedGeometryShader(gs_config);
         return true;
     } else {
-        PicaGSConfig gs_config(regs, Pica::g_state.gs);
-        return shader_program_manager->UseProgrammableGeometryShader(gs_config, Pica::g_state.gs);
+        PicaGSConfig gs_config(regs, pica_state.gs);
+        return shader_program_manager->UseProgrammableGeometryShader(gs_config, pica_state.gs);
     }
 }
 
 bool RasterizerOpenGL::AccelerateDrawBatch(bool is_indexed) {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     if (regs.pipeline.use_gs != Pica::PipelineRegs::UseGS::No) {
         if (regs.pipeline.gs_config.mode != Pica::PipelineRegs::GSMode::Point) {
             return false;
@@ -409,7 +421,7 @@ bool RasterizerOpenGL::AccelerateDrawBatch(bool is_indexed) {
 }
 
 static GLenum GetCurrentPrimitiveMode(bool use_gs) {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     if (use_gs) {
         switch ((regs.gs.max_input_attribute_index + 1) /
                 (regs.pipeline.vs_outmap_total_minus_1_a + 1)) {
@@ -442,7 +454,7 @@ static GLenum GetCurrentPrimitiveMode(bool use_gs) {
 }
 
 bool RasterizerOpenGL::AccelerateDrawBatchInternal(bool is_indexed, bool use_gs) {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     GLenum primitive_mode = GetCurrentPrimitiveMode(use_gs);
 
     auto [vs_input_index_min, vs_input_index_max, vs_input_size] = AnalyzeVertexArray(is_indexed);
@@ -473,7 +485,7 @@ bool RasterizerOpenGL::AccelerateDrawBatchInternal(bool is_indexed, bool use_gs)
             return false;
         }
 
-        const u8* index_data = VideoCore::g_memory->GetPhysicalPointer(
+        const u8* index_data = VideoCore::GetMemory().GetPhysicalPointer(
             regs.pipeline.vertex_attributes.GetPhysicalBaseAddress() +
             regs.pipeline.index_array.offset);
         std::tie(buffer_ptr, buffer_offset, std::ignore) = index_buffer.Map(index_buffer_size, 4);
@@ -498,7 +510,7 @@ void RasterizerOpenGL::DrawTriangles() {
 
 bool RasterizerOpenGL::Draw(bool accelerate, bool is_indexed) {
     MICROPROFILE_SCOPE(OpenGL_Drawing);
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
 
     bool shadow_rendering = regs.framebuffer.output_merger.fragment_operation_mode ==
                             Pica::FramebufferRegs::FragmentOperationMode::Shadow;
@@ -860,7 +872,7 @@ bool RasterizerOpenGL::Draw(bool accelerate, bool is_indexed) {
 }
 
 void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
 
     switch (id) {
     // Culling
@@ -1027,6 +1039,25 @@ void RasterizerOpenGL::NotifyPicaRegisterChanged(u32 id) {
         shader_dirty = true;
         break;
 
+    // Texture addresses and formats. Cube maps are loaded face by face, so they are left alone.
+    case PICA_REG_INDEX(texturing.texture0.address):
+    case PICA_REG_INDEX(texturing.texture0_format): {
+        using TextureType = Pica::TexturingRegs::TextureConfig::TextureType;
+        const TextureType texture_type = regs.texturing.texture0.type;
+        if (texture_type != TextureType::TextureCube && texture_type != TextureType::ShadowCube) {
+            res_cache.PrefetchTexture(regs.texturing.GetTextures()[0]);
+        }
+        break;
+    }
+    case PICA_REG_INDEX(texturing.texture1.address):
+    case PICA_REG_INDEX(texturing.texture1_format):
+        res_cache.PrefetchTexture(regs.texturing.GetTextures()[1]);
+        break;
+    case PICA_REG_INDEX(texturing.texture2.address):
+    case PICA_REG_INDEX(texturing.texture2_format):
+        res_cache.PrefetchTexture(regs.texturing.GetTextures()[2]);
+        break;
+
     // TEV stages
     // (This also syncs fog_mode and fog_flip which are part of tev_combiner_buffer_input)
     case PICA_REG_INDEX(texturing.tev_stage0.color_source1):
@@ -1629,16 +1660,16 @@ void RasterizerOpenGL::SamplerInfo::SyncWithConfig(
 }
 
 void RasterizerOpenGL::SetShader() {
-    auto config = PicaFSConfig::BuildFromRegs(Pica::g_state.regs);
+    auto config = PicaFSConfig::BuildFromRegs(Pica::GetState().regs);
     shader_program_manager->UseFragmentShader(config);
 }
 
 void RasterizerOpenGL::SyncClipEnabled() {
-    state.clip_distance[1] = Pica::g_state.regs.rasterizer.clip_enable != 0;
+    state.clip_distance[1] = Pica::GetState().regs.rasterizer.clip_enable != 0;
 }
 
 void RasterizerOpenGL::SyncClipCoef() {
-    const auto raw_clip_coef = Pica::g_state.regs.rasterizer.GetClipCoef();
+    const auto raw_clip_coef = Pica::GetState().regs.rasterizer.GetClipCoef();
     const GLvec4 new_clip_coef = {raw_clip_coef.x.ToFloat32(), raw_clip_coef.y.ToFloat32(),
                                   raw_clip_coef.z.ToFloat32(), raw_clip_coef.w.ToFloat32()};
     if (new_clip_coef != uniform_block_data.data.clip_coef) {
@@ -1648,7 +1679,7 @@ void RasterizerOpenGL::SyncClipCoef() {
 }
 
 void RasterizerOpenGL::SyncCullMode() {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
 
     switch (regs.rasterizer.cull_mode) {
     case Pica::RasterizerRegs::CullMode::KeepAll:
@@ -1675,7 +1706,7 @@ void RasterizerOpenGL::SyncCullMode() {
 
 void RasterizerOpenGL::SyncDepthScale() {
     float depth_scale =
-        Pica::float24::FromRaw(Pica::g_state.regs.rasterizer.viewport_depth_range).ToFloat32();
+        Pica::float24::FromRaw(Pica::GetState().regs.rasterizer.viewport_depth_range).ToFloat32();
     if (depth_scale != uniform_block_data.data.depth_scale) {
         uniform_block_data.data.depth_scale = depth_scale;
         uniform_block_data.dirty = true;
@@ -1684,7 +1715,8 @@ void RasterizerOpenGL::SyncDepthScale() {
 
 void RasterizerOpenGL::SyncDepthOffset() {
     float depth_offset =
-        Pica::float24::FromRaw(Pica::g_state.regs.rasterizer.viewport_depth_near_plane).ToFloat32();
+        Pica::float24::FromRaw(Pica::GetState().regs.rasterizer.viewport_depth_near_plane)
+            .ToFloat32();
     if (depth_offset != uniform_block_data.data.depth_offset) {
         uniform_block_data.data.depth_offset = depth_offset;
         uniform_block_data.dirty = true;
@@ -1692,11 +1724,11 @@ void RasterizerOpenGL::SyncDepthOffset() {
 }
 
 void RasterizerOpenGL::SyncBlendEnabled() {
-    state.blend.enabled = (Pica::g_state.regs.framebuffer.output_merger.alphablend_enable == 1);
+    state.blend.enabled = (Pica::GetState().regs.framebuffer.output_merger.alphablend_enable == 1);
 }
 
 void RasterizerOpenGL::SyncBlendFuncs() {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     state.blend.rgb_equation =
         PicaToGL::BlendEquation(regs.framebuffer.output_merger.alpha_blending.blend_equation_rgb);
     state.blend.a_equation =
@@ -1713,7 +1745,7 @@ void RasterizerOpenGL::SyncBlendFuncs() {
 
 void RasterizerOpenGL::SyncBlendColor() {
     auto blend_color =
-        PicaToGL::ColorRGBA8(Pica::g_state.regs.framebuffer.output_merger.blend_const.raw);
+        PicaToGL::ColorRGBA8(Pica::GetState().regs.framebuffer.output_merger.blend_const.raw);
     state.blend.color.red = blend_color[0];
     state.blend.color.green = blend_color[1];
     state.blend.color.blue = blend_color[2];
@@ -1721,7 +1753,7 @@ void RasterizerOpenGL::SyncBlendColor() {
 }
 
 void RasterizerOpenGL::SyncFogColor() {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     uniform_block_data.data.fog_color = {
         regs.texturing.fog_color.r.Value() / 255.0f,
         regs.texturing.fog_color.g.Value() / 255.0f,
@@ -1731,7 +1763,7 @@ void RasterizerOpenGL::SyncFogColor() {
 }
 
 void RasterizerOpenGL::SyncProcTexNoise() {
-    const auto& regs = Pica::g_state.regs.texturing;
+    const auto& regs = Pica::GetState().regs.texturing;
     uniform_block_data.data.proctex_noise_f = {
         Pica::float16::FromRaw(regs.proctex_noise_frequency.u).ToFloat32(),
         Pica::float16::FromRaw(regs.proctex_noise_frequency.v).ToFloat32(),
@@ -1749,7 +1781,7 @@ void RasterizerOpenGL::SyncProcTexNoise() {
 }
 
 void RasterizerOpenGL::SyncProcTexBias() {
-    const auto& regs = Pica::g_state.regs.texturing;
+    const auto& regs = Pica::GetState().regs.texturing;
     uniform_block_data.data.proctex_bias =
         Pica::float16::FromRaw(regs.proctex.bias_low | (regs.proctex_lut.bias_high << 8))
             .ToFloat32();
@@ -1758,7 +1790,7 @@ void RasterizerOpenGL::SyncProcTexBias() {
 }
 
 void RasterizerOpenGL::SyncAlphaTest() {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     if (regs.framebuffer.output_merger.alpha_test.ref != uniform_block_data.data.alphatest_ref) {
         uniform_block_data.data.alphatest_ref = regs.framebuffer.output_merger.alpha_test.ref;
         uniform_block_data.dirty = true;
@@ -1766,11 +1798,11 @@ void RasterizerOpenGL::SyncAlphaTest() {
 }
 
 void RasterizerOpenGL::SyncLogicOp() {
-    state.logic_op = PicaToGL::LogicOp(Pica::g_state.regs.framebuffer.output_merger.logic_op);
+    state.logic_op = PicaToGL::LogicOp(Pica::GetState().regs.framebuffer.output_merger.logic_op);
 }
 
 void RasterizerOpenGL::SyncColorWriteMask() {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
 
     auto IsColorWriteEnabled = [&](u32 value) {
         return (regs.framebuffer.framebuffer.allow_color_write != 0 && value != 0) ? GL_TRUE
@@ -1786,7 +1818,7 @@ void RasterizerOpenGL::SyncColorWriteMask() {
 }
 
 void RasterizerOpenGL::SyncStencilWriteMask() {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     state.stencil.write_mask =
         (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0)
             ? static_cast<GLuint>(regs.framebuffer.output_merger.stencil_test.write_mask)
@@ -1794,7 +1826,7 @@ void RasterizerOpenGL::SyncStencilWriteMask() {
 }
 
 void RasterizerOpenGL::SyncDepthWriteMask() {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     state.depth.write_mask = (regs.framebuffer.framebuffer.allow_depth_stencil_write != 0 &&
                               regs.framebuffer.output_merger.depth_write_enable)
                                  ? GL_TRUE
@@ -1802,7 +1834,7 @@ void RasterizerOpenGL::SyncDepthWriteMask() {
 }
 
 void RasterizerOpenGL::SyncStencilTest() {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     state.stencil.test_enabled =
         regs.framebuffer.output_merger.stencil_test.enable &&
         regs.framebuffer.framebuffer.depth_format == Pica::FramebufferRegs::DepthFormat::D24S8;
@@ -1819,7 +1851,7 @@ void RasterizerOpenGL::SyncStencilTest() {
 }
 
 void RasterizerOpenGL::SyncDepthTest() {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     state.depth.test_enabled = regs.framebuffer.output_merger.depth_test_enable == 1 ||
                                regs.framebuffer.output_merger.depth_write_enable == 1;
     state.depth.test_func =
@@ -1830,7 +1862,7 @@ void RasterizerOpenGL::SyncDepthTest() {
 
 void RasterizerOpenGL::SyncCombinerColor() {
     auto combiner_color =
-        PicaToGL::ColorRGBA8(Pica::g_state.regs.texturing.tev_combiner_buffer_color.raw);
+        PicaToGL::ColorRGBA8(Pica::GetState().regs.texturing.tev_combiner_buffer_color.raw);
     if (combiner_color != uniform_block_data.data.tev_combiner_buffer_color) {
         uniform_block_data.data.tev_combiner_buffer_color = combiner_color;
         uniform_block_data.dirty = true;
@@ -1847,7 +1879,7 @@ void RasterizerOpenGL::SyncTevConstColor(int stage_index,
 }
 
 void RasterizerOpenGL::SyncGlobalAmbient() {
-    auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.global_ambient);
+    auto color = PicaToGL::LightColor(Pica::GetState().regs.lighting.global_ambient);
     if (color != uniform_block_data.data.lighting_global_ambient) {
         uniform_block_data.data.lighting_global_ambient = color;
         uniform_block_data.dirty = true;
@@ -1855,7 +1887,7 @@ void RasterizerOpenGL::SyncGlobalAmbient() {
 }
 
 void RasterizerOpenGL::SyncLightSpecular0(int light_index) {
-    auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.light[light_index].specular_0);
+    auto color = PicaToGL::LightColor(Pica::GetState().regs.lighting.light[light_index].specular_0);
     if (color != uniform_block_data.data.light_src[light_index].specular_0) {
         uniform_block_data.data.light_src[light_index].specular_0 = color;
         uniform_block_data.dirty = true;
@@ -1863,7 +1895,7 @@ void RasterizerOpenGL::SyncLightSpecular0(int light_index) {
 }
 
 void RasterizerOpenGL::SyncLightSpecular1(int light_index) {
-    auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.light[light_index].specular_1);
+    auto color = PicaToGL::LightColor(Pica::GetState().regs.lighting.light[light_index].specular_1);
     if (color != uniform_block_data.data.light_src[light_index].specular_1) {
         uniform_block_data.data.light_src[light_index].specular_1 = color;
         uniform_block_data.dirty = true;
@@ -1871,7 +1903,7 @@ void RasterizerOpenGL::SyncLightSpecular1(int light_index) {
 }
 
 void RasterizerOpenGL::SyncLightDiffuse(int light_index) {
-    auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.light[light_index].diffuse);
+    auto color = PicaToGL::LightColor(Pica::GetState().regs.lighting.light[light_index].diffuse);
     if (color != uniform_block_data.data.light_src[light_index].diffuse) {
         uniform_block_data.data.light_src[light_index].diffuse = color;
         uniform_block_data.dirty = true;
@@ -1879,7 +1911,7 @@ void RasterizerOpenGL::SyncLightDiffuse(int light_index) {
 }
 
 void RasterizerOpenGL::SyncLightAmbient(int light_index) {
-    auto color = PicaToGL::LightColor(Pica::g_state.regs.lighting.light[light_index].ambient);
+    auto color = PicaToGL::LightColor(Pica::GetState().regs.lighting.light[light_index].ambient);
     if (color != uniform_block_data.data.light_src[light_index].ambient) {
         uniform_block_data.data.light_src[light_index].ambient = color;
         uniform_block_data.dirty = true;
@@ -1888,9 +1920,9 @@ void RasterizerOpenGL::SyncLightAmbient(int light_index) {
 
 void RasterizerOpenGL::SyncLightPosition(int light_index) {
     GLvec3 position = {
-        Pica::float16::FromRaw(Pica::g_state.regs.lighting.light[light_index].x).ToFloat32(),
-        Pica::float16::FromRaw(Pica::g_state.regs.lighting.light[light_index].y).ToFloat32(),
-        Pica::float16::FromRaw(Pica::g_state.regs.lighting.light[light_index].z).ToFloat32()};
+        Pica::float16::FromRaw(Pica::GetState().regs.lighting.light[light_index].x).ToFloat32(),
+        Pica::float16::FromRaw(Pica::GetState().regs.lighting.light[light_index].y).ToFloat32(),
+        Pica::float16::FromRaw(Pica::GetState().regs.lighting.light[light_index].z).ToFloat32()};
 
     if (position != uniform_block_data.data.light_src[light_index].position) {
         uniform_block_data.data.light_src[light_index].position = position;
@@ -1899,7 +1931,7 @@ void RasterizerOpenGL::SyncLightPosition(int light_index) {
 }
 
 void RasterizerOpenGL::SyncLightSpotDirection(int light_index) {
-    const auto& light = Pica::g_state.regs.lighting.light[light_index];
+    const auto& light = Pica::GetState().regs.lighting.light[light_index];
     GLvec3 spot_direction = {light.spot_x / 2047.0f, light.spot_y / 2047.0f,
                              light.spot_z / 2047.0f};
 
@@ -1911,7 +1943,7 @@ void RasterizerOpenGL::SyncLightSpotDirection(int light_index) {
 
 void RasterizerOpenGL::SyncLightDistanceAttenuationBias(int light_index) {
     GLfloat dist_atten_bias =
-        Pica::float20::FromRaw(Pica::g_state.regs.lighting.light[light_index].dist_atten_bias)
+        Pica::float20::FromRaw(Pica::GetState().regs.lighting.light[light_index].dist_atten_bias)
             .ToFloat32();
 
     if (dist_atten_bias != uniform_block_data.data.light_src[light_index].dist_atten_bias) {
@@ -1922,7 +1954,7 @@ void RasterizerOpenGL::SyncLightDistanceAttenuationBias(int light_index) {
 
 void RasterizerOpenGL::SyncLightDistanceAttenuationScale(int light_index) {
     GLfloat dist_atten_scale =
-        Pica::float20::FromRaw(Pica::g_state.regs.lighting.light[light_index].dist_atten_scale)
+        Pica::float20::FromRaw(Pica::GetState().regs.lighting.light[light_index].dist_atten_scale)
             .ToFloat32();
 
     if (dist_atten_scale != uniform_block_data.data.light_src[light_index].dist_atten_scale) {
@@ -1932,7 +1964,7 @@ void RasterizerOpenGL::SyncLightDistanceAttenuationScale(int light_index) {
 }
 
 void RasterizerOpenGL::SyncShadowBias() {
-    const auto& shadow = Pica::g_state.regs.framebuffer.shadow;
+    const auto& shadow = Pica::GetState().regs.framebuffer.shadow;
     GLfloat constant = Pica::float16::FromRaw(shadow.constant).ToFloat32();
     GLfloat linear = Pica::float16::FromRaw(shadow.linear).ToFloat32();
 
@@ -1945,7 +1977,7 @@ void RasterizerOpenGL::SyncShadowBias() {
 }
 
 void RasterizerOpenGL::SyncShadowTextureBias() {
-    GLint bias = Pica::g_state.regs.texturing.shadow.bias << 1;
+    GLint bias = Pica::GetState().regs.texturing.shadow.bias << 1;
     if (bias != uniform_block_data.data.shadow_texture_bias) {
         uniform_block_data.data.shadow_texture_bias = bias;
         uniform_block_data.dirty = true;
@@ -1979,7 +2011,7 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
         for (unsigned index = 0; index < uniform_block_data.lighting_lut_dirty.size(); index++) {
             if (uniform_block_data.lighting_lut_dirty[index] || invalidate) {
                 std::array<GLvec2, 256> new_data;
-                const auto& source_lut = Pica::g_state.lighting.luts[index];
+                const auto& source_lut = Pica::GetState().lighting.luts[index];
                 std::transform(source_lut.begin(), source_lut.end(), new_data.begin(),
                                [](const auto& entry) {
                                    return GLvec2{entry.ToFloat(), entry.DiffToFloat()};
@@ -2004,7 +2036,8 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
     if (uniform_block_data.fog_lut_dirty || invalidate) {
         std::array<GLvec2, 128> new_data;
 
-        std::transform(Pica::g_state.fog.lut.begin(), Pica::g_state.fog.lut.end(), new_data.begin(),
+        const auto& fog_lut = Pica::GetState().fog.lut;
+        std::transform(fog_lut.begin(), fog_lut.end(), new_data.begin(),
                        [](const auto& entry) {
                            return GLvec2{entry.ToFloat(), entry.DiffToFloat()};
                        });
@@ -2039,21 +2072,21 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
 
     // Sync the proctex noise lut
     if (uniform_block_data.proctex_noise_lut_dirty || invalidate) {
-        SyncProcTexValueLUT(Pica::g_state.proctex.noise_table, proctex_noise_lut_data,
+        SyncProcTexValueLUT(Pica::GetState().proctex.noise_table, proctex_noise_lut_data,
                             uniform_block_data.data.proctex_noise_lut_offset);
         uniform_block_data.proctex_noise_lut_dirty = false;
     }
 
     // Sync the proctex color map
     if (uniform_block_data.proctex_color_map_dirty || invalidate) {
-        SyncProcTexValueLUT(Pica::g_state.proctex.color_map_table, proctex_color_map_data,
+        SyncProcTexValueLUT(Pica::GetState().proctex.color_map_table, proctex_color_map_data,
                             uniform_block_data.data.proctex_color_map_offset);
         uniform_block_data.proctex_color_map_dirty = false;
     }
 
     // Sync the proctex alpha map
     if (uniform_block_data.proctex_alpha_map_dirty || invalidate) {
-        SyncProcTexValueLUT(Pica::g_state.proctex.alpha_map_table, proctex_alpha_map_data,
+        SyncProcTexValueLUT(Pica::GetState().proctex.alpha_map_table, proctex_alpha_map_data,
                             uniform_block_data.data.proctex_alpha_map_offset);
         uniform_block_data.proctex_alpha_map_dirty = false;
     }
@@ -2062,8 +2095,8 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
     if (uniform_block_data.proctex_lut_dirty || invalidate) {
         std::array<GLvec4, 256> new_data;
 
-        std::transform(Pica::g_state.proctex.color_table.begin(),
-                       Pica::g_state.proctex.color_table.end(), new_data.begin(),
+        std::transform(Pica::GetState().proctex.color_table.begin(),
+                       Pica::GetState().proctex.color_table.end(), new_data.begin(),
                        [](const auto& entry) {
                            auto rgba = entry.ToVector() / 255.0f;
                            return GLvec4{rgba.r(), rgba.g(), rgba.b(), rgba.a()};
@@ -2083,8 +2116,8 @@ void RasterizerOpenGL::SyncAndUploadLUTs() {
     if (uniform_block_data.proctex_diff_lut_dirty || invalidate) {
         std::array<GLvec4, 256> new_data;
 
-        std::transform(Pica::g_state.proctex.color_diff_table.begin(),
-                       Pica::g_state.proctex.color_diff_table.end(), new_data.begin(),
+        std::transform(Pica::GetState().proctex.color_diff_table.begin(),
+                       Pica::GetState().proctex.color_diff_table.end(), new_data.begin(),
                        [](const auto& entry) {
                            auto rgba = entry.ToVector() / 255.0f;
                            return GLvec4{rgba.r(), rgba.g(), rgba.b(), rgba.a()};
@@ -2128,7 +2161,7 @@ void RasterizerOpenGL::UploadUniforms(bool accelerate_draw, bool use_gs) {
 
     if (sync_vs) {
         VSUniformData vs_uniforms;
-        vs_uniforms.uniforms.SetFromRegs(Pica::g_state.regs.vs, Pica::g_state.vs);
+        vs_uniforms.uniforms.SetFromRegs(Pica::GetState().regs.vs, Pica::GetState().vs);
         std::memcpy(uniforms + used_bytes, &vs_uniforms, sizeof(vs_uniforms));
         glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(UniformBindings::VS),
                           uniform_buffer.GetHandle(), offset + used_bytes, sizeof(VSUniformData));
@@ -2137,7 +2170,7 @@ void RasterizerOpenGL::UploadUniforms(bool accelerate_draw, bool use_gs) {
 
     if (sync_gs) {
         GSUniformData gs_uniforms;
-        gs_uniforms.uniforms.SetFromRegs(Pica::g_state.regs.gs, Pica::g_state.gs);
+        gs_uniforms.uniforms.SetFromRegs(Pica::GetState().regs.gs, Pica::GetState().gs);
         std::memcpy(uniforms + used_bytes, &gs_uniforms, sizeof(gs_uniforms));
         glBindBufferRange(GL_UNIFORM_BUFFER, static_cast<GLuint>(UniformBindings::GS),
                           uniform_buffer.GetHandle(), offset + used_bytes, sizeof(GSUniformData));
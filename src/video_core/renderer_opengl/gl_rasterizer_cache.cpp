@@ -5,6 +5,7 @@
 #include <algorithm>
 #include <array>
 #include <atomic>
+#include <chrono>
 #include <cstring>
 #include <iterator>
 #include <memory>
@@ -17,10 +18,13 @@
 #include "common/alignment.h"
 #include "common/bit_field.h"
 #include "common/color.h"
+#include "common/hash.h"
 #include "common/logging/log.h"
 #include "common/math_util.h"
+#include "common/metrics.h"
 #include "common/microprofile.h"
 #include "common/scope_exit.h"
+#include "common/thread_pool.h"
 #include "common/vector_math.h"
 #include "core/frontend/emu_window.h"
 #include "core/memory.h"
@@ -201,8 +205,32 @@ static void MortonCopyTile(u32 stride, u8* tile_buffer, u8* gl_buffer) {
     }
 }
 
-template <bool morton_to_gl, PixelFormat format>
-static void MortonCopy(u32 stride, u32 height, u8* gl_buffer, PAddr base, PAddr start, PAddr end) {
+/// A copy of a range of guest memory, which MortonCopy can read in place of the memory itself
+class MemorySnapshot {
+public:
+    MemorySnapshot(PAddr addr, const u8* data, std::size_t size)
+        : addr(addr), data(data, data + size) {}
+
+    u8* GetPhysicalPointer(PAddr address) {
+        return &data[address - addr];
+    }
+
+    bool IsValidPhysicalAddress(PAddr address) const {
+        return address >= addr && address - addr <= data.size();
+    }
+
+    u64 ComputeHash() const {
+        return Common::ComputeHash64(data.data(), data.size());
+    }
+
+private:
+    PAddr addr;
+    std::vector<u8> data;
+};
+
+template <bool morton_to_gl, PixelFormat format, typename Source = Memory::MemorySystem>
+static void MortonCopy(Source& memory, u32 stride, u32 height, u8* gl_buffer, PAddr base,
+                       PAddr start, PAddr end) {
     constexpr u32 bytes_per_pixel = SurfaceParams::GetFormatBpp(format) / 8;
     constexpr u32 tile_size = bytes_per_pixel * 64;
 
@@ -231,7 +259,7 @@ static void MortonCopy(u32 stride, u32 height, u8* gl_buffer, PAddr base, PAddr
         }
     };
 
-    u8* tile_buffer = VideoCore::g_memory->GetPhysicalPointer(start);
+    u8* tile_buffer = memory.GetPhysicalPointer(start);
 
     if (start < aligned_start && !morton_to_gl) {
         std::array<u8, tile_size> tmp_buf;
@@ -248,8 +276,8 @@ static void MortonCopy(u32 stride, u32 height, u8* gl_buffer, PAddr base, PAddr
     while (tile_buffer < buffer_end) {
         // Pokemon Super Mystery Dungeon will try to use textures that go beyond
         // the end address of VRAM. Stop reading if reaches invalid address
-        if (!VideoCore::g_memory->IsValidPhysicalAddress(current_paddr) ||
-            !VideoCore::g_memory->IsValidPhysicalAddress(current_paddr + tile_size)) {
+        if (!memory.IsValidPhysicalAddress(current_paddr) ||
+            !memory.IsValidPhysicalAddress(current_paddr + tile_size)) {
             LOG_ERROR(Render_OpenGL, "Out of bound texture");
             break;
         }
@@ -266,7 +294,10 @@ static void MortonCopy(u32 stride, u32 height, u8* gl_buffer, PAddr base, PAddr
     }
 }
 
-static constexpr std::array<void (*)(u32, u32, u8*, PAddr, PAddr, PAddr), 18> morton_to_gl_fns = {
+template <typename Source = Memory::MemorySystem>
+using MortonCopyFunc = void (*)(Source&, u32, u32, u8*, PAddr, PAddr, PAddr);
+
+static constexpr std::array<MortonCopyFunc<>, 18> morton_to_gl_fns = {
     MortonCopy<true, PixelFormat::RGBA8>,  // 0
     MortonCopy<true, PixelFormat::RGB8>,   // 1
     MortonCopy<true, PixelFormat::RGB5A1>, // 2
@@ -287,7 +318,28 @@ static constexpr std::array<void (*)(u32, u32, u8*, PAddr, PAddr, PAddr), 18> mo
     MortonCopy<true, PixelFormat::D24S8> // 17
 };
 
-static constexpr std::array<void (*)(u32, u32, u8*, PAddr, PAddr, PAddr), 18> gl_to_morton_fns = {
+static constexpr std::array<MortonCopyFunc<MemorySnapshot>, 18> snapshot_to_gl_fns = {
+    MortonCopy<true, PixelFormat::RGBA8, MemorySnapshot>,  // 0
+    MortonCopy<true, PixelFormat::RGB8, MemorySnapshot>,   // 1
+    MortonCopy<true, PixelFormat::RGB5A1, MemorySnapshot>, // 2
+    MortonCopy<true, PixelFormat::RGB565, MemorySnapshot>, // 3
+    MortonCopy<true, PixelFormat::RGBA4, MemorySnapshot>,  // 4
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,                                             // 5 - 13
+    MortonCopy<true, PixelFormat::D16, MemorySnapshot>,  // 14
+    nullptr,                                             // 15
+    MortonCopy<true, PixelFormat::D24, MemorySnapshot>,  // 16
+    MortonCopy<true, PixelFormat::D24S8, MemorySnapshot> // 17
+};
+
+static constexpr std::array<MortonCopyFunc<>, 18> gl_to_morton_fns = {
     MortonCopy<false, PixelFormat::RGBA8>,  // 0
     MortonCopy<false, PixelFormat::RGB8>,   // 1
     MortonCopy<false, PixelFormat::RGB5A1>, // 2
@@ -728,12 +780,14 @@ void RasterizerCacheOpenGL::CopySurface(const Surface& src_surface, const Surfac
 }
 
 MICROPROFILE_DEFINE(OpenGL_SurfaceLoad, "OpenGL", "Surface Load", MP_RGB(128, 192, 64));
+static const Common::Metrics::CounterId texture_decode_counter =
+    Common::Metrics::RegisterCounter("rasterizer_cache.texture_decodes");
 void CachedSurface::LoadGLBuffer(PAddr load_start, PAddr load_end) {
     ASSERT(type != SurfaceType::Fill);
     const bool need_swap =
         GLES && (pixel_format == PixelFormat::RGBA8 || pixel_format == PixelFormat::RGB8);
 
-    const u8* const texture_src_data = VideoCore::g_memory->GetPhysicalPointer(addr);
+    const u8* const texture_src_data = VideoCore::GetMemory().GetPhysicalPointer(addr);
     if (texture_src_data == nullptr)
         return;
 
@@ -750,6 +804,7 @@ void CachedSurface::LoadGLBuffer(PAddr load_start, PAddr load_end) {
         load_start = Memory::VRAM_VADDR;
 
     MICROPROFILE_SCOPE(OpenGL_SurfaceLoad);
+    Common::Metrics::Increment(texture_decode_counter);
 
     ASSERT(load_start >= addr && load_end <= end);
     const u32 start_offset = load_start - addr;
@@ -790,24 +845,61 @@ void CachedSurface::LoadGLBuffer(PAddr load_start, PAddr load_end) {
             const auto rect = GetSubRect(FromInterval(load_interval));
             ASSERT(FromInterval(load_interval).GetInterval() == load_interval);
 
-            for (unsigned y = rect.bottom; y < rect.top; ++y) {
-                for (unsigned x = rect.left; x < rect.right; ++x) {
-                    auto vec4 =
-                        Pica::Texture::LookupTexture(texture_src_data, x, height - 1 - y, tex_info);
-                    const std::size_t offset = (x + (width * y)) * 4;
-                    std::memcpy(&gl_buffer[offset], vec4.AsArray(), 4);
-                }
-            }
+            // The texture is stored bottom to top, so its first row is the last one of the buffer
+            const std::ptrdiff_t row_size = width * 4;
+            Pica::Texture::DecodeTextureRect(texture_src_data, tex_info, rect.left,
+                                             height - rect.top, rect.right, height - rect.bottom,
+                                             &gl_buffer[(rect.left + width * (rect.top - 1)) * 4],
+                                             -row_size);
         } else {
-            morton_to_gl_fns[static_cast<std::size_t>(pixel_format)](stride, height, &gl_buffer[0],
-                                                                     addr, load_start, load_end);
+            morton_to_gl_fns[static_cast<std::size_t>(pixel_format)](
+                VideoCore::GetMemory(), stride, height, &gl_buffer[0], addr, load_start, load_end);
         }
     }
 }
 
+std::optional<u64> CachedSurface::ComputeContentHash() const {
+    const u8* const data = VideoCore::GetMemory().GetPhysicalPointer(addr);
+    // The surface has to be contiguous in host memory as well
+    if (data == nullptr || VideoCore::GetMemory().GetPhysicalPointer(end - 1) != data + size - 1)
+        return std::nullopt;
+    return Common::ComputeHash64(data, size);
+}
+
+/**
+ * Decodes a whole tiled surface from a copy of its memory into a new buffer laid out like
+ * CachedSurface::gl_buffer. Guest memory is not accessed, so this can run on any thread.
+ */
+static std::unique_ptr<u8[]> DecodeTiledSurface(MemorySnapshot& snapshot,
+                                                const SurfaceParams& params) {
+    const u32 bytes_per_pixel = CachedSurface::GetGLBytesPerPixel(params.pixel_format);
+    std::unique_ptr<u8[]> buffer(new u8[params.width * params.height * bytes_per_pixel]);
+
+    if (params.type == SurfaceType::Texture) {
+        Pica::Texture::TextureInfo tex_info{};
+        tex_info.width = params.width;
+        tex_info.height = params.height;
+        tex_info.format = static_cast<Pica::TexturingRegs::TextureFormat>(params.pixel_format);
+        tex_info.SetDefaultStride();
+        tex_info.physical_address = params.addr;
+
+        const std::ptrdiff_t row_size = params.width * 4;
+        Pica::Texture::DecodeTextureRect(snapshot.GetPhysicalPointer(params.addr), tex_info, 0, 0,
+                                         params.width, params.height,
+                                         &buffer[row_size * (params.height - 1)], -row_size);
+    } else {
+        snapshot_to_gl_fns[static_cast<std::size_t>(params.pixel_format)](
+            snapshot, params.stride, params.height, buffer.get(), params.addr, params.addr,
+            params.end);
+    }
+    return buffer;
+}
+
 MICROPROFILE_DEFINE(OpenGL_SurfaceFlush, "OpenGL", "Surface Flush", MP_RGB(128, 192, 64));
+static const Common::Metrics::CounterId flush_counter =
+    Common::Metrics::RegisterCounter("rasterizer_cache.flushes");
 void CachedSurface::FlushGLBuffer(PAddr flush_start, PAddr flush_end) {
-    u8* const dst_buffer = VideoCore::g_memory->GetPhysicalPointer(addr);
+    u8* const dst_buffer = VideoCore::GetMemory().GetPhysicalPointer(addr);
     if (dst_buffer == nullptr)
         return;
 
@@ -822,6 +914,7 @@ void CachedSurface::FlushGLBuffer(PAddr flush_start, PAddr flush_end) {
         flush_start = Memory::VRAM_VADDR;
 
     MICROPROFILE_SCOPE(OpenGL_SurfaceFlush);
+    Common::Metrics::Increment(flush_counter);
 
     ASSERT(flush_start >= addr && flush_end <= end);
     const u32 start_offset = flush_start - addr;
@@ -845,8 +938,8 @@ void CachedSurface::FlushGLBuffer(PAddr flush_start, PAddr flush_end) {
         ASSERT(type == SurfaceType::Color);
         std::memcpy(dst_buffer + start_offset, &gl_buffer[start_offset], flush_end - flush_start);
     } else {
-        gl_to_morton_fns[static_cast<std::size_t>(pixel_format)](stride, height, &gl_buffer[0],
-                                                                 addr, flush_start, flush_end);
+        gl_to_morton_fns[static_cast<std::size_t>(pixel_format)](
+            VideoCore::GetMemory(), stride, height, &gl_buffer[0], addr, flush_start, flush_end);
     }
 }
 
@@ -1147,6 +1240,10 @@ void main() {
 }
 
 RasterizerCacheOpenGL::~RasterizerCacheOpenGL() {
+    // The workers may still be reading guest memory
+    for (auto& pending : pending_decodes) {
+        pending.result.wait();
+    }
     FlushAll();
     while (!surface_cache.empty())
         UnregisterSurface(*surface_cache.begin()->second.begin());
@@ -1227,6 +1324,11 @@ void RasterizerCacheOpenGL::ConvertD24S8toABGR(GLuint src_tex,
     glBindTexture(GL_TEXTURE_BUFFER, 0);
 }
 
+static const Common::Metrics::CounterId hit_counter =
+    Common::Metrics::RegisterCounter("rasterizer_cache.hits");
+static const Common::Metrics::CounterId miss_counter =
+    Common::Metrics::RegisterCounter("rasterizer_cache.misses");
+
 Surface RasterizerCacheOpenGL::GetSurface(const SurfaceParams& params, ScaleMatch match_res_scale,
                                           bool load_if_create) {
     if (params.addr == 0 || params.height * params.width == 0) {
@@ -1242,6 +1344,7 @@ Surface RasterizerCacheOpenGL::GetSurface(const SurfaceParams& params, ScaleMatc
         FindMatch<MatchFlags::Exact | MatchFlags::Invalid>(surface_cache, params, match_res_scale);
 
     if (surface == nullptr) {
+        Common::Metrics::Increment(miss_counter);
         u16 target_res_scale = params.res_scale;
         if (match_res_scale != ScaleMatch::Exact) {
             // This surface may have a subrect of another surface with a higher res_scale, find it
@@ -1266,6 +1369,8 @@ Surface RasterizerCacheOpenGL::GetSurface(const SurfaceParams& params, ScaleMatc
         new_params.res_scale = target_res_scale;
         surface = CreateSurface(new_params);
         RegisterSurface(surface);
+    } else {
+        Common::Metrics::Increment(hit_counter);
     }
 
     if (load_if_create) {
@@ -1285,6 +1390,9 @@ SurfaceRect_Tuple RasterizerCacheOpenGL::GetSurfaceSubRect(const SurfaceParams&
     // Attempt to find encompassing surface
     Surface surface = FindMatch<MatchFlags::SubRect | MatchFlags::Invalid>(surface_cache, params,
                                                                            match_res_scale);
+    if (surface != nullptr) {
+        Common::Metrics::Increment(hit_counter);
+    }
 
     // Check if FindMatch failed because of res scaling
     // If that's the case create a new surface with
@@ -1294,6 +1402,7 @@ SurfaceRect_Tuple RasterizerCacheOpenGL::GetSurfaceSubRect(const SurfaceParams&
         surface = FindMatch<MatchFlags::SubRect | MatchFlags::Invalid>(surface_cache, params,
                                                                        ScaleMatch::Ignore);
         if (surface != nullptr) {
+            Common::Metrics::Increment(miss_counter);
             ASSERT(surface->res_scale < params.res_scale);
             SurfaceParams new_params = *surface;
             new_params.res_scale = params.res_scale;
@@ -1316,6 +1425,7 @@ SurfaceRect_Tuple RasterizerCacheOpenGL::GetSurfaceSubRect(const SurfaceParams&
         surface = FindMatch<MatchFlags::Expand | MatchFlags::Invalid>(surface_cache, aligned_params,
                                                                       match_res_scale);
         if (surface != nullptr) {
+            Common::Metrics::Increment(miss_counter);
             aligned_params.width = aligned_params.stride;
             aligned_params.UpdateParams();
 
@@ -1362,6 +1472,87 @@ Surface RasterizerCacheOpenGL::GetTextureSurface(
     return GetTextureSurface(info, config.config.lod.max_level);
 }
 
+static const Common::Metrics::CounterId prefetch_counter =
+    Common::Metrics::RegisterCounter("rasterizer_cache.texture_prefetches");
+void RasterizerCacheOpenGL::PrefetchTexture(const Pica::TexturingRegs::FullTextureConfig& config) {
+    Common::ThreadPool* const worker_pool = VideoCore::GetWorkerPool();
+    if (worker_pool == nullptr) {
+        return;
+    }
+
+    const Pica::Texture::TextureInfo info =
+        Pica::Texture::TextureInfo::FromPicaRegister(config.config, config.format);
+    SurfaceParams params;
+    params.addr = info.physical_address;
+    params.width = info.width;
+    params.height = info.height;
+    params.is_tiled = true;
+    params.pixel_format = SurfaceParams::PixelFormatFromTextureFormat(info.format);
+    if (params.addr == 0 || params.pixel_format == PixelFormat::Invalid || params.width == 0 ||
+        params.height == 0 || params.width % 8 != 0 || params.height % 8 != 0) {
+        return;
+    }
+    params.UpdateParams();
+
+    // Skip textures that are being decoded already, that are loaded and valid, or that have newer
+    // data on the GPU than in memory
+    const bool is_pending = std::any_of(
+        pending_decodes.begin(), pending_decodes.end(),
+        [&params](const PendingDecode& pending) { return pending.params.ExactMatch(params); });
+    if (is_pending ||
+        FindMatch<MatchFlags::Exact>(surface_cache, params, ScaleMatch::Ignore) != nullptr ||
+        !RangeFromInterval(dirty_regions, params.GetInterval()).empty()) {
+        return;
+    }
+
+    if (pending_decodes.size() >= MAX_PENDING_DECODES) {
+        // Make room by dropping finished decodes that were never used
+        pending_decodes.erase(
+            std::remove_if(pending_decodes.begin(), pending_decodes.end(),
+                           [](const PendingDecode& pending) {
+                               return pending.result.wait_for(std::chrono::seconds(0)) ==
+                                      std::future_status::ready;
+                           }),
+            pending_decodes.end());
+        if (pending_decodes.size() >= MAX_PENDING_DECODES) {
+            return;
+        }
+    }
+
+    Memory::MemorySystem& memory = VideoCore::GetMemory();
+    const u8* const source = memory.GetPhysicalPointer(params.addr);
+    if (source == nullptr ||
+        memory.GetPhysicalPointer(params.end - 1) != source + params.size - 1) {
+        return;
+    }
+
+    // The worker decodes a copy, as the CPU may write to the texture in the meantime. The result
+    // is discarded when the memory no longer matches the copy at the time the texture is loaded.
+    Common::Metrics::Increment(prefetch_counter);
+    auto result = worker_pool->Submit(
+        [params, snapshot = MemorySnapshot(params.addr, source, params.size)]() mutable {
+            DecodedTexture decoded;
+            decoded.content_hash = snapshot.ComputeHash();
+            decoded.gl_buffer = DecodeTiledSurface(snapshot, params);
+            return decoded;
+        });
+    pending_decodes.push_back({params, std::move(result)});
+}
+
+std::optional<RasterizerCacheOpenGL::DecodedTexture> RasterizerCacheOpenGL::TakePendingDecode(
+    const SurfaceParams& params) {
+    const auto iter = std::find_if(
+        pending_decodes.begin(), pending_decodes.end(),
+        [&params](const PendingDecode& pending) { return pending.params.ExactMatch(params); });
+    if (iter == pending_decodes.end()) {
+        return std::nullopt;
+    }
+
+    std::future<DecodedTexture> result = std::move(iter->result);
+    pending_decodes.erase(iter);
+    return result.get();
+}
+
 Surface RasterizerCacheOpenGL::GetTextureSurface(const Pica::Texture::TextureInfo& info,
                                                  u32 max_level) {
     if (info.physical_address == 0) {
@@ -1566,7 +1757,7 @@ const CachedTextureCube& RasterizerCacheOpenGL::GetTextureCube(const TextureCube
 
 SurfaceSurfaceRect_Tuple RasterizerCacheOpenGL::GetFramebufferSurfaces(
     bool using_color_fb, bool using_depth_fb, const Common::Rectangle<s32>& viewport_rect) {
-    const auto& regs = Pica::g_state.regs;
+    const auto& regs = Pica::GetState().regs;
     const auto& config = regs.framebuffer.framebuffer;
 
     // update resolution_scale_factor and reset cache if changed
@@ -1713,6 +1904,7 @@ void RasterizerCacheOpenGL::DuplicateSurface(const Surface& src_surface,
 
     dest_surface->invalid_regions -= src_surface->GetInterval();
     dest_surface->invalid_regions += src_surface->invalid_regions;
+    dest_surface->loaded_content_hash.reset();
 
     SurfaceRegions regions;
     for (auto& pair : RangeFromInterval(dirty_regions, src_surface->GetInterval())) {
@@ -1725,6 +1917,12 @@ void RasterizerCacheOpenGL::DuplicateSurface(const Surface& src_surface,
     }
 }
 
+static const Common::Metrics::CounterId content_hash_hit_counter =
+    Common::Metrics::RegisterCounter("rasterizer_cache.content_hash_hits");
+static const Common::Metrics::CounterId content_hash_miss_counter =
+    Common::Metrics::RegisterCounter("rasterizer_cache.content_hash_misses");
+static const Common::Metrics::CounterId prefetch_hit_counter =
+    Common::Metrics::RegisterCounter("rasterizer_cache.texture_prefetch_hits");
 void RasterizerCacheOpenGL::ValidateSurface(const Surface& surface, PAddr addr, u32 size) {
     if (size == 0)
         return;
@@ -1752,6 +1950,7 @@ void RasterizerCacheOpenGL::ValidateSurface(const Surface& surface, PAddr addr,
             SurfaceInterval copy_interval = params.GetCopyableInterval(copy_surface);
             CopySurface(copy_surface, surface, copy_interval);
             surface->invalid_regions.erase(copy_interval);
+            surface->loaded_content_hash.reset();
             continue;
         }
 
@@ -1772,16 +1971,53 @@ void RasterizerCacheOpenGL::ValidateSurface(const Surface& surface, PAddr addr,
                                    surface->texture.handle, dest_rect);
 
                 surface->invalid_regions.erase(convert_interval);
+                surface->loaded_content_hash.reset();
                 continue;
             }
         }
 
         // Load data from 3DS memory
+        const bool loads_whole_surface = params.GetInterval() == surface->GetInterval();
+
+        // Take any background decode of the surface, so that an unused one does not linger
+        std::optional<DecodedTexture> prefetched;
+        if (loads_whole_surface && surface->is_tiled) {
+            prefetched = TakePendingDecode(*surface);
+        }
+
         FlushRegion(params.addr, params.size);
-        surface->LoadGLBuffer(params.addr, params.end);
+
+        // Games often rewrite textures with the bytes they already hold. If the memory of the
+        // whole surface is unchanged since it was loaded, the texture is still up to date.
+        std::optional<u64> content_hash;
+        const bool memory_up_to_date =
+            RangeFromInterval(dirty_regions, surface->GetInterval()).empty();
+        if (surface->loaded_content_hash && memory_up_to_date) {
+            content_hash = surface->ComputeContentHash();
+            if (content_hash == surface->loaded_content_hash) {
+                Common::Metrics::Increment(content_hash_hit_counter);
+                surface->invalid_regions.erase(surface->GetInterval());
+                continue;
+            }
+            Common::Metrics::Increment(content_hash_miss_counter);
+        }
+
+        if (loads_whole_surface && !content_hash) {
+            content_hash = surface->ComputeContentHash();
+        }
+
+        if (prefetched && prefetched->content_hash == content_hash) {
+            Common::Metrics::Increment(prefetch_hit_counter);
+            surface->gl_buffer = std::move(prefetched->gl_buffer);
+            surface->gl_buffer_size = surface->width * surface->height *
+                                      CachedSurface::GetGLBytesPerPixel(surface->pixel_format);
+        } else {
+            surface->LoadGLBuffer(params.addr, params.end);
+        }
         surface->UploadGLTexture(surface->GetSubRect(params), read_framebuffer.handle,
                                  draw_framebuffer.handle);
         surface->invalid_regions.erase(params.GetInterval());
+        surface->loaded_content_hash = loads_whole_surface ? content_hash : std::nullopt;
     }
 }
 
@@ -1833,6 +2069,7 @@ void RasterizerCacheOpenGL::InvalidateRegion(PAddr addr, u32 size, const Surface
         // Surfaces can't have a gap
         ASSERT(region_owner->width == region_owner->stride);
         region_owner->invalid_regions.erase(invalid_interval);
+        region_owner->loaded_content_hash.reset();
     }
 
     for (auto& pair : RangeFromInterval(surface_cache, invalid_interval)) {
@@ -1936,10 +2173,10 @@ void RasterizerCacheOpenGL::UpdatePagesCachedCount(PAddr addr, u32 size, int del
         const u32 interval_size = interval_end_addr - interval_start_addr;
 
         if (delta > 0 && count == delta)
-            VideoCore::g_memory->RasterizerMarkRegionCached(interval_start_addr, interval_size,
+            VideoCore::GetMemory().RasterizerMarkRegionCached(interval_start_addr, interval_size,
                                                             true);
         else if (delta < 0 && count == -delta)
-            VideoCore::g_memory->RasterizerMarkRegionCached(interval_start_addr, interval_size,
+            VideoCore::GetMemory().RasterizerMarkRegionCached(interval_start_addr, interval_size,
                                                             false);
         else
             ASSERT(count >= 0);
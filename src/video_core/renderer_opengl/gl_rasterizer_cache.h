@@ -5,10 +5,13 @@
 #pragma once
 
 #include <array>
+#include <future>
 #include <list>
 #include <memory>
+#include <optional>
 #include <set>
 #include <tuple>
+#include <vector>
 #ifdef __GNUC__
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wunused-local-typedefs"
@@ -373,6 +376,13 @@ struct CachedSurface : SurfaceParams, std::enable_shared_from_this<CachedSurface
     std::unique_ptr<u8[]> gl_buffer;
     std::size_t gl_buffer_size = 0;
 
+    /// Hash of the guest memory the whole surface was last loaded from, as long as its texture has
+    /// not been changed in any other way since
+    std::optional<u64> loaded_content_hash;
+
+    /// Hashes the guest memory backing the surface, if it is mapped
+    std::optional<u64> ComputeContentHash() const;
+
     // Read/Write data in 3DS memory to/from gl_buffer
     void LoadGLBuffer(PAddr load_start, PAddr load_end);
     void FlushGLBuffer(PAddr flush_start, PAddr flush_end);
@@ -451,6 +461,12 @@ public:
     Surface GetTextureSurface(const Pica::TexturingRegs::FullTextureConfig& config);
     Surface GetTextureSurface(const Pica::Texture::TextureInfo& info, u32 max_level = 0);
 
+    /**
+     * Starts decoding the texture of the configuration on the video worker pool, so that it is
+     * ready by the time a draw uses it. Does nothing if the texture doesn't need to be loaded.
+     */
+    void PrefetchTexture(const Pica::TexturingRegs::FullTextureConfig& config);
+
     /// Get a texture cube based on the texture configuration
     const CachedTextureCube& GetTextureCube(const TextureCubeConfig& config);
 
@@ -479,6 +495,21 @@ private:
     /// Update surface's texture for given region when necessary
     void ValidateSurface(const Surface& surface, PAddr addr, u32 size);
 
+    /// A whole texture decoded by a worker, laid out like CachedSurface::gl_buffer
+    struct DecodedTexture {
+        std::unique_ptr<u8[]> gl_buffer;
+        /// Hash of the copy of the texture data that was decoded
+        u64 content_hash;
+    };
+
+    struct PendingDecode {
+        SurfaceParams params;
+        std::future<DecodedTexture> result;
+    };
+
+    /// Removes the background decode of the given surface from the queue and waits for it
+    std::optional<DecodedTexture> TakePendingDecode(const SurfaceParams& params);
+
     /// Create a new surface
     Surface CreateSurface(const SurfaceParams& params);
 
@@ -507,5 +538,9 @@ private:
     GLint d24s8_abgr_viewport_u_id;
 
     std::unordered_map<TextureCubeConfig, CachedTextureCube> texture_cube_cache;
+
+    /// Maximum number of textures decoded in the background at a time
+    static constexpr std::size_t MAX_PENDING_DECODES = 16;
+    std::vector<PendingDecode> pending_decodes;
 };
 } // namespace OpenGL
@@ -0,0 +1,133 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include <cstdio>
+#include <cstring>
+#include <fmt/format.h>
+#include "common/common_paths.h"
+#include "common/hash.h"
+#include "common/logging/log.h"
+#include "common/scm_rev.h"
+#include "video_core/renderer_opengl/gl_shader_disk_cache.h"
+
+namespace OpenGL {
+
+namespace {
+
+constexpr u32 FILE_MAGIC = 0x43445343; // "CSDC"
+/// Increase this when the layout of the file or of a shader configuration changes
+constexpr u32 FILE_VERSION = 1;
+
+/// Limits used to reject entries that can only come from a corrupted file
+constexpr u32 MAX_KEY_SIZE = 0x10000;
+constexpr u32 MAX_CODE_SIZE = 0x1000000;
+
+struct FileHeader {
+    u32 magic;
+    u32 version;
+    u64 build_hash;
+};
+
+struct EntryHeader {
+    ShaderDiskCacheType type;
+    u32 key_size;
+    u32 code_size;
+};
+
+FileHeader GetCurrentHeader() {
+    return {FILE_MAGIC, FILE_VERSION,
+            Common::ComputeHash64(Common::g_scm_rev, std::strlen(Common::g_scm_rev))};
+}
+
+} // Anonymous namespace
+
+ShaderDiskCache::ShaderDiskCache(u64 program_id)
+    : path(fmt::format("{}{}" DIR_SEP "{:016X}.bin",
+                       FileUtil::GetUserPath(FileUtil::UserPath::CacheDir), SHADER_CACHE_DIR,
+                       program_id)) {
+    load_result = std::async(std::launch::async, [this] { return Load(); });
+}
+
+ShaderDiskCache::~ShaderDiskCache() {
+    if (load_result.valid()) {
+        load_result.wait();
+    }
+}
+
+ShaderDiskCache::LoadResult ShaderDiskCache::Load() const {
+    LoadResult result;
+
+    FileUtil::IOFile input(path, "rb");
+    if (!input.IsOpen()) {
+        return result;
+    }
+
+    const FileHeader expected_header = GetCurrentHeader();
+    FileHeader header;
+    if (input.ReadBytes(&header, sizeof(header)) != sizeof(header) ||
+        std::memcmp(&header, &expected_header, sizeof(header)) != 0) {
+        LOG_INFO(Render_OpenGL, "Shader disk cache {} is outdated, discarding it", path);
+        return result;
+    }
+    result.valid_size = input.Tell();
+
+    const u64 file_size = input.GetSize();
+    EntryHeader entry_header;
+    while (input.ReadBytes(&entry_header, sizeof(entry_header)) == sizeof(entry_header)) {
+        if (entry_header.key_size > MAX_KEY_SIZE || entry_header.code_size > MAX_CODE_SIZE ||
+            input.Tell() + entry_header.key_size + entry_header.code_size > file_size) {
+            break;
+        }
+
+        ShaderDiskCacheEntry entry;
+        entry.type = entry_header.type;
+        entry.key.resize(entry_header.key_size);
+        entry.code.resize(entry_header.code_size);
+        if (input.ReadBytes(entry.key.data(), entry.key.size()) != entry.key.size() ||
+            input.ReadBytes(entry.code.data(), entry.code.size()) != entry.code.size()) {
+            break;
+        }
+
+        result.entries.push_back(std::move(entry));
+        result.valid_size = input.Tell();
+    }
+
+    LOG_INFO(Render_OpenGL, "Loaded {} shaders from disk cache {}", result.entries.size(), path);
+    return result;
+}
+
+std::vector<ShaderDiskCacheEntry> ShaderDiskCache::TakeEntries() {
+    LoadResult result = load_result.get();
+
+    // Continue after the last complete entry, dropping anything a previous session left behind
+    // half-written.
+    if (result.valid_size != 0 && file.Open(path, "r+b") && file.Resize(result.valid_size) &&
+        file.Seek(0, SEEK_END)) {
+        return std::move(result.entries);
+    }
+
+    FileUtil::CreateFullPath(path);
+    if (file.Open(path, "wb")) {
+        file.WriteObject(GetCurrentHeader());
+    } else {
+        LOG_ERROR(Render_OpenGL, "Failed to create shader disk cache {}", path);
+    }
+    return {};
+}
+
+void ShaderDiskCache::Append(ShaderDiskCacheType type, const void* key, std::size_t key_size,
+                             const std::string& code) {
+    if (!file.IsOpen()) {
+        return;
+    }
+
+    const EntryHeader entry_header{type, static_cast<u32>(key_size),
+                                   static_cast<u32>(code.size())};
+    file.WriteObject(entry_header);
+    file.WriteBytes(static_cast<const u8*>(key), key_size);
+    file.WriteString(code);
+    file.Flush();
+}
+
+} // namespace OpenGL
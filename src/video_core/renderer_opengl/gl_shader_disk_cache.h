@@ -0,0 +1,67 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <cstddef>
+#include <future>
+#include <string>
+#include <vector>
+#include "common/common_types.h"
+#include "common/file_util.h"
+
+namespace OpenGL {
+
+/// Kind of shader an entry of the disk cache belongs to, which determines its key type
+enum class ShaderDiskCacheType : u32 {
+    ProgrammableVertex = 0,
+    FixedGeometry = 1,
+    ProgrammableGeometry = 2,
+    Fragment = 3,
+};
+
+struct ShaderDiskCacheEntry {
+    ShaderDiskCacheType type;
+    std::vector<u8> key; ///< Raw bytes of the shader configuration state
+    std::string code;    ///< Generated GLSL source code
+};
+
+/**
+ * A per-title file storing the configuration and generated GLSL code of every shader the OpenGL
+ * rasterizer has created, so that later sessions can compile them before they are first needed.
+ * Entries are only ever appended. The file is discarded whenever the emulator build changes, as
+ * the generated code might differ between builds.
+ */
+class ShaderDiskCache {
+public:
+    /// Starts loading the cache file of the given title on a background thread, which runs until
+    /// the entries are taken
+    explicit ShaderDiskCache(u64 program_id);
+    ~ShaderDiskCache();
+
+    /**
+     * Returns the entries stored by previous sessions, blocking until the background load has
+     * finished. Must be called once before appending new entries, which are dropped until then.
+     */
+    std::vector<ShaderDiskCacheEntry> TakeEntries();
+
+    /// Appends the configuration and code of a newly generated shader to the file
+    void Append(ShaderDiskCacheType type, const void* key, std::size_t key_size,
+                const std::string& code);
+
+private:
+    struct LoadResult {
+        std::vector<ShaderDiskCacheEntry> entries;
+        /// Size of the valid part of the file, or 0 if it has to be recreated
+        u64 valid_size = 0;
+    };
+
+    LoadResult Load() const;
+
+    std::string path;
+    std::future<LoadResult> load_result;
+    FileUtil::IOFile file;
+};
+
+} // namespace OpenGL
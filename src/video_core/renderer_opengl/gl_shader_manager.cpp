@@ -3,9 +3,13 @@
 // Refer to the license.txt file included.
 
 #include <algorithm>
+#include <cstring>
+#include <optional>
 #include <unordered_map>
 #include <boost/functional/hash.hpp>
 #include <boost/variant.hpp>
+#include "common/logging/log.h"
+#include "video_core/renderer_opengl/gl_shader_disk_cache.h"
 #include "video_core/renderer_opengl/gl_shader_manager.h"
 
 namespace OpenGL {
@@ -139,8 +143,19 @@ private:
     OGLShaderStage program;
 };
 
+/// Rebuilds a shader configuration from the raw bytes stored in the disk cache
+template <typename KeyConfigType>
+static std::optional<KeyConfigType> ConfigFromDiskCacheKey(const std::vector<u8>& key) {
+    KeyConfigType config;
+    if (key.size() != sizeof(config.state)) {
+        return std::nullopt;
+    }
+    std::memcpy(&config.state, key.data(), key.size());
+    return config;
+}
+
 template <typename KeyConfigType, std::string (*CodeGenerator)(const KeyConfigType&, bool),
-          GLenum ShaderType>
+          GLenum ShaderType, ShaderDiskCacheType DiskCacheType>
 class ShaderCache {
 public:
     explicit ShaderCache(bool separable) : separable(separable) {}
@@ -148,13 +163,30 @@ public:
         auto [iter, new_shader] = shaders.emplace(config, OGLShaderStage{separable});
         OGLShaderStage& cached_shader = iter->second;
         if (new_shader) {
-            cached_shader.Create(CodeGenerator(config, separable).c_str(), ShaderType);
+            const std::string code = CodeGenerator(config, separable);
+            cached_shader.Create(code.c_str(), ShaderType);
+            if (disk_cache) {
+                disk_cache->Append(DiskCacheType, &config.state, sizeof(config.state), code);
+            }
         }
         return cached_shader.GetHandle();
     }
 
+    /// Compiles a shader stored by a previous session
+    void Inject(const KeyConfigType& config, const std::string& code) {
+        auto [iter, new_shader] = shaders.emplace(config, OGLShaderStage{separable});
+        if (new_shader) {
+            iter->second.Create(code.c_str(), ShaderType);
+        }
+    }
+
+    void SetDiskCache(ShaderDiskCache* disk_cache_) {
+        disk_cache = disk_cache_;
+    }
+
 private:
     bool separable;
+    ShaderDiskCache* disk_cache = nullptr;
     std::unordered_map<KeyConfigType, OGLShaderStage> shaders;
 };
 
@@ -166,7 +198,7 @@ private:
 template <typename KeyConfigType,
           std::optional<std::string> (*CodeGenerator)(const Pica::Shader::ShaderSetup&,
                                                       const KeyConfigType&, bool),
-          GLenum ShaderType>
+          GLenum ShaderType, ShaderDiskCacheType DiskCacheType>
 class ShaderDoubleCache {
 public:
     explicit ShaderDoubleCache(bool separable) : separable(separable) {}
@@ -180,13 +212,10 @@ public:
             }
 
             std::string& program = *program_opt;
-            auto [iter, new_shader] = shader_cache.emplace(program, OGLShaderStage{separable});
-            OGLShaderStage& cached_shader = iter->second;
-            if (new_shader) {
-                cached_shader.Create(program.c_str(), ShaderType);
+            if (disk_cache) {
+                disk_cache->Append(DiskCacheType, &key.state, sizeof(key.state), program);
             }
-            shader_map[key] = &cached_shader;
-            return cached_shader.GetHandle();
+            return Inject(key, program);
         }
 
         if (map_it->second == nullptr) {
@@ -196,22 +225,42 @@ public:
         return map_it->second->GetHandle();
     }
 
+    /// Compiles a shader, or reuses one with identical code, and assigns it to the given key
+    GLuint Inject(const KeyConfigType& key, const std::string& program) {
+        auto [iter, new_shader] = shader_cache.emplace(program, OGLShaderStage{separable});
+        OGLShaderStage& cached_shader = iter->second;
+        if (new_shader) {
+            cached_shader.Create(program.c_str(), ShaderType);
+        }
+        shader_map[key] = &cached_shader;
+        return cached_shader.GetHandle();
+    }
+
+    void SetDiskCache(ShaderDiskCache* disk_cache_) {
+        disk_cache = disk_cache_;
+    }
+
 private:
     bool separable;
+    ShaderDiskCache* disk_cache = nullptr;
     std::unordered_map<KeyConfigType, OGLShaderStage*> shader_map;
     std::unordered_map<std::string, OGLShaderStage> shader_cache;
 };
 
 using ProgrammableVertexShaders =
-    ShaderDoubleCache<PicaVSConfig, &GenerateVertexShader, GL_VERTEX_SHADER>;
+    ShaderDoubleCache<PicaVSConfig, &GenerateVertexShader, GL_VERTEX_SHADER,
+                      ShaderDiskCacheType::ProgrammableVertex>;
 
 using ProgrammableGeometryShaders =
-    ShaderDoubleCache<PicaGSConfig, &GenerateGeometryShader, GL_GEOMETRY_SHADER>;
+    ShaderDoubleCache<PicaGSConfig, &GenerateGeometryShader, GL_GEOMETRY_SHADER,
+                      ShaderDiskCacheType::ProgrammableGeometry>;
 
 using FixedGeometryShaders =
-    ShaderCache<PicaFixedGSConfig, &GenerateFixedGeometryShader, GL_GEOMETRY_SHADER>;
+    ShaderCache<PicaFixedGSConfig, &GenerateFixedGeometryShader, GL_GEOMETRY_SHADER,
+                ShaderDiskCacheType::FixedGeometry>;
 
-using FragmentShaders = ShaderCache<PicaFSConfig, &GenerateFragmentShader, GL_FRAGMENT_SHADER>;
+using FragmentShaders = ShaderCache<PicaFSConfig, &GenerateFragmentShader, GL_FRAGMENT_SHADER,
+                                    ShaderDiskCacheType::Fragment>;
 
 class ShaderProgramManager::Impl {
 public:
@@ -262,6 +311,71 @@ public:
     bool separable;
     std::unordered_map<ShaderTuple, OGLProgram, ShaderTuple::Hash> program_cache;
     OGLPipeline pipeline;
+
+    std::unique_ptr<ShaderDiskCache> disk_cache;
+    /// Whether the shaders stored by previous sessions have yet to be compiled
+    bool disk_cache_pending = false;
+
+    /**
+     * Compiles the shaders stored by previous sessions when the first shader is requested, which
+     * gives the disk cache the rest of the boot to load in the background
+     */
+    void CompilePendingDiskCache() {
+        if (disk_cache_pending) {
+            disk_cache_pending = false;
+            CompileDiskCacheEntries();
+        }
+    }
+
+private:
+    /// Compiles the shaders stored by previous sessions
+    void CompileDiskCacheEntries() {
+        const auto entries = disk_cache->TakeEntries();
+        std::size_t num_compiled = 0;
+        for (const auto& entry : entries) {
+            if (CompileDiskCacheEntry(entry)) {
+                ++num_compiled;
+            } else {
+                LOG_WARNING(Render_OpenGL, "Skipping invalid shader disk cache entry");
+            }
+        }
+        LOG_INFO(Render_OpenGL, "Compiled {} shaders from the disk cache", num_compiled);
+
+        programmable_vertex_shaders.SetDiskCache(disk_cache.get());
+        programmable_geometry_shaders.SetDiskCache(disk_cache.get());
+        fixed_geometry_shaders.SetDiskCache(disk_cache.get());
+        fragment_shaders.SetDiskCache(disk_cache.get());
+    }
+
+    bool CompileDiskCacheEntry(const ShaderDiskCacheEntry& entry) {
+        switch (entry.type) {
+        case ShaderDiskCacheType::ProgrammableVertex:
+            if (const auto config = ConfigFromDiskCacheKey<PicaVSConfig>(entry.key)) {
+                programmable_vertex_shaders.Inject(*config, entry.code);
+                return true;
+            }
+            break;
+        case ShaderDiskCacheType::ProgrammableGeometry:
+            if (const auto config = ConfigFromDiskCacheKey<PicaGSConfig>(entry.key)) {
+                programmable_geometry_shaders.Inject(*config, entry.code);
+                return true;
+            }
+            break;
+        case ShaderDiskCacheType::FixedGeometry:
+            if (const auto config = ConfigFromDiskCacheKey<PicaFixedGSConfig>(entry.key)) {
+                fixed_geometry_shaders.Inject(*config, entry.code);
+                return true;
+            }
+            break;
+        case ShaderDiskCacheType::Fragment:
+            if (const auto config = ConfigFromDiskCacheKey<PicaFSConfig>(entry.key)) {
+                fragment_shaders.Inject(*config, entry.code);
+                return true;
+            }
+            break;
+        }
+        return false;
+    }
 };
 
 ShaderProgramManager::ShaderProgramManager(bool separable, bool is_amd)
@@ -269,8 +383,14 @@ ShaderProgramManager::ShaderProgramManager(bool separable, bool is_amd)
 
 ShaderProgramManager::~ShaderProgramManager() = default;
 
+void ShaderProgramManager::LoadDiskCache(u64 program_id) {
+    impl->disk_cache = std::make_unique<ShaderDiskCache>(program_id);
+    impl->disk_cache_pending = true;
+}
+
 bool ShaderProgramManager::UseProgrammableVertexShader(const PicaVSConfig& config,
                                                        const Pica::Shader::ShaderSetup setup) {
+    impl->CompilePendingDiskCache();
     GLuint handle = impl->programmable_vertex_shaders.Get(config, setup);
     if (handle == 0)
         return false;
@@ -284,6 +404,7 @@ void ShaderProgramManager::UseTrivialVertexShader() {
 
 bool ShaderProgramManager::UseProgrammableGeometryShader(const PicaGSConfig& config,
                                                          const Pica::Shader::ShaderSetup setup) {
+    impl->CompilePendingDiskCache();
     GLuint handle = impl->programmable_geometry_shaders.Get(config, setup);
     if (handle == 0)
         return false;
@@ -292,6 +413,7 @@ bool ShaderProgramManager::UseProgrammableGeometryShader(const PicaGSConfig& con
 }
 
 void ShaderProgramManager::UseFixedGeometryShader(const PicaFixedGSConfig& config) {
+    impl->CompilePendingDiskCache();
     impl->current.gs = impl->fixed_geometry_shaders.Get(config);
 }
 
@@ -300,6 +422,7 @@ void ShaderProgramManager::UseTrivialGeometryShader() {
 }
 
 void ShaderProgramManager::UseFragmentShader(const PicaFSConfig& config) {
+    impl->CompilePendingDiskCache();
     impl->current.fs = impl->fragment_shaders.Get(config);
 }
 
@@ -106,6 +106,13 @@ public:
     ShaderProgramManager(bool separable, bool is_amd);
     ~ShaderProgramManager();
 
+    /**
+     * Starts loading the shaders stored on disk by previous sessions of the given title in the
+     * background. They are all compiled when the first shader is requested, so that none of them
+     * has to be compiled during gameplay. New shaders are stored to the same cache.
+     */
+    void LoadDiskCache(u64 program_id);
+
     bool UseProgrammableVertexShader(const PicaVSConfig& config,
                                      const Pica::Shader::ShaderSetup setup);
 
@@ -10,7 +10,7 @@
 
 namespace OpenGL {
 
-OpenGLState OpenGLState::cur_state;
+thread_local OpenGLState OpenGLState::cur_state;
 
 OpenGLState::OpenGLState() {
     // These all match default OpenGL values
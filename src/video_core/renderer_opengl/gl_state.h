@@ -164,7 +164,8 @@ public:
     OpenGLState& ResetFramebuffer(GLuint handle);
 
 private:
-    static OpenGLState cur_state;
+    /// State of the GL context current on the calling thread, as each console renders on its own
+    static thread_local OpenGLState cur_state;
 };
 
 } // namespace OpenGL
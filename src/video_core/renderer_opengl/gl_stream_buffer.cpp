@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
 #include <deque>
 #include <vector>
 #include "common/alignment.h"
@@ -12,6 +13,7 @@
 
 MICROPROFILE_DEFINE(OpenGL_StreamBuffer, "OpenGL", "Stream Buffer Orphaning",
                     MP_RGB(128, 128, 192));
+MICROPROFILE_DEFINE(OpenGL_StreamBufferWait, "OpenGL", "Stream Buffer Wait", MP_RGB(128, 128, 192));
 
 namespace OpenGL {
 
@@ -45,6 +47,11 @@ OGLStreamBuffer::OGLStreamBuffer(GLenum target, GLsizeiptr size, bool array_buff
 }
 
 OGLStreamBuffer::~OGLStreamBuffer() {
+    for (GLsync fence : fences) {
+        if (fence != nullptr) {
+            glDeleteSync(fence);
+        }
+    }
     if (persistent) {
         glBindBuffer(gl_target, gl_buffer.handle);
         glUnmapBuffer(gl_target);
@@ -75,14 +82,21 @@ std::tuple<u8*, GLintptr, bool> OGLStreamBuffer::Map(GLsizeiptr size, GLintptr a
         invalidate = true;
 
         if (persistent) {
-            glUnmapBuffer(gl_target);
+            // The buffer stays mapped, so the GPU has to be done with a region before it is reused
+            FenceRegions(waited_regions);
+            fenced_regions = 0;
+            waited_regions = 0;
         }
     }
 
-    if (invalidate || !persistent) {
+    if (persistent) {
+        // Everything before the new chunk belongs to chunks whose commands have been issued. Later
+        // commands must not read from a fenced region, or it could be reused while they run.
+        invalidate |= FenceRegions(GetRegion(buffer_pos));
+        WaitForRegions(GetRegion(buffer_pos + std::max<GLsizeiptr>(size, 1) - 1));
+    } else {
         MICROPROFILE_SCOPE(OpenGL_StreamBuffer);
-        GLbitfield flags = GL_MAP_WRITE_BIT | (persistent ? GL_MAP_PERSISTENT_BIT : 0) |
-                           (coherent ? GL_MAP_COHERENT_BIT : GL_MAP_FLUSH_EXPLICIT_BIT) |
+        GLbitfield flags = GL_MAP_WRITE_BIT | GL_MAP_FLUSH_EXPLICIT_BIT |
                            (invalidate ? GL_MAP_INVALIDATE_BUFFER_BIT : GL_MAP_UNSYNCHRONIZED_BIT);
         mapped_ptr = static_cast<u8*>(
             glMapBufferRange(gl_target, buffer_pos, buffer_size - buffer_pos, flags));
@@ -106,4 +120,39 @@ void OGLStreamBuffer::Unmap(GLsizeiptr size) {
     buffer_pos += size;
 }
 
+std::size_t OGLStreamBuffer::GetRegion(GLintptr offset) const {
+    return std::min(static_cast<std::size_t>(offset * NUM_SYNC_REGIONS / buffer_size),
+                    NUM_SYNC_REGIONS - 1);
+}
+
+bool OGLStreamBuffer::FenceRegions(std::size_t end_region) {
+    // Regions that haven't been waited on yet still hold the fence of the previous pass
+    end_region = std::min(end_region, waited_regions);
+    if (fenced_regions >= end_region) {
+        return false;
+    }
+
+    for (; fenced_regions < end_region; ++fenced_regions) {
+        ASSERT(fences[fenced_regions] == nullptr);
+        fences[fenced_regions] = glFenceSync(GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    }
+    return true;
+}
+
+void OGLStreamBuffer::WaitForRegions(std::size_t end_region) {
+    for (; waited_regions <= end_region; ++waited_regions) {
+        GLsync& fence = fences[waited_regions];
+        if (fence == nullptr) {
+            continue;
+        }
+
+        MICROPROFILE_SCOPE(OpenGL_StreamBufferWait);
+        while (glClientWaitSync(fence, GL_SYNC_FLUSH_COMMANDS_BIT, 1000000000) ==
+               GL_TIMEOUT_EXPIRED) {
+        }
+        glDeleteSync(fence);
+        fence = nullptr;
+    }
+}
+
 } // namespace OpenGL
@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
 #include <tuple>
 #include <glad/glad.h>
 #include "common/common_types.h"
@@ -23,16 +25,37 @@ public:
     /*
      * Allocates a linear chunk of memory in the GPU buffer with at least "size" bytes
      * and the optional alignment requirement.
-     * If the buffer is full, the whole buffer is reallocated which invalidates old chunks.
+     * If the buffer is full, writing starts over at its beginning, which invalidates old chunks.
+     * A persistent buffer also invalidates them when writing moves on to a new region, since the
+     * fence of the region they are in only covers the commands issued so far. Data that later
+     * commands read from a previous chunk then has to be uploaded again.
      * The return values are the pointer to the new chunk, the offset within the buffer,
      * and the invalidation flag for previous chunks.
-     * The actual used size must be specified on unmapping the chunk.
+     * The actual used size must be specified on unmapping the chunk, and the commands reading a
+     * chunk must be issued before the next one is mapped.
      */
     std::tuple<u8*, GLintptr, bool> Map(GLsizeiptr size, GLintptr alignment = 0);
 
     void Unmap(GLsizeiptr size);
 
 private:
+    /**
+     * A persistent buffer is used as a ring split into this many regions. A fence is placed when
+     * writing moves past a region, and waited on before the region is written again.
+     */
+    static constexpr std::size_t NUM_SYNC_REGIONS = 3;
+
+    std::size_t GetRegion(GLintptr offset) const;
+
+    /**
+     * Places fences for the regions that have been written to since they were last fenced
+     * @return whether any fence was placed
+     */
+    bool FenceRegions(std::size_t end_region);
+
+    /// Waits until the GPU is done with the regions up to and including end_region
+    void WaitForRegions(std::size_t end_region);
+
     OGLBuffer gl_buffer;
     GLenum gl_target;
 
@@ -44,6 +67,12 @@ private:
     GLintptr mapped_offset = 0;
     GLsizeiptr mapped_size = 0;
     u8* mapped_ptr = nullptr;
+
+    std::array<GLsync, NUM_SYNC_REGIONS> fences{};
+    /// Regions before this one have been fenced since writing last started over
+    std::size_t fenced_regions = 0;
+    /// Regions before this one have been waited on since writing last started over
+    std::size_t waited_regions = 0;
 };
 
 } // namespace OpenGL
@@ -4,6 +4,8 @@
 
 #include <cmath>
 #include <cstring>
+#include <memory>
+#include <mutex>
 #include "common/bit_set.h"
 #include "common/logging/log.h"
 #include "common/microprofile.h"
@@ -134,17 +136,31 @@ void GSUnitState::ConfigOutput(const ShaderRegs& config) {
 
 MICROPROFILE_DEFINE(GPU_Shader, "GPU", "Shader", MP_RGB(50, 50, 240));
 
+static InterpreterEngine interpreter_engine;
+
 #ifdef ARCHITECTURE_x86_64
-static std::unique_ptr<JitX64Engine> jit_engine;
+/// Returns the JIT engine of the process, creating it if no console holds it anymore
+static std::shared_ptr<ShaderEngine> AcquireJitEngine() {
+    static std::mutex jit_engine_mutex;
+    static std::weak_ptr<ShaderEngine> jit_engine;
+
+    std::lock_guard lock{jit_engine_mutex};
+    std::shared_ptr<ShaderEngine> engine = jit_engine.lock();
+    if (engine == nullptr) {
+        engine = std::make_shared<JitX64Engine>();
+        jit_engine = engine;
+    }
+    return engine;
+}
 #endif // ARCHITECTURE_x86_64
-static InterpreterEngine interpreter_engine;
 
 ShaderEngine* GetEngine() {
 #ifdef ARCHITECTURE_x86_64
     // TODO(yuriks): Re-initialize on each change rather than being persistent
     if (VideoCore::g_shader_jit_enabled) {
+        auto& jit_engine = Core::System::GetInstance().VideoContext().shader_jit_engine;
         if (jit_engine == nullptr) {
-            jit_engine = std::make_unique<JitX64Engine>();
+            jit_engine = AcquireJitEngine();
         }
         return jit_engine.get();
     }
@@ -153,10 +169,4 @@ ShaderEngine* GetEngine() {
     return &interpreter_engine;
 }
 
-void Shutdown() {
-#ifdef ARCHITECTURE_x86_64
-    jit_engine = nullptr;
-#endif // ARCHITECTURE_x86_64
-}
-
 } // namespace Pica::Shader
@@ -254,10 +254,20 @@ public:
      * @param state Shader unit state, must be setup with input data before each shader invocation.
      */
     virtual void Run(const ShaderSetup& setup, UnitState& state) const = 0;
+
+    /**
+     * Runs the currently setup shader once for each unit state in an array. This is equivalent to
+     * calling Run on each of them, but allows the engine to share the per-invocation overhead.
+     *
+     * @param setup Shader engine state, must be setup with SetupBatch on each shader change.
+     * @param states Array of `count` shader unit states, each setup with input data.
+     * @param count Number of unit states in the array.
+     */
+    virtual void RunBatch(const ShaderSetup& setup, UnitState* states,
+                          std::size_t count) const = 0;
 };
 
-// TODO(yuriks): Remove and make it non-global state somewhere
+/// Returns the engine selected in the settings. Engines are shared by all consoles in the process.
 ShaderEngine* GetEngine();
-void Shutdown();
 
 } // namespace Pica::Shader
@@ -2,6 +2,7 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include "common/metrics.h"
 #include "common/microprofile.h"
 #include "video_core/shader/shader.h"
 #include "video_core/shader/shader_jit_x64.h"
@@ -9,6 +10,9 @@
 
 namespace Pica::Shader {
 
+static const Common::Metrics::CounterId compile_counter =
+    Common::Metrics::RegisterCounter("shader_jit.compiles");
+
 JitX64Engine::JitX64Engine() = default;
 JitX64Engine::~JitX64Engine() = default;
 
@@ -20,10 +24,12 @@ void JitX64Engine::SetupBatch(ShaderSetup& setup, unsigned int entry_point) {
     u64 swizzle_hash = setup.GetSwizzleDataHash();
 
     u64 cache_key = code_hash ^ swizzle_hash;
+    std::lock_guard lock{cache_mutex};
     auto iter = cache.find(cache_key);
     if (iter != cache.end()) {
         setup.engine_data.cached_shader = iter->second.get();
     } else {
+        Common::Metrics::Increment(compile_counter);
         auto shader = std::make_unique<JitShader>();
         shader->Compile(&setup.program_code, &setup.swizzle_data);
         setup.engine_data.cached_shader = shader.get();
@@ -42,4 +48,14 @@ void JitX64Engine::Run(const ShaderSetup& setup, UnitState& state) const {
     shader->Run(setup, state, setup.engine_data.entry_point);
 }
 
+void JitX64Engine::RunBatch(const ShaderSetup& setup, UnitState* states,
+                            std::size_t count) const {
+    ASSERT(setup.engine_data.cached_shader != nullptr);
+
+    MICROPROFILE_SCOPE(GPU_Shader);
+
+    const JitShader* shader = static_cast<const JitShader*>(setup.engine_data.cached_shader);
+    shader->RunBatch(setup, states, count, setup.engine_data.entry_point);
+}
+
 } // namespace Pica::Shader
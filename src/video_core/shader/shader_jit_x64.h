@@ -5,6 +5,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <unordered_map>
 #include "common/common_types.h"
 #include "video_core/shader/shader.h"
@@ -20,8 +21,12 @@ public:
 
     void SetupBatch(ShaderSetup& setup, unsigned int entry_point) override;
     void Run(const ShaderSetup& setup, UnitState& state) const override;
+    void RunBatch(const ShaderSetup& setup, UnitState* states,
+                  std::size_t count) const override;
 
 private:
+    /// Guards the cache, which consoles running on other threads may look up at the same time
+    std::mutex cache_mutex;
     std::unordered_map<u64, std::unique_ptr<JitShader>> cache;
 };
 
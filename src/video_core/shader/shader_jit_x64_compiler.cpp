@@ -118,6 +118,8 @@ static const Reg64 COND0 = r13;
 static const Reg64 COND1 = r14;
 /// Pointer to the UnitState instance for the current VS unit
 static const Reg64 STATE = r15;
+/// Number of unit states left to process in the current batch, only used between invocations
+static const Reg64 BATCH_COUNT = rbp;
 /// SIMD scratch register
 static const Xmm SCRATCH = xmm0;
 /// Loaded with the first swizzled source register, otherwise can be used as a scratch register
@@ -590,7 +592,7 @@ void JitShader::Compile_END(Instruction instr) {
     mov(dword[STATE + offsetof(UnitState, address_registers[1])], ADDROFFS_REG_1.cvt32());
     mov(dword[STATE + offsetof(UnitState, address_registers[2])], LOOPCOUNT_REG);
 
-    ABI_PopRegistersAndAdjustStack(*this, ABI_ALL_CALLEE_SAVED, 8, 16);
+    // Return to the invocation loop emitted by Compile
     ret();
 }
 
@@ -898,15 +900,38 @@ void JitShader::Compile(const std::array<u32, MAX_PROGRAM_CODE_LENGTH>* program_
     // Find all `CALL` instructions and identify return locations
     FindReturnOffsets();
 
-    // The stack pointer is 8 modulo 16 at the entry of a procedure
-    // We reserve 16 bytes and assign a dummy value to the first 8 bytes, to catch any potential
-    // return checks (see Compile_Return) that happen in shader main routine.
-    ABI_PushRegistersAndAdjustStack(*this, ABI_ALL_CALLEE_SAVED, 8, 16);
-    mov(qword[rsp + 8], 0xFFFFFFFFFFFFFFFFULL);
-
+    // The stack pointer is 8 modulo 16 at the entry of a procedure, and aligned to 16 after this
+    ABI_PushRegistersAndAdjustStack(*this, ABI_ALL_CALLEE_SAVED, 8);
+
+    // The shader program is called once per unit state, so that the register saving and constant
+    // setup above are shared by the whole batch. The main routine then runs with the stack laid
+    // out as follows, keeping it aligned to 16 bytes:
+    //   [rsp + 0]:  return address into the invocation loop
+    //   [rsp + 8]:  dummy value to catch any potential return checks (see Compile_Return) that
+    //               happen in shader main routine
+    //   [rsp + 32]: start address of the shader program, placed beyond the 32 bytes a callee may
+    //               use as shadow space on Windows
+    sub(rsp, 40);
+    mov(qword[rsp], 0xFFFFFFFFFFFFFFFFULL);
+    mov(qword[rsp + 24], ABI_PARAM4);
+
+    mov(BATCH_COUNT, ABI_PARAM3);
     mov(UNIFORMS, ABI_PARAM1);
     mov(STATE, ABI_PARAM2);
 
+    // Used to set a register to one
+    static const __m128 one = {1.f, 1.f, 1.f, 1.f};
+    mov(rax, reinterpret_cast<std::size_t>(&one));
+    movaps(ONE, xword[rax]);
+
+    // Used to negate registers
+    static const __m128 neg = {-0.f, -0.f, -0.f, -0.f};
+    mov(rax, reinterpret_cast<std::size_t>(&neg));
+    movaps(NEGBIT, xword[rax]);
+
+    Label invocation_loop;
+    L(invocation_loop);
+
     // Load address/loop registers
     movsxd(ADDROFFS_REG_0, dword[STATE + offsetof(UnitState, address_registers[0])]);
     movsxd(ADDROFFS_REG_1, dword[STATE + offsetof(UnitState, address_registers[1])]);
@@ -919,18 +944,16 @@ void JitShader::Compile(const std::array<u32, MAX_PROGRAM_CODE_LENGTH>* program_
     mov(COND0, byte[STATE + offsetof(UnitState, conditional_code[0])]);
     mov(COND1, byte[STATE + offsetof(UnitState, conditional_code[1])]);
 
-    // Used to set a register to one
-    static const __m128 one = {1.f, 1.f, 1.f, 1.f};
-    mov(rax, reinterpret_cast<std::size_t>(&one));
-    movaps(ONE, xword[rax]);
+    // Run the shader program, which returns here from its END instruction
+    call(qword[rsp + 24]);
 
-    // Used to negate registers
-    static const __m128 neg = {-0.f, -0.f, -0.f, -0.f};
-    mov(rax, reinterpret_cast<std::size_t>(&neg));
-    movaps(NEGBIT, xword[rax]);
+    add(STATE, static_cast<u32>(sizeof(UnitState)));
+    dec(BATCH_COUNT);
+    jnz(invocation_loop);
 
-    // Jump to start of the shader program
-    jmp(ABI_PARAM3);
+    add(rsp, 40);
+    ABI_PopRegistersAndAdjustStack(*this, ABI_ALL_CALLEE_SAVED, 8);
+    ret();
 
     // Compile entire program
     Compile_Block(static_cast<unsigned>(program_code->size()));
@@ -33,7 +33,18 @@ public:
     JitShader();
 
     void Run(const ShaderSetup& setup, UnitState& state, unsigned offset) const {
-        program(&setup.uniforms, &state, instruction_labels[offset].getAddress());
+        program(&setup.uniforms, &state, 1, instruction_labels[offset].getAddress());
+    }
+
+    /**
+     * Runs the shader once for each of `count` consecutive unit states. The states must be plain
+     * UnitStates (not GSUnitStates), as they are addressed with a stride of sizeof(UnitState).
+     */
+    void RunBatch(const ShaderSetup& setup, UnitState* states, std::size_t count,
+                  unsigned offset) const {
+        if (count != 0) {
+            program(&setup.uniforms, states, count, instruction_labels[offset].getAddress());
+        }
     }
 
     void Compile(const std::array<u32, MAX_PROGRAM_CODE_LENGTH>* program_code,
@@ -129,7 +140,8 @@ private:
     unsigned program_counter = 0; ///< Offset of the next instruction to decode
     bool looping = false;         ///< True if compiling a loop, used to check for nested loops
 
-    using CompiledShader = void(const void* setup, void* state, const u8* start_addr);
+    using CompiledShader = void(const void* setup, void* states, std::size_t count,
+                                const u8* start_addr);
     CompiledShader* program = nullptr;
 
     Xbyak::Label log2_subroutine;
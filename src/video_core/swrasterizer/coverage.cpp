@@ -0,0 +1,113 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#include "video_core/swrasterizer/coverage.h"
+
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+
+// The vectorized paths are only used after checking for CPU support at runtime, so they are built
+// for their instruction set individually rather than raising the baseline of the whole file.
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSE41 __attribute__((target("sse4.1")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSE41
+#define TARGET_AVX2
+#endif
+#endif
+
+namespace Pica::Rasterizer {
+
+void EvaluateSpanCoverage_Scalar(const std::array<EdgeFunction, 3>& edges, int x, int y,
+                                 SpanCoverage& coverage) {
+    coverage.mask = 0;
+    for (std::size_t i = 0; i < SPAN_SIZE; ++i) {
+        const int px = x + static_cast<int>(i) * 0x10;
+        bool covered = true;
+        for (std::size_t edge_index = 0; edge_index < 3; ++edge_index) {
+            const auto& edge = edges[edge_index];
+            // Computed in unsigned arithmetic to get the same wrap-around behaviour as the
+            // vectorized paths for degenerate, huge triangles
+            const u32 w = static_cast<u32>(edge.bias) +
+                          static_cast<u32>(edge.dx) * static_cast<u32>(y - edge.y0) -
+                          static_cast<u32>(edge.dy) * static_cast<u32>(px - edge.x0);
+            coverage.w[edge_index][i] = static_cast<int>(w);
+            covered = covered && static_cast<int>(w) >= 0;
+        }
+        if (covered) {
+            coverage.mask |= 1u << i;
+        }
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+
+TARGET_SSE41 void EvaluateSpanCoverage_SSE41(const std::array<EdgeFunction, 3>& edges, int x,
+                                             int y, SpanCoverage& coverage) {
+    static_assert(SPAN_SIZE % 4 == 0, "Span must consist of whole SSE vectors");
+
+    coverage.mask = 0;
+    for (std::size_t offset = 0; offset < SPAN_SIZE; offset += 4) {
+        const int base_x = x + static_cast<int>(offset) * 0x10;
+        const __m128i px = _mm_add_epi32(_mm_set1_epi32(base_x), _mm_setr_epi32(0, 16, 32, 48));
+        __m128i negative = _mm_setzero_si128();
+        for (std::size_t edge_index = 0; edge_index < 3; ++edge_index) {
+            const auto& edge = edges[edge_index];
+            // The y term is the same for the whole span
+            const int row_term = edge.bias + static_cast<int>(static_cast<u32>(edge.dx) *
+                                                              static_cast<u32>(y - edge.y0));
+            const __m128i w =
+                _mm_sub_epi32(_mm_set1_epi32(row_term),
+                              _mm_mullo_epi32(_mm_set1_epi32(edge.dy),
+                                              _mm_sub_epi32(px, _mm_set1_epi32(edge.x0))));
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(&coverage.w[edge_index][offset]), w);
+            negative = _mm_or_si128(negative, w);
+        }
+        const u32 uncovered =
+            static_cast<u32>(_mm_movemask_ps(_mm_castsi128_ps(negative)));
+        coverage.mask |= (~uncovered & 0xF) << offset;
+    }
+}
+
+TARGET_AVX2 void EvaluateSpanCoverage_AVX2(const std::array<EdgeFunction, 3>& edges, int x, int y,
+                                           SpanCoverage& coverage) {
+    static_assert(SPAN_SIZE == 8, "Span must consist of exactly one AVX vector");
+
+    const __m256i px =
+        _mm256_add_epi32(_mm256_set1_epi32(x), _mm256_setr_epi32(0, 16, 32, 48, 64, 80, 96, 112));
+    __m256i negative = _mm256_setzero_si256();
+    for (std::size_t edge_index = 0; edge_index < 3; ++edge_index) {
+        const auto& edge = edges[edge_index];
+        // The y term is the same for the whole span
+        const int row_term = edge.bias + static_cast<int>(static_cast<u32>(edge.dx) *
+                                                          static_cast<u32>(y - edge.y0));
+        const __m256i w =
+            _mm256_sub_epi32(_mm256_set1_epi32(row_term),
+                             _mm256_mullo_epi32(_mm256_set1_epi32(edge.dy),
+                                                _mm256_sub_epi32(px, _mm256_set1_epi32(edge.x0))));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(coverage.w[edge_index].data()), w);
+        negative = _mm256_or_si256(negative, w);
+    }
+    const u32 uncovered = static_cast<u32>(_mm256_movemask_ps(_mm256_castsi256_ps(negative)));
+    coverage.mask = ~uncovered & 0xFF;
+}
+
+#endif // ARCHITECTURE_x86_64
+
+SpanCoverageFunc GetSpanCoverageFunc() {
+#ifdef ARCHITECTURE_x86_64
+    const auto& caps = Common::GetCPUCaps();
+    if (caps.avx2) {
+        return EvaluateSpanCoverage_AVX2;
+    }
+    if (caps.sse4_1) {
+        return EvaluateSpanCoverage_SSE41;
+    }
+#endif
+    return EvaluateSpanCoverage_Scalar;
+}
+
+} // namespace Pica::Rasterizer
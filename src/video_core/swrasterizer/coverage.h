@@ -0,0 +1,61 @@
+// Copyright 2019 Citra Emulator Project
+// Licensed under GPLv2 or any later version
+// Refer to the license.txt file included.
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include "common/common_types.h"
+
+namespace Pica::Rasterizer {
+
+/// Number of horizontally adjacent pixels evaluated by a single span coverage call
+constexpr std::size_t SPAN_SIZE = 8;
+
+/**
+ * Edge function of a triangle edge from (x0, y0) to (x0 + dx, y0 + dy), in 12.4 fixed-point
+ * rasterizer coordinates. For a point p, it evaluates to bias + dx * (p.y - y0) - dy * (p.x - x0),
+ * i.e. the (biased) signed area spanned by the edge and p.
+ */
+struct EdgeFunction {
+    int x0;
+    int y0;
+    int dx;
+    int dy;
+    int bias;
+};
+
+/// Barycentric weights and coverage of a span of pixels
+struct SpanCoverage {
+    /// Value of each of the three edge functions, per pixel
+    std::array<std::array<int, SPAN_SIZE>, 3> w;
+    /// Bit i is set if pixel i lies on the inner side of all three edges
+    u32 mask;
+};
+
+/**
+ * Evaluates the edge functions for the SPAN_SIZE pixel centers starting at (x, y) and spaced one
+ * pixel (0x10) apart.
+ */
+using SpanCoverageFunc = void (*)(const std::array<EdgeFunction, 3>& edges, int x, int y,
+                                  SpanCoverage& coverage);
+
+/// Reference implementation
+void EvaluateSpanCoverage_Scalar(const std::array<EdgeFunction, 3>& edges, int x, int y,
+                                 SpanCoverage& coverage);
+
+#ifdef ARCHITECTURE_x86_64
+/// Requires SSE4.1
+void EvaluateSpanCoverage_SSE41(const std::array<EdgeFunction, 3>& edges, int x, int y,
+                                SpanCoverage& coverage);
+
+/// Requires AVX2
+void EvaluateSpanCoverage_AVX2(const std::array<EdgeFunction, 3>& edges, int x, int y,
+                               SpanCoverage& coverage);
+#endif
+
+/// Returns the fastest span coverage implementation supported by the host CPU
+SpanCoverageFunc GetSpanCoverageFunc();
+
+} // namespace Pica::Rasterizer
@@ -5,7 +5,9 @@
 #include <algorithm>
 #include <array>
 #include <cmath>
+#include <memory>
 #include <tuple>
+#include <vector>
 #include "common/assert.h"
 #include "common/bit_field.h"
 #include "common/color.h"
@@ -13,7 +15,9 @@
 #include "common/logging/log.h"
 #include "common/microprofile.h"
 #include "common/quaternion.h"
+#include "common/thread_pool.h"
 #include "common/vector_math.h"
+#include "core/core.h"
 #include "core/hw/gpu.h"
 #include "core/memory.h"
 #include "video_core/debug_utils/debug_utils.h"
@@ -23,6 +27,7 @@
 #include "video_core/regs_rasterizer.h"
 #include "video_core/regs_texturing.h"
 #include "video_core/shader/shader.h"
+#include "video_core/swrasterizer/coverage.h"
 #include "video_core/swrasterizer/framebuffer.h"
 #include "video_core/swrasterizer/lighting.h"
 #include "video_core/swrasterizer/proctex.h"
@@ -72,6 +77,12 @@ static int SignedArea(const Common::Vec2<Fix12P4>& vtx1, const Common::Vec2<Fix1
     return Common::Cross(vec1, vec2).z;
 };
 
+/// Edge function evaluating to SignedArea(vtx1, vtx2, p) + bias for a point p
+static EdgeFunction MakeEdgeFunction(const Common::Vec2<Fix12P4>& vtx1,
+                                     const Common::Vec2<Fix12P4>& vtx2, int bias) {
+    return {vtx1.x, vtx1.y, vtx2.x - vtx1.x, vtx2.y - vtx1.y, bias};
+}
+
 /// Convert a 3D vector for cube map coordinates to 2D texture coordinates along with the face name
 static std::tuple<float24, float24, float24, PAddr> ConvertCubeCoord(float24 u, float24 v,
                                                                      float24 w,
@@ -119,25 +130,146 @@ static std::tuple<float24, float24, float24, PAddr> ConvertCubeCoord(float24 u,
 
 MICROPROFILE_DEFINE(GPU_Rasterization, "GPU", "Rasterization", MP_RGB(50, 50, 240));
 
+/// Pixel-aligned area in rasterizer coordinates. The maximum bounds are exclusive.
+struct RasterRect {
+    u32 min_x;
+    u32 min_y;
+    u32 max_x;
+    u32 max_y;
+
+    bool IsEmpty() const {
+        return min_x >= max_x || min_y >= max_y;
+    }
+};
+
+/// Area covering every pixel addressable by the rasterizer
+constexpr RasterRect FULL_RASTER_RECT{0, 0, 0x10000, 0x10000};
+
+// vertex positions in rasterizer coordinates
+static Fix12P4 FloatToFix(float24 flt) {
+    // TODO: Rounding here is necessary to prevent garbage pixels at
+    //       triangle borders. Is it that the correct solution, though?
+    return Fix12P4(static_cast<unsigned short>(round(flt.ToFloat32() * 16.0f)));
+}
+
+static Common::Vec3<Fix12P4> ScreenToRasterizerCoordinates(const Common::Vec3<float24>& vec) {
+    return Common::Vec3<Fix12P4>{FloatToFix(vec.x), FloatToFix(vec.y), FloatToFix(vec.z)};
+}
+
+/// Calculates the pixel-aligned bounding box of a triangle, restricted to the scissor box
+static RasterRect GetTriangleBounds(const Common::Vec3<Fix12P4> (&vtxpos)[3],
+                                    const RasterizerRegs& regs) {
+    u16 min_x = std::min({vtxpos[0].x, vtxpos[1].x, vtxpos[2].x});
+    u16 min_y = std::min({vtxpos[0].y, vtxpos[1].y, vtxpos[2].y});
+    u16 max_x = std::max({vtxpos[0].x, vtxpos[1].x, vtxpos[2].x});
+    u16 max_y = std::max({vtxpos[0].y, vtxpos[1].y, vtxpos[2].y});
+
+    if (regs.scissor_test.mode == RasterizerRegs::ScissorMode::Include) {
+        // Convert the scissor box coordinates to 12.4 fixed point and calculate the new bounds.
+        // x2,y2 have +1 added to cover the entire sub-pixel area
+        min_x = std::max(min_x, (u16)(regs.scissor_test.x1 << 4));
+        min_y = std::max(min_y, (u16)(regs.scissor_test.y1 << 4));
+        max_x = std::min(max_x, (u16)((regs.scissor_test.x2 + 1) << 4));
+        max_y = std::min(max_y, (u16)((regs.scissor_test.y2 + 1) << 4));
+    }
+
+    min_x &= Fix12P4::IntMask();
+    min_y &= Fix12P4::IntMask();
+    max_x = ((max_x + Fix12P4::FracMask()) & Fix12P4::IntMask());
+    max_y = ((max_y + Fix12P4::FracMask()) & Fix12P4::IntMask());
+
+    return {min_x, min_y, max_x, max_y};
+}
+
+/**
+ * Texture environment configuration with the per-draw decisions resolved up front, so that the
+ * pixel loop does not need to decode stage registers for every fragment.
+ */
+struct TevProgram {
+    struct Stage {
+        TexturingRegs::TevStageConfig config;
+        Common::Vec4<u8> const_color;
+        unsigned color_multiplier;
+        unsigned alpha_multiplier;
+        bool updates_buffer_color;
+        bool updates_buffer_alpha;
+    };
+
+    std::array<Stage, 6> stages;
+    std::size_t num_stages = 0;
+
+    /// Whether any stage reads the combiner buffer. If not, the buffer needs no bookkeeping.
+    bool uses_combiner_buffer = false;
+    Common::Vec4<u8> combiner_buffer_color;
+};
+
+/// Returns whether a TEV stage forwards the previous stage's output without modifying it
+static bool IsPassthroughTevStage(const TexturingRegs::TevStageConfig& stage) {
+    using TevStageConfig = TexturingRegs::TevStageConfig;
+    return stage.color_op == TevStageConfig::Operation::Replace &&
+           stage.color_source1 == TevStageConfig::Source::Previous &&
+           stage.color_modifier1 == TevStageConfig::ColorModifier::SourceColor &&
+           stage.alpha_op == TevStageConfig::Operation::Replace &&
+           stage.alpha_source1 == TevStageConfig::Source::Previous &&
+           stage.alpha_modifier1 == TevStageConfig::AlphaModifier::SourceAlpha &&
+           stage.GetColorMultiplier() == 1 && stage.GetAlphaMultiplier() == 1;
+}
+
+static TevProgram CompileTevProgram(const TexturingRegs& regs) {
+    using Source = TexturingRegs::TevStageConfig::Source;
+
+    TevProgram program;
+    const auto tev_stages = regs.GetTevStages();
+
+    for (const auto& stage : tev_stages) {
+        for (Source source : {stage.color_source1.Value(), stage.color_source2.Value(),
+                              stage.color_source3.Value(), stage.alpha_source1.Value(),
+                              stage.alpha_source2.Value(), stage.alpha_source3.Value()}) {
+            program.uses_combiner_buffer |= source == Source::PreviousBuffer;
+        }
+    }
+
+    program.combiner_buffer_color = Common::MakeVec(regs.tev_combiner_buffer_color.r.Value(),
+                                                    regs.tev_combiner_buffer_color.g.Value(),
+                                                    regs.tev_combiner_buffer_color.b.Value(),
+                                                    regs.tev_combiner_buffer_color.a.Value())
+                                        .Cast<u8>();
+
+    for (unsigned index = 0; index < tev_stages.size(); ++index) {
+        const auto& config = tev_stages[index];
+
+        // Dropping a stage shifts the one-stage delay of the combiner buffer, so passthrough
+        // stages are only skipped when nothing reads it. The first stage is always kept as it is
+        // what defines the initial "previous" value.
+        if (index != 0 && !program.uses_combiner_buffer && IsPassthroughTevStage(config))
+            continue;
+
+        auto& stage = program.stages[program.num_stages++];
+        stage.config = config;
+        stage.const_color = Common::MakeVec(config.const_r.Value(), config.const_g.Value(),
+                                            config.const_b.Value(), config.const_a.Value())
+                                .Cast<u8>();
+        stage.color_multiplier = config.GetColorMultiplier();
+        stage.alpha_multiplier = config.GetAlphaMultiplier();
+        stage.updates_buffer_color =
+            regs.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferColor(index);
+        stage.updates_buffer_alpha =
+            regs.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferAlpha(index);
+    }
+
+    return program;
+}
+
 /**
  * Helper function for ProcessTriangle with the "reversed" flag to allow for implementing
- * culling via recursion.
+ * culling via recursion. Only pixels within clip_rect are drawn.
  */
 static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Vertex& v2,
-                                    bool reversed = false) {
-    const auto& regs = g_state.regs;
+                                    const RasterRect& clip_rect, bool reversed = false) {
+    const State& state = GetState();
+    const auto& regs = state.regs;
     MICROPROFILE_SCOPE(GPU_Rasterization);
 
-    // vertex positions in rasterizer coordinates
-    static auto FloatToFix = [](float24 flt) {
-        // TODO: Rounding here is necessary to prevent garbage pixels at
-        //       triangle borders. Is it that the correct solution, though?
-        return Fix12P4(static_cast<unsigned short>(round(flt.ToFloat32() * 16.0f)));
-    };
-    static auto ScreenToRasterizerCoordinates = [](const Common::Vec3<float24>& vec) {
-        return Common::Vec3<Fix12P4>{FloatToFix(vec.x), FloatToFix(vec.y), FloatToFix(vec.z)};
-    };
-
     Common::Vec3<Fix12P4> vtxpos[3]{ScreenToRasterizerCoordinates(v0.screenpos),
                                     ScreenToRasterizerCoordinates(v1.screenpos),
                                     ScreenToRasterizerCoordinates(v2.screenpos)};
@@ -145,13 +277,13 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
     if (regs.rasterizer.cull_mode == RasterizerRegs::CullMode::KeepAll) {
         // Make sure we always end up with a triangle wound counter-clockwise
         if (!reversed && SignedArea(vtxpos[0].xy(), vtxpos[1].xy(), vtxpos[2].xy()) <= 0) {
-            ProcessTriangleInternal(v0, v2, v1, true);
+            ProcessTriangleInternal(v0, v2, v1, clip_rect, true);
             return;
         }
     } else {
         if (!reversed && regs.rasterizer.cull_mode == RasterizerRegs::CullMode::KeepClockWise) {
             // Reverse vertex order and use the CCW code path.
-            ProcessTriangleInternal(v0, v2, v1, true);
+            ProcessTriangleInternal(v0, v2, v1, clip_rect, true);
             return;
         }
 
@@ -160,10 +292,13 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
             return;
     }
 
-    u16 min_x = std::min({vtxpos[0].x, vtxpos[1].x, vtxpos[2].x});
-    u16 min_y = std::min({vtxpos[0].y, vtxpos[1].y, vtxpos[2].y});
-    u16 max_x = std::max({vtxpos[0].x, vtxpos[1].x, vtxpos[2].x});
-    u16 max_y = std::max({vtxpos[0].y, vtxpos[1].y, vtxpos[2].y});
+    // Both rectangles are pixel-aligned and the triangle bounds never exceed 0xFFF0, so the
+    // intersection fits into the 16-bit rasterizer coordinates.
+    const RasterRect bounds = GetTriangleBounds(vtxpos, regs.rasterizer);
+    const u16 min_x = static_cast<u16>(std::max(bounds.min_x, clip_rect.min_x));
+    const u16 min_y = static_cast<u16>(std::max(bounds.min_y, clip_rect.min_y));
+    const u16 max_x = static_cast<u16>(std::min(bounds.max_x, clip_rect.max_x));
+    const u16 max_y = static_cast<u16>(std::min(bounds.max_y, clip_rect.max_y));
 
     // Convert the scissor box coordinates to 12.4 fixed point
     u16 scissor_x1 = (u16)(regs.rasterizer.scissor_test.x1 << 4);
@@ -172,19 +307,6 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
     u16 scissor_x2 = (u16)((regs.rasterizer.scissor_test.x2 + 1) << 4);
     u16 scissor_y2 = (u16)((regs.rasterizer.scissor_test.y2 + 1) << 4);
 
-    if (regs.rasterizer.scissor_test.mode == RasterizerRegs::ScissorMode::Include) {
-        // Calculate the new bounds
-        min_x = std::max(min_x, scissor_x1);
-        min_y = std::max(min_y, scissor_y1);
-        max_x = std::min(max_x, scissor_x2);
-        max_y = std::min(max_y, scissor_y2);
-    }
-
-    min_x &= Fix12P4::IntMask();
-    min_y &= Fix12P4::IntMask();
-    max_x = ((max_x + Fix12P4::FracMask()) & Fix12P4::IntMask());
-    max_y = ((max_y + Fix12P4::FracMask()) & Fix12P4::IntMask());
-
     // Triangle filling rules: Pixels on the right-sided edge or on flat bottom edges are not
     // drawn. Pixels on any other triangle border are drawn. This is implemented with three bias
     // values which are added to the barycentric coordinates w0, w1 and w2, respectively.
@@ -210,20 +332,56 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
     int bias2 =
         IsRightSideOrFlatBottomEdge(vtxpos[2].xy(), vtxpos[0].xy(), vtxpos[1].xy()) ? -1 : 0;
 
+    const std::array<EdgeFunction, 3> edges{{
+        MakeEdgeFunction(vtxpos[1].xy(), vtxpos[2].xy(), bias0),
+        MakeEdgeFunction(vtxpos[2].xy(), vtxpos[0].xy(), bias1),
+        MakeEdgeFunction(vtxpos[0].xy(), vtxpos[1].xy(), bias2),
+    }};
+    static const SpanCoverageFunc evaluate_span_coverage = GetSpanCoverageFunc();
+
     auto w_inverse = Common::MakeVec(v0.pos.w, v1.pos.w, v2.pos.w);
 
     auto textures = regs.texturing.GetTextures();
-    auto tev_stages = regs.texturing.GetTevStages();
+    const TevProgram tev_program = CompileTevProgram(regs.texturing);
+
+    const float depth_scale = float24::FromRaw(regs.rasterizer.viewport_depth_range).ToFloat32();
+    const float depth_offset =
+        float24::FromRaw(regs.rasterizer.viewport_depth_near_plane).ToFloat32();
+
+    const Common::Vec3<u8> fog_color = Common::MakeVec(regs.texturing.fog_color.r.Value(),
+                                                       regs.texturing.fog_color.g.Value(),
+                                                       regs.texturing.fog_color.b.Value())
+                                           .Cast<u8>();
+
+    const auto& blend_const_regs = regs.framebuffer.output_merger.blend_const;
+    const Common::Vec4<u8> blend_const =
+        Common::MakeVec(blend_const_regs.r.Value(), blend_const_regs.g.Value(),
+                        blend_const_regs.b.Value(), blend_const_regs.a.Value())
+            .Cast<u8>();
 
     bool stencil_action_enable =
-        g_state.regs.framebuffer.output_merger.stencil_test.enable &&
-        g_state.regs.framebuffer.framebuffer.depth_format == FramebufferRegs::DepthFormat::D24S8;
-    const auto stencil_test = g_state.regs.framebuffer.output_merger.stencil_test;
+        state.regs.framebuffer.output_merger.stencil_test.enable &&
+        state.regs.framebuffer.framebuffer.depth_format == FramebufferRegs::DepthFormat::D24S8;
+    const auto stencil_test = state.regs.framebuffer.output_merger.stencil_test;
 
     // Enter rasterization loop, starting at the center of the topleft bounding box corner.
     // TODO: Not sure if looping through x first might be faster
     for (u16 y = min_y + 8; y < max_y; y += 0x10) {
-        for (u16 x = min_x + 8; x < max_x; x += 0x10) {
+        SpanCoverage coverage;
+        std::size_t span_index = SPAN_SIZE;
+        for (u32 x = min_x + 8; x < max_x; x += 0x10, ++span_index) {
+
+            // Calculate the barycentric coordinates w0, w1 and w2 for a whole span of pixels
+            if (span_index == SPAN_SIZE) {
+                evaluate_span_coverage(edges, x, y, coverage);
+                span_index = 0;
+                if (coverage.mask == 0) {
+                    // Move on to the last pixel, the loop increment then enters the next span
+                    x += (SPAN_SIZE - 1) * 0x10;
+                    span_index = SPAN_SIZE - 1;
+                    continue;
+                }
+            }
 
             // Do not process the pixel if it's inside the scissor box and the scissor mode is set
             // to Exclude
@@ -232,16 +390,15 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
                     continue;
             }
 
-            // Calculate the barycentric coordinates w0, w1 and w2
-            int w0 = bias0 + SignedArea(vtxpos[1].xy(), vtxpos[2].xy(), {x, y});
-            int w1 = bias1 + SignedArea(vtxpos[2].xy(), vtxpos[0].xy(), {x, y});
-            int w2 = bias2 + SignedArea(vtxpos[0].xy(), vtxpos[1].xy(), {x, y});
-            int wsum = w0 + w1 + w2;
-
             // If current pixel is not covered by the current primitive
-            if (w0 < 0 || w1 < 0 || w2 < 0)
+            if ((coverage.mask & (1u << span_index)) == 0)
                 continue;
 
+            int w0 = coverage.w[0][span_index];
+            int w1 = coverage.w[1][span_index];
+            int w2 = coverage.w[2][span_index];
+            int wsum = w0 + w1 + w2;
+
             auto baricentric_coordinates =
                 Common::MakeVec(float24::FromFloat32(static_cast<float>(w0)),
                                 float24::FromFloat32(static_cast<float>(w1)),
@@ -257,9 +414,6 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
 
             // Not fully accurate. About 3 bits in precision are missing.
             // Z-Buffer (z / w * scale + offset)
-            float depth_scale = float24::FromRaw(regs.rasterizer.viewport_depth_range).ToFloat32();
-            float depth_offset =
-                float24::FromRaw(regs.rasterizer.viewport_depth_near_plane).ToFloat32();
             float depth = interpolated_z_over_w * depth_scale + depth_offset;
 
             // Potentially switch to W-Buffer
@@ -405,7 +559,7 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
                         GetWrappedTexCoord(texture.config.wrap_t, t, texture.config.height);
 
                     const u8* texture_data =
-                        VideoCore::g_memory->GetPhysicalPointer(texture_address);
+                        VideoCore::GetMemory().GetPhysicalPointer(texture_address);
                     auto info =
                         Texture::TextureInfo::FromPicaRegister(texture.config, texture.format);
 
@@ -434,7 +588,7 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
             if (regs.texturing.main_config.texture3_enable) {
                 const auto& proctex_uv = uv[regs.texturing.main_config.texture3_coordinates];
                 texture_color[3] = ProcTex(proctex_uv.u().ToFloat32(), proctex_uv.v().ToFloat32(),
-                                           g_state.regs.texturing, g_state.proctex);
+                                           state.regs.texturing, state.proctex);
             }
 
             // Texture environment - consists of 6 stages of color and alpha combining.
@@ -446,17 +600,12 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
             // analogously.
             Common::Vec4<u8> combiner_output;
             Common::Vec4<u8> combiner_buffer = {0, 0, 0, 0};
-            Common::Vec4<u8> next_combiner_buffer =
-                Common::MakeVec(regs.texturing.tev_combiner_buffer_color.r.Value(),
-                                regs.texturing.tev_combiner_buffer_color.g.Value(),
-                                regs.texturing.tev_combiner_buffer_color.b.Value(),
-                                regs.texturing.tev_combiner_buffer_color.a.Value())
-                    .Cast<u8>();
+            Common::Vec4<u8> next_combiner_buffer = tev_program.combiner_buffer_color;
 
             Common::Vec4<u8> primary_fragment_color = {0, 0, 0, 0};
             Common::Vec4<u8> secondary_fragment_color = {0, 0, 0, 0};
 
-            if (!g_state.regs.lighting.disable) {
+            if (!state.regs.lighting.disable) {
                 Common::Quaternion<float> normquat =
                     Common::Quaternion<float>{
                         {GetInterpolatedAttribute(v0.quat.x, v1.quat.x, v2.quat.x).ToFloat32(),
@@ -472,12 +621,13 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
                     GetInterpolatedAttribute(v0.view.z, v1.view.z, v2.view.z).ToFloat32(),
                 };
                 std::tie(primary_fragment_color, secondary_fragment_color) = ComputeFragmentsColors(
-                    g_state.regs.lighting, g_state.lighting, normquat, view, texture_color);
+                    state.regs.lighting, state.lighting, normquat, view, texture_color);
             }
 
-            for (unsigned tev_stage_index = 0; tev_stage_index < tev_stages.size();
+            for (std::size_t tev_stage_index = 0; tev_stage_index < tev_program.num_stages;
                  ++tev_stage_index) {
-                const auto& tev_stage = tev_stages[tev_stage_index];
+                const auto& program_stage = tev_program.stages[tev_stage_index];
+                const auto& tev_stage = program_stage.config;
                 using Source = TexturingRegs::TevStageConfig::Source;
 
                 auto GetSource = [&](Source source) -> Common::Vec4<u8> {
@@ -507,9 +657,7 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
                         return combiner_buffer;
 
                     case Source::Constant:
-                        return Common::MakeVec(tev_stage.const_r.Value(), tev_stage.const_g.Value(),
-                                               tev_stage.const_b.Value(), tev_stage.const_a.Value())
-                            .Cast<u8>();
+                        return program_stage.const_color;
 
                     case Source::Previous:
                         return combiner_output;
@@ -551,25 +699,26 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
                 }
 
                 combiner_output[0] =
-                    std::min((unsigned)255, color_output.r() * tev_stage.GetColorMultiplier());
+                    std::min((unsigned)255, color_output.r() * program_stage.color_multiplier);
                 combiner_output[1] =
-                    std::min((unsigned)255, color_output.g() * tev_stage.GetColorMultiplier());
+                    std::min((unsigned)255, color_output.g() * program_stage.color_multiplier);
                 combiner_output[2] =
-                    std::min((unsigned)255, color_output.b() * tev_stage.GetColorMultiplier());
+                    std::min((unsigned)255, color_output.b() * program_stage.color_multiplier);
                 combiner_output[3] =
-                    std::min((unsigned)255, alpha_output * tev_stage.GetAlphaMultiplier());
+                    std::min((unsigned)255, alpha_output * program_stage.alpha_multiplier);
+
+                if (!tev_program.uses_combiner_buffer)
+                    continue;
 
                 combiner_buffer = next_combiner_buffer;
 
-                if (regs.texturing.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferColor(
-                        tev_stage_index)) {
+                if (program_stage.updates_buffer_color) {
                     next_combiner_buffer.r() = combiner_output.r();
                     next_combiner_buffer.g() = combiner_output.g();
                     next_combiner_buffer.b() = combiner_output.b();
                 }
 
-                if (regs.texturing.tev_combiner_buffer_input.TevStageUpdatesCombinerBufferAlpha(
-                        tev_stage_index)) {
+                if (program_stage.updates_buffer_alpha) {
                     next_combiner_buffer.a() = combiner_output.a();
                 }
             }
@@ -633,15 +782,9 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
             // store the depth etc. Using float for now until we know more
             // about Pica datatypes
             if (regs.texturing.fog_mode == TexturingRegs::FogMode::Fog) {
-                const Common::Vec3<u8> fog_color =
-                    Common::MakeVec(regs.texturing.fog_color.r.Value(),
-                                    regs.texturing.fog_color.g.Value(),
-                                    regs.texturing.fog_color.b.Value())
-                        .Cast<u8>();
-
                 // Get index into fog LUT
                 float fog_index;
-                if (g_state.regs.texturing.fog_flip) {
+                if (state.regs.texturing.fog_flip) {
                     fog_index = (1.0f - depth) * 128.0f;
                 } else {
                     fog_index = depth * 128.0f;
@@ -650,7 +793,7 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
                 // Generate clamped fog factor from LUT for given fog index
                 float fog_i = std::clamp(floorf(fog_index), 0.0f, 127.0f);
                 float fog_f = fog_index - fog_i;
-                const auto& fog_lut_entry = g_state.fog.lut[static_cast<unsigned int>(fog_i)];
+                const auto& fog_lut_entry = state.fog.lut[static_cast<unsigned int>(fog_i)];
                 float fog_factor = fog_lut_entry.ToFloat() + fog_lut_entry.DiffToFloat() * fog_f;
                 fog_factor = std::clamp(fog_factor, 0.0f, 1.0f);
 
@@ -663,11 +806,11 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
 
             u8 old_stencil = 0;
 
-            auto UpdateStencil = [stencil_test, x, y,
-                                  &old_stencil](Pica::FramebufferRegs::StencilAction action) {
+            auto UpdateStencil = [stencil_test, x, y, &old_stencil,
+                                  &state](Pica::FramebufferRegs::StencilAction action) {
                 u8 new_stencil =
                     PerformStencilAction(action, old_stencil, stencil_test.reference_value);
-                if (g_state.regs.framebuffer.framebuffer.allow_depth_stencil_write != 0)
+                if (state.regs.framebuffer.framebuffer.allow_depth_stencil_write != 0)
                     SetStencil(x >> 4, y >> 4,
                                (new_stencil & stencil_test.write_mask) |
                                    (old_stencil & ~stencil_test.write_mask));
@@ -790,13 +933,6 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
                                         FramebufferRegs::BlendFactor factor) -> u8 {
                     DEBUG_ASSERT(channel < 4);
 
-                    const Common::Vec4<u8> blend_const =
-                        Common::MakeVec(output_merger.blend_const.r.Value(),
-                                        output_merger.blend_const.g.Value(),
-                                        output_merger.blend_const.b.Value(),
-                                        output_merger.blend_const.a.Value())
-                            .Cast<u8>();
-
                     switch (factor) {
                     case FramebufferRegs::BlendFactor::Zero:
                         return 0;
@@ -891,8 +1027,105 @@ static void ProcessTriangleInternal(const Vertex& v0, const Vertex& v1, const Ve
     }
 }
 
+/// Width and height of the screen-space tiles used to distribute rasterization, in pixels
+constexpr u32 TILE_SIZE = 32;
+/// log2 of the tile size in rasterizer coordinates (12.4 fixed point)
+constexpr u32 TILE_SHIFT = 5 + 4;
+static_assert((1 << TILE_SHIFT) == TILE_SIZE * 16, "Tile shift doesn't match tile size");
+
+struct QueuedTriangle {
+    Vertex v0;
+    Vertex v1;
+    Vertex v2;
+    RasterRect bounds;
+};
+
+/// Triangles of the current draw, waiting to be binned into tiles. Each console draws on its own
+/// thread, so these belong to the thread processing PICA commands.
+static thread_local std::vector<QueuedTriangle> queued_triangles;
+/// Indices into queued_triangles for each tile, reused across draws to avoid reallocation
+static thread_local std::vector<std::vector<u32>> tile_bins;
+
 void ProcessTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2) {
-    ProcessTriangleInternal(v0, v1, v2);
+    if (VideoCore::GetWorkerPool() == nullptr) {
+        ProcessTriangleInternal(v0, v1, v2, FULL_RASTER_RECT);
+        return;
+    }
+
+    const Common::Vec3<Fix12P4> vtxpos[3]{ScreenToRasterizerCoordinates(v0.screenpos),
+                                          ScreenToRasterizerCoordinates(v1.screenpos),
+                                          ScreenToRasterizerCoordinates(v2.screenpos)};
+    const RasterRect bounds = GetTriangleBounds(vtxpos, GetState().regs.rasterizer);
+    if (bounds.IsEmpty()) {
+        // No pixel can be covered, regardless of culling
+        return;
+    }
+    queued_triangles.push_back({v0, v1, v2, bounds});
+}
+
+void FlushTriangles() {
+    if (queued_triangles.empty()) {
+        return;
+    }
+
+    // Each pixel lies in exactly one tile, and every tile processes its triangles in submission
+    // order, so the output is identical to rasterizing all triangles serially.
+    RasterRect batch_bounds = queued_triangles.front().bounds;
+    for (const auto& triangle : queued_triangles) {
+        batch_bounds.min_x = std::min(batch_bounds.min_x, triangle.bounds.min_x);
+        batch_bounds.min_y = std::min(batch_bounds.min_y, triangle.bounds.min_y);
+        batch_bounds.max_x = std::max(batch_bounds.max_x, triangle.bounds.max_x);
+        batch_bounds.max_y = std::max(batch_bounds.max_y, triangle.bounds.max_y);
+    }
+
+    const u32 first_tile_x = batch_bounds.min_x >> TILE_SHIFT;
+    const u32 first_tile_y = batch_bounds.min_y >> TILE_SHIFT;
+    const u32 tiles_x = ((batch_bounds.max_x - 1) >> TILE_SHIFT) - first_tile_x + 1;
+    const u32 tiles_y = ((batch_bounds.max_y - 1) >> TILE_SHIFT) - first_tile_y + 1;
+
+    if (tile_bins.size() < tiles_x * tiles_y) {
+        tile_bins.resize(tiles_x * tiles_y);
+    }
+    for (u32 i = 0; i < tiles_x * tiles_y; ++i) {
+        tile_bins[i].clear();
+    }
+
+    for (u32 index = 0; index < queued_triangles.size(); ++index) {
+        const RasterRect& bounds = queued_triangles[index].bounds;
+        const u32 tile_x_end = ((bounds.max_x - 1) >> TILE_SHIFT) - first_tile_x;
+        const u32 tile_y_end = ((bounds.max_y - 1) >> TILE_SHIFT) - first_tile_y;
+        for (u32 tile_y = (bounds.min_y >> TILE_SHIFT) - first_tile_y; tile_y <= tile_y_end;
+             ++tile_y) {
+            for (u32 tile_x = (bounds.min_x >> TILE_SHIFT) - first_tile_x; tile_x <= tile_x_end;
+                 ++tile_x) {
+                tile_bins[tile_y * tiles_x + tile_x].push_back(index);
+            }
+        }
+    }
+
+    // Workers reach the buffers of the submitting thread and the console's state through these
+    const std::vector<QueuedTriangle>& triangles = queued_triangles;
+    const std::vector<std::vector<u32>>& bins = tile_bins;
+    Core::System& system = Core::System::GetInstance();
+    VideoCore::GetWorkerPool()->ParallelFor(tiles_x * tiles_y, [&](std::size_t tile_index) {
+        const auto& bin = bins[tile_index];
+        if (bin.empty()) {
+            return;
+        }
+
+        const u32 tile_x = first_tile_x + static_cast<u32>(tile_index % tiles_x);
+        const u32 tile_y = first_tile_y + static_cast<u32>(tile_index / tiles_x);
+        const RasterRect tile_rect{tile_x << TILE_SHIFT, tile_y << TILE_SHIFT,
+                                   (tile_x + 1) << TILE_SHIFT, (tile_y + 1) << TILE_SHIFT};
+
+        system.MakeCurrent();
+        for (u32 index : bin) {
+            const auto& triangle = triangles[index];
+            ProcessTriangleInternal(triangle.v0, triangle.v1, triangle.v2, tile_rect);
+        }
+    });
+
+    queued_triangles.clear();
 }
 
 } // namespace Pica::Rasterizer
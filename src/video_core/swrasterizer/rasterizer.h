@@ -39,6 +39,16 @@ struct Vertex : Shader::OutputVertex {
     }
 };
 
+/**
+ * Rasterizes a triangle. When multiple host threads are available, the triangle is queued up and
+ * drawn by the next call to FlushTriangles instead.
+ */
 void ProcessTriangle(const Vertex& v0, const Vertex& v1, const Vertex& v2);
 
+/**
+ * Draws all queued triangles, binned into screen-space tiles which are shaded in parallel. The
+ * framebuffer contents are identical to drawing the triangles one after another.
+ */
+void FlushTriangles();
+
 } // namespace Pica::Rasterizer
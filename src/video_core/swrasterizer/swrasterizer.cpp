@@ -3,6 +3,7 @@
 // Refer to the license.txt file included.
 
 #include "video_core/swrasterizer/clipper.h"
+#include "video_core/swrasterizer/rasterizer.h"
 #include "video_core/swrasterizer/swrasterizer.h"
 
 namespace VideoCore {
@@ -13,4 +14,32 @@ void SWRasterizer::AddTriangle(const Pica::Shader::OutputVertex& v0,
     Pica::Clipper::ProcessTriangle(v0, v1, v2);
 }
 
+void SWRasterizer::DrawTriangles() {
+    Pica::Rasterizer::FlushTriangles();
+}
+
+// DrawTriangles runs after every draw and immediate mode vertex, so the triangle queue is already
+// empty whenever anything else happens. Flushing it here as well is only a safeguard that keeps
+// the output in memory before anything else can observe it.
+
+void SWRasterizer::NotifyPicaRegisterChanged(u32 id) {
+    Pica::Rasterizer::FlushTriangles();
+}
+
+void SWRasterizer::FlushAll() {
+    Pica::Rasterizer::FlushTriangles();
+}
+
+void SWRasterizer::FlushRegion(PAddr addr, u32 size) {
+    Pica::Rasterizer::FlushTriangles();
+}
+
+void SWRasterizer::InvalidateRegion(PAddr addr, u32 size) {
+    Pica::Rasterizer::FlushTriangles();
+}
+
+void SWRasterizer::FlushAndInvalidateRegion(PAddr addr, u32 size) {
+    Pica::Rasterizer::FlushTriangles();
+}
+
 } // namespace VideoCore
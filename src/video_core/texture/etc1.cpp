@@ -75,13 +75,20 @@ union ETC1Tile {
         if (flip)
             std::swap(x, y);
 
+        const unsigned half = x < 2 ? 0 : 1;
+        return ApplyModifier(GetBaseColor(half), half, GetTableSubIndex(texel),
+                             GetNegationFlag(texel));
+    }
+
+    /// Returns the base color of the texels in the given half of the subtile
+    Common::Vec3<int> GetBaseColor(unsigned half) const {
         // Lookup base value
         Common::Vec3<int> ret;
         if (differential_mode) {
             ret.r() = static_cast<int>(differential.r);
             ret.g() = static_cast<int>(differential.g);
             ret.b() = static_cast<int>(differential.b);
-            if (x >= 2) {
+            if (half == 1) {
                 ret.r() += static_cast<int>(differential.dr);
                 ret.g() += static_cast<int>(differential.dg);
                 ret.b() += static_cast<int>(differential.db);
@@ -90,7 +97,7 @@ union ETC1Tile {
             ret.g() = Color::Convert5To8(ret.g());
             ret.b() = Color::Convert5To8(ret.b());
         } else {
-            if (x < 2) {
+            if (half == 0) {
                 ret.r() = Color::Convert4To8(static_cast<u8>(separate.r1));
                 ret.g() = Color::Convert4To8(static_cast<u8>(separate.g1));
                 ret.b() = Color::Convert4To8(static_cast<u8>(separate.b1));
@@ -100,14 +107,24 @@ union ETC1Tile {
                 ret.b() = Color::Convert4To8(static_cast<u8>(separate.b2));
             }
         }
+        return ret;
+    }
 
-        // Add modifier
+    /// Returns the modifier selected by the lookup values of a texel in the given half
+    int GetModifier(unsigned half, unsigned table_subindex, bool negate) const {
         unsigned table_index =
-            static_cast<int>((x < 2) ? table_index_1.Value() : table_index_2.Value());
+            static_cast<int>((half == 0) ? table_index_1.Value() : table_index_2.Value());
 
-        int modifier = etc1_modifier_table[table_index][GetTableSubIndex(texel)];
-        if (GetNegationFlag(texel))
+        int modifier = etc1_modifier_table[table_index][table_subindex];
+        if (negate)
             modifier *= -1;
+        return modifier;
+    }
+
+    /// Adds the modifier selected by the lookup values of a texel to its base color
+    const Common::Vec3<u8> ApplyModifier(Common::Vec3<int> ret, unsigned half,
+                                         unsigned table_subindex, bool negate) const {
+        const int modifier = GetModifier(half, table_subindex, negate);
 
         ret.r() = std::clamp(ret.r() + modifier, 0, 255);
         ret.g() = std::clamp(ret.g() + modifier, 0, 255);
@@ -124,4 +141,17 @@ Common::Vec3<u8> SampleETC1Subtile(u64 value, unsigned int x, unsigned int y) {
     return tile.GetRGB(x, y);
 }
 
+ETC1SubtileParams GetETC1SubtileParams(u64 value) {
+    ETC1Tile tile{value};
+    ETC1SubtileParams params;
+    params.flip = tile.flip != 0;
+    for (unsigned half = 0; half < 2; ++half) {
+        params.base_colors[half] = tile.GetBaseColor(half);
+        for (unsigned index = 0; index < 4; ++index) {
+            params.modifiers[half][index] = tile.GetModifier(half, index % 2, (index & 2) != 0);
+        }
+    }
+    return params;
+}
+
 } // namespace Pica::Texture
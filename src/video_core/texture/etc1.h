@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <array>
 #include "common/common_types.h"
 #include "common/vector_math.h"
 
@@ -11,4 +12,22 @@ namespace Pica::Texture {
 
 Common::Vec3<u8> SampleETC1Subtile(u64 value, unsigned int x, unsigned int y);
 
+/// Values that the colors of all texels in an ETC1 subtile are derived from
+struct ETC1SubtileParams {
+    /// Whether the subtile is split into a top and a bottom half rather than left and right
+    bool flip;
+    /// Base color of each half
+    std::array<Common::Vec3<int>, 2> base_colors;
+    /// Modifiers of each half, indexed by 2 * negation flag + table subindex
+    std::array<std::array<int, 4>, 2> modifiers;
+};
+
+/**
+ * Extracts the parameters of an ETC1 subtile. Texel (x, y) of the subtile lies in half 1 if x >= 2,
+ * or if y >= 2 for flipped subtiles. Its lookup values are bits 4 * x + y (table subindex) and
+ * 4 * x + y + 16 (negation flag), and its color is the sum of the base color and the modifier
+ * clamped to [0, 255].
+ */
+ETC1SubtileParams GetETC1SubtileParams(u64 value);
+
 } // namespace Pica::Texture
@@ -2,6 +2,9 @@
 // Licensed under GPLv2 or any later version
 // Refer to the license.txt file included.
 
+#include <algorithm>
+#include <array>
+#include <cstring>
 #include "common/assert.h"
 #include "common/color.h"
 #include "common/logging/log.h"
@@ -13,12 +16,29 @@
 #include "video_core/texture/texture_decode.h"
 #include "video_core/utils.h"
 
+#ifdef ARCHITECTURE_x86_64
+#include <immintrin.h>
+#include "common/x64/cpu_detect.h"
+
+// Only the kernels are built for the newer instruction sets, the rest of the file keeps the
+// baseline so that it runs everywhere.
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_SSSE3 __attribute__((target("ssse3")))
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_SSSE3
+#define TARGET_AVX2
+#endif
+#endif
+
 using TextureFormat = Pica::TexturingRegs::TextureFormat;
 
 namespace Pica::Texture {
 
 constexpr std::size_t TILE_SIZE = 8 * 8;
 constexpr std::size_t ETC1_SUBTILES = 2 * 2;
+/// Bytes in a row of a decoded tile
+constexpr std::size_t DECODED_ROW_SIZE = 8 * 4;
 
 size_t CalculateTileSize(TextureFormat format) {
     switch (format) {
@@ -211,6 +231,632 @@ Common::Vec4<u8> LookupTexelInTile(const u8* source, unsigned int x, unsigned in
     }
 }
 
+void DecodeTile_Scalar(TextureFormat format, const u8* source, u8* dest,
+                       std::ptrdiff_t dest_stride) {
+    TextureInfo info{};
+    info.format = format;
+    for (unsigned int y = 0; y < 8; ++y) {
+        for (unsigned int x = 0; x < 8; ++x) {
+            auto texel = LookupTexelInTile(source, x, y, info, false);
+            std::memcpy(dest + y * dest_stride + x * 4, texel.AsArray(), 4);
+        }
+    }
+}
+
+#ifdef ARCHITECTURE_x86_64
+
+namespace {
+
+// The kernels first convert the texels of a tile to RGBA8 in the Morton order they are stored in,
+// where each group of four texels is a 2x2 block, and then rearrange the blocks into rows.
+
+/// Blocks (bx, by) and (bx + 1, by) for even bx are next to each other in Morton order
+constexpr std::size_t MortonBlockIndex(std::size_t bx, std::size_t by) {
+    return (bx & 1) | ((by & 1) << 1) | ((bx >> 1) << 2) | ((by >> 1) << 3);
+}
+
+/// Lane i of an ETC1 subtile holds texel (i % 4, i / 4), whose bits are at position 4 * x + y
+constexpr std::array<u8, 16> ETC1_TEXEL_POSITIONS = {0, 4, 8,  12, 1, 5, 9,  13,
+                                                     2, 6, 10, 14, 3, 7, 11, 15};
+
+struct ETC1Subtile {
+    u64 alpha;
+    u64 color;
+    bool flip;
+    /// Red, green and blue channels of the eight colors the texels can have, indexed by
+    /// 4 * half + 2 * negation flag + table subindex
+    __m128i palette[3];
+};
+
+ETC1Subtile LoadETC1Subtile(const u8* source, std::size_t index, bool has_alpha) {
+    ETC1Subtile subtile;
+    const u8* subtile_ptr = source + index * (has_alpha ? 16 : 8);
+    if (has_alpha) {
+        std::memcpy(&subtile.alpha, subtile_ptr, sizeof(u64));
+        subtile_ptr += sizeof(u64);
+    }
+    std::memcpy(&subtile.color, subtile_ptr, sizeof(u64));
+
+    const ETC1SubtileParams params = GetETC1SubtileParams(subtile.color);
+    subtile.flip = params.flip;
+    const auto& modifiers = params.modifiers;
+    const __m128i modifier =
+        _mm_setr_epi16(modifiers[0][0], modifiers[0][1], modifiers[0][2], modifiers[0][3],
+                       modifiers[1][0], modifiers[1][1], modifiers[1][2], modifiers[1][3]);
+    for (std::size_t channel = 0; channel < 3; ++channel) {
+        const __m128i base =
+            _mm_unpacklo_epi64(_mm_set1_epi16(params.base_colors[0][channel]),
+                               _mm_set1_epi16(params.base_colors[1][channel]));
+        // Saturating to unsigned bytes clamps the sums to [0, 255]
+        subtile.palette[channel] =
+            _mm_packus_epi16(_mm_add_epi16(base, modifier), _mm_setzero_si128());
+    }
+    return subtile;
+}
+
+TARGET_SSSE3 __m128i Expand4To8_SSSE3(__m128i value) {
+    return _mm_or_si128(_mm_slli_epi16(value, 4), value);
+}
+
+TARGET_SSSE3 __m128i Expand5To8_SSSE3(__m128i value) {
+    return _mm_or_si128(_mm_slli_epi16(value, 3), _mm_srli_epi16(value, 2));
+}
+
+TARGET_SSSE3 __m128i Expand6To8_SSSE3(__m128i value) {
+    return _mm_or_si128(_mm_slli_epi16(value, 2), _mm_srli_epi16(value, 4));
+}
+
+/// Splits 8 bytes into 16 4-bit values, the low nibble first, and expands them to 8 bits
+TARGET_SSSE3 __m128i ExpandNibbles_SSSE3(__m128i bytes) {
+    const __m128i low_mask = _mm_set1_epi8(0x0F);
+    const __m128i low = _mm_and_si128(bytes, low_mask);
+    const __m128i high = _mm_and_si128(_mm_srli_epi16(bytes, 4), low_mask);
+    return Expand4To8_SSSE3(_mm_unpacklo_epi8(low, high));
+}
+
+/// Turns 16 bytes into 16 texels, using them as intensity or as alpha
+template <bool is_alpha>
+TARGET_SSSE3 void ExpandChannel_SSSE3(__m128i values, __m128i* out) {
+    const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    __m128i shuffle = _mm_setr_epi8(0, 0, 0, 0, 1, 1, 1, 1, 2, 2, 2, 2, 3, 3, 3, 3);
+    for (std::size_t i = 0; i < 4; ++i) {
+        const __m128i texels = _mm_shuffle_epi8(values, shuffle);
+        out[i] = is_alpha ? _mm_and_si128(texels, alpha_mask) : _mm_or_si128(texels, alpha_mask);
+        shuffle = _mm_add_epi8(shuffle, _mm_set1_epi8(4));
+    }
+}
+
+/// Assembles eight texels from color channels held in 16-bit lanes
+TARGET_SSSE3 void Combine_SSSE3(__m128i r, __m128i g, __m128i b, __m128i a, __m128i* out) {
+    const __m128i rg = _mm_or_si128(r, _mm_slli_epi16(g, 8));
+    const __m128i ba = _mm_or_si128(b, _mm_slli_epi16(a, 8));
+    out[0] = _mm_unpacklo_epi16(rg, ba);
+    out[1] = _mm_unpackhi_epi16(rg, ba);
+}
+
+/// Converts the texels of a tile to RGBA8 2x2 blocks in Morton order
+TARGET_SSSE3 bool ConvertTile_SSSE3(TextureFormat format, const u8* source, __m128i* blocks) {
+    const auto load = [source](std::size_t offset) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+    };
+    const __m128i alpha_mask = _mm_set1_epi32(static_cast<int>(0xFF000000));
+    const __m128i opaque = _mm_set1_epi16(0xFF);
+
+    switch (format) {
+    case TextureFormat::RGBA8: {
+        const __m128i shuffle =
+            _mm_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        for (std::size_t i = 0; i < 16; ++i) {
+            blocks[i] = _mm_shuffle_epi8(load(i * 16), shuffle);
+        }
+        return true;
+    }
+
+    case TextureFormat::RGB8: {
+        // Eight texels span 24 bytes, read as two overlapping vectors to stay inside the tile
+        const __m128i shuffle_low =
+            _mm_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1);
+        const __m128i shuffle_high =
+            _mm_setr_epi8(6, 5, 4, -1, 9, 8, 7, -1, 12, 11, 10, -1, 15, 14, 13, -1);
+        for (std::size_t i = 0; i < 8; ++i) {
+            blocks[2 * i] = _mm_or_si128(_mm_shuffle_epi8(load(i * 24), shuffle_low), alpha_mask);
+            blocks[2 * i + 1] =
+                _mm_or_si128(_mm_shuffle_epi8(load(i * 24 + 8), shuffle_high), alpha_mask);
+        }
+        return true;
+    }
+
+    case TextureFormat::RGB5A1: {
+        const __m128i mask = _mm_set1_epi16(0x1F);
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m128i pixels = load(i * 16);
+            const __m128i r = Expand5To8_SSSE3(_mm_srli_epi16(pixels, 11));
+            const __m128i g = Expand5To8_SSSE3(_mm_and_si128(_mm_srli_epi16(pixels, 6), mask));
+            const __m128i b = Expand5To8_SSSE3(_mm_and_si128(_mm_srli_epi16(pixels, 1), mask));
+            const __m128i a = _mm_mullo_epi16(_mm_and_si128(pixels, _mm_set1_epi16(1)), opaque);
+            Combine_SSSE3(r, g, b, a, &blocks[2 * i]);
+        }
+        return true;
+    }
+
+    case TextureFormat::RGB565: {
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m128i pixels = load(i * 16);
+            const __m128i r = Expand5To8_SSSE3(_mm_srli_epi16(pixels, 11));
+            const __m128i g =
+                Expand6To8_SSSE3(_mm_and_si128(_mm_srli_epi16(pixels, 5), _mm_set1_epi16(0x3F)));
+            const __m128i b = Expand5To8_SSSE3(_mm_and_si128(pixels, _mm_set1_epi16(0x1F)));
+            Combine_SSSE3(r, g, b, opaque, &blocks[2 * i]);
+        }
+        return true;
+    }
+
+    case TextureFormat::RGBA4: {
+        const __m128i mask = _mm_set1_epi16(0xF);
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m128i pixels = load(i * 16);
+            const __m128i r = Expand4To8_SSSE3(_mm_srli_epi16(pixels, 12));
+            const __m128i g = Expand4To8_SSSE3(_mm_and_si128(_mm_srli_epi16(pixels, 8), mask));
+            const __m128i b = Expand4To8_SSSE3(_mm_and_si128(_mm_srli_epi16(pixels, 4), mask));
+            const __m128i a = Expand4To8_SSSE3(_mm_and_si128(pixels, mask));
+            Combine_SSSE3(r, g, b, a, &blocks[2 * i]);
+        }
+        return true;
+    }
+
+    case TextureFormat::IA8: {
+        const __m128i shuffle_low = _mm_setr_epi8(1, 1, 1, 0, 3, 3, 3, 2, 5, 5, 5, 4, 7, 7, 7, 6);
+        const __m128i shuffle_high =
+            _mm_setr_epi8(9, 9, 9, 8, 11, 11, 11, 10, 13, 13, 13, 12, 15, 15, 15, 14);
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m128i pixels = load(i * 16);
+            blocks[2 * i] = _mm_shuffle_epi8(pixels, shuffle_low);
+            blocks[2 * i + 1] = _mm_shuffle_epi8(pixels, shuffle_high);
+        }
+        return true;
+    }
+
+    case TextureFormat::RG8: {
+        const __m128i shuffle_low =
+            _mm_setr_epi8(1, 0, -1, -1, 3, 2, -1, -1, 5, 4, -1, -1, 7, 6, -1, -1);
+        const __m128i shuffle_high =
+            _mm_setr_epi8(9, 8, -1, -1, 11, 10, -1, -1, 13, 12, -1, -1, 15, 14, -1, -1);
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m128i pixels = load(i * 16);
+            blocks[2 * i] = _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle_low), alpha_mask);
+            blocks[2 * i + 1] = _mm_or_si128(_mm_shuffle_epi8(pixels, shuffle_high), alpha_mask);
+        }
+        return true;
+    }
+
+    case TextureFormat::I8:
+        for (std::size_t i = 0; i < 4; ++i) {
+            ExpandChannel_SSSE3<false>(load(i * 16), &blocks[4 * i]);
+        }
+        return true;
+
+    case TextureFormat::A8:
+        for (std::size_t i = 0; i < 4; ++i) {
+            ExpandChannel_SSSE3<true>(load(i * 16), &blocks[4 * i]);
+        }
+        return true;
+
+    case TextureFormat::IA4: {
+        const __m128i mask = _mm_set1_epi8(0x0F);
+        const __m128i shuffle_low = _mm_setr_epi8(0, 0, 0, 1, 2, 2, 2, 3, 4, 4, 4, 5, 6, 6, 6, 7);
+        const __m128i shuffle_high =
+            _mm_setr_epi8(8, 8, 8, 9, 10, 10, 10, 11, 12, 12, 12, 13, 14, 14, 14, 15);
+        for (std::size_t i = 0; i < 4; ++i) {
+            const __m128i pixels = load(i * 16);
+            const __m128i intensity =
+                Expand4To8_SSSE3(_mm_and_si128(_mm_srli_epi16(pixels, 4), mask));
+            const __m128i alpha = Expand4To8_SSSE3(_mm_and_si128(pixels, mask));
+            const __m128i low = _mm_unpacklo_epi8(intensity, alpha);
+            const __m128i high = _mm_unpackhi_epi8(intensity, alpha);
+            blocks[4 * i] = _mm_shuffle_epi8(low, shuffle_low);
+            blocks[4 * i + 1] = _mm_shuffle_epi8(low, shuffle_high);
+            blocks[4 * i + 2] = _mm_shuffle_epi8(high, shuffle_low);
+            blocks[4 * i + 3] = _mm_shuffle_epi8(high, shuffle_high);
+        }
+        return true;
+    }
+
+    case TextureFormat::I4:
+    case TextureFormat::A4: {
+        for (std::size_t i = 0; i < 4; ++i) {
+            const __m128i values = ExpandNibbles_SSSE3(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i * 8)));
+            if (format == TextureFormat::A4) {
+                ExpandChannel_SSSE3<true>(values, &blocks[4 * i]);
+            } else {
+                ExpandChannel_SSSE3<false>(values, &blocks[4 * i]);
+            }
+        }
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+TARGET_SSSE3 void DeswizzleTile_SSSE3(const __m128i* blocks, u8* dest,
+                                      std::ptrdiff_t dest_stride) {
+    const auto store = [](u8* row, std::size_t offset, __m128i value) {
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(row + offset), value);
+    };
+    for (std::size_t by = 0; by < 4; ++by) {
+        const __m128i block0 = blocks[MortonBlockIndex(0, by)];
+        const __m128i block1 = blocks[MortonBlockIndex(1, by)];
+        const __m128i block2 = blocks[MortonBlockIndex(2, by)];
+        const __m128i block3 = blocks[MortonBlockIndex(3, by)];
+        u8* even_row = dest + static_cast<std::ptrdiff_t>(2 * by) * dest_stride;
+        u8* odd_row = even_row + dest_stride;
+        store(even_row, 0, _mm_unpacklo_epi64(block0, block1));
+        store(even_row, 16, _mm_unpacklo_epi64(block2, block3));
+        store(odd_row, 0, _mm_unpackhi_epi64(block0, block1));
+        store(odd_row, 16, _mm_unpackhi_epi64(block2, block3));
+    }
+}
+
+/// Sets the bytes of the lanes whose texel has its bit set in the given 16-bit value
+TARGET_SSSE3 __m128i TestETC1TexelBits_SSSE3(u32 bits) {
+    // Lane i tests bit ETC1_TEXEL_POSITIONS[i]
+    const __m128i select_byte = _mm_setr_epi8(0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1, 0, 0, 1, 1);
+    const __m128i bit_mask =
+        _mm_setr_epi8(1, 16, 1, 16, 2, 32, 2, 32, 4, 64, 4, 64, 8, -128, 8, -128);
+    const __m128i selected =
+        _mm_and_si128(_mm_shuffle_epi8(_mm_cvtsi32_si128(bits), select_byte), bit_mask);
+    return _mm_cmpeq_epi8(selected, bit_mask);
+}
+
+/// Decodes the 16 texels of an ETC1 subtile, lane i holding the channel of texel (i % 4, i / 4)
+TARGET_SSSE3 void DecodeETC1Subtile_SSSE3(const ETC1Subtile& subtile, bool has_alpha, __m128i& r,
+                                          __m128i& g, __m128i& b, __m128i& a) {
+    const __m128i half = subtile.flip
+                             ? _mm_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 4, 4, 4, 4, 4, 4, 4, 4)
+                             : _mm_setr_epi8(0, 0, 4, 4, 0, 0, 4, 4, 0, 0, 4, 4, 0, 0, 4, 4);
+    const u32 low_bits = static_cast<u32>(subtile.color);
+    const __m128i table_subindex =
+        _mm_and_si128(TestETC1TexelBits_SSSE3(low_bits & 0xFFFF), _mm_set1_epi8(1));
+    const __m128i negation =
+        _mm_and_si128(TestETC1TexelBits_SSSE3(low_bits >> 16), _mm_set1_epi8(2));
+    const __m128i index = _mm_or_si128(_mm_or_si128(half, negation), table_subindex);
+
+    r = _mm_shuffle_epi8(subtile.palette[0], index);
+    g = _mm_shuffle_epi8(subtile.palette[1], index);
+    b = _mm_shuffle_epi8(subtile.palette[2], index);
+
+    if (has_alpha) {
+        const __m128i alpha = ExpandNibbles_SSSE3(_mm_cvtsi64_si128(subtile.alpha));
+        a = _mm_shuffle_epi8(alpha, _mm_loadu_si128(reinterpret_cast<const __m128i*>(
+                                        ETC1_TEXEL_POSITIONS.data())));
+    } else {
+        a = _mm_set1_epi8(-1);
+    }
+}
+
+TARGET_SSSE3 void DecodeETC1Tile_SSSE3(const u8* source, bool has_alpha, u8* dest,
+                                       std::ptrdiff_t dest_stride) {
+    for (std::size_t index = 0; index < ETC1_SUBTILES; ++index) {
+        const ETC1Subtile subtile = LoadETC1Subtile(source, index, has_alpha);
+        __m128i r, g, b, a;
+        DecodeETC1Subtile_SSSE3(subtile, has_alpha, r, g, b, a);
+
+        const __m128i rg_low = _mm_unpacklo_epi8(r, g);
+        const __m128i ba_low = _mm_unpacklo_epi8(b, a);
+        const __m128i rg_high = _mm_unpackhi_epi8(r, g);
+        const __m128i ba_high = _mm_unpackhi_epi8(b, a);
+        const __m128i rows[4] = {
+            _mm_unpacklo_epi16(rg_low, ba_low), _mm_unpackhi_epi16(rg_low, ba_low),
+            _mm_unpacklo_epi16(rg_high, ba_high), _mm_unpackhi_epi16(rg_high, ba_high)};
+
+        u8* subtile_dest = dest + static_cast<std::ptrdiff_t>(index / 2) * 4 * dest_stride +
+                           (index % 2) * 4 * 4;
+        for (std::size_t y = 0; y < 4; ++y) {
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(subtile_dest + y * dest_stride), rows[y]);
+        }
+    }
+}
+
+TARGET_AVX2 __m256i Expand4To8_AVX2(__m256i value) {
+    return _mm256_or_si256(_mm256_slli_epi32(value, 4), value);
+}
+
+TARGET_AVX2 __m256i Expand5To8_AVX2(__m256i value) {
+    return _mm256_or_si256(_mm256_slli_epi32(value, 3), _mm256_srli_epi32(value, 2));
+}
+
+TARGET_AVX2 __m256i Expand6To8_AVX2(__m256i value) {
+    return _mm256_or_si256(_mm256_slli_epi32(value, 2), _mm256_srli_epi32(value, 4));
+}
+
+/// Assembles eight texels from color channels held in 32-bit lanes
+TARGET_AVX2 __m256i Combine_AVX2(__m256i r, __m256i g, __m256i b, __m256i a) {
+    return _mm256_or_si256(_mm256_or_si256(r, _mm256_slli_epi32(g, 8)),
+                           _mm256_or_si256(_mm256_slli_epi32(b, 16), _mm256_slli_epi32(a, 24)));
+}
+
+/// Loads eight 8-bit values, zero extended to 32 bits
+TARGET_AVX2 __m256i LoadU8_AVX2(const u8* source) {
+    return _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(source)));
+}
+
+/// Loads eight 16-bit values, zero extended to 32 bits
+TARGET_AVX2 __m256i LoadU16_AVX2(const u8* source) {
+    return _mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(source)));
+}
+
+/// Converts the texels of a tile to RGBA8 in Morton order, two 2x2 blocks per vector
+TARGET_AVX2 bool ConvertTile_AVX2(TextureFormat format, const u8* source, __m256i* blocks) {
+    const auto load = [source](std::size_t offset) {
+        return _mm_loadu_si128(reinterpret_cast<const __m128i*>(source + offset));
+    };
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i opaque = _mm256_set1_epi32(0xFF);
+    const __m256i mask4 = _mm256_set1_epi32(0xF);
+    const __m256i mask5 = _mm256_set1_epi32(0x1F);
+
+    switch (format) {
+    case TextureFormat::RGBA8: {
+        const __m256i shuffle =
+            _mm256_setr_epi8(3, 2, 1, 0, 7, 6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12, 3, 2, 1, 0, 7,
+                             6, 5, 4, 11, 10, 9, 8, 15, 14, 13, 12);
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m256i pixels =
+                _mm256_loadu_si256(reinterpret_cast<const __m256i*>(source + i * 32));
+            blocks[i] = _mm256_shuffle_epi8(pixels, shuffle);
+        }
+        return true;
+    }
+
+    case TextureFormat::RGB8: {
+        // The upper lane starts four bytes into the second texel group
+        const __m256i alpha_mask = _mm256_set1_epi32(static_cast<int>(0xFF000000));
+        const __m256i shuffle =
+            _mm256_setr_epi8(2, 1, 0, -1, 5, 4, 3, -1, 8, 7, 6, -1, 11, 10, 9, -1, 6, 5, 4, -1, 9,
+                             8, 7, -1, 12, 11, 10, -1, 15, 14, 13, -1);
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m256i pixels = _mm256_inserti128_si256(
+                _mm256_castsi128_si256(load(i * 24)), load(i * 24 + 8), 1);
+            blocks[i] = _mm256_or_si256(_mm256_shuffle_epi8(pixels, shuffle), alpha_mask);
+        }
+        return true;
+    }
+
+    case TextureFormat::RGB5A1: {
+        const __m256i one = _mm256_set1_epi32(1);
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m256i pixels = LoadU16_AVX2(source + i * 16);
+            const __m256i r = Expand5To8_AVX2(_mm256_srli_epi32(pixels, 11));
+            const __m256i g =
+                Expand5To8_AVX2(_mm256_and_si256(_mm256_srli_epi32(pixels, 6), mask5));
+            const __m256i b =
+                Expand5To8_AVX2(_mm256_and_si256(_mm256_srli_epi32(pixels, 1), mask5));
+            const __m256i a = _mm256_cmpeq_epi32(_mm256_and_si256(pixels, one), one);
+            blocks[i] = Combine_AVX2(r, g, b, _mm256_and_si256(a, opaque));
+        }
+        return true;
+    }
+
+    case TextureFormat::RGB565: {
+        const __m256i mask6 = _mm256_set1_epi32(0x3F);
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m256i pixels = LoadU16_AVX2(source + i * 16);
+            const __m256i r = Expand5To8_AVX2(_mm256_srli_epi32(pixels, 11));
+            const __m256i g =
+                Expand6To8_AVX2(_mm256_and_si256(_mm256_srli_epi32(pixels, 5), mask6));
+            const __m256i b = Expand5To8_AVX2(_mm256_and_si256(pixels, mask5));
+            blocks[i] = Combine_AVX2(r, g, b, opaque);
+        }
+        return true;
+    }
+
+    case TextureFormat::RGBA4:
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m256i pixels = LoadU16_AVX2(source + i * 16);
+            const __m256i r = Expand4To8_AVX2(_mm256_srli_epi32(pixels, 12));
+            const __m256i g =
+                Expand4To8_AVX2(_mm256_and_si256(_mm256_srli_epi32(pixels, 8), mask4));
+            const __m256i b =
+                Expand4To8_AVX2(_mm256_and_si256(_mm256_srli_epi32(pixels, 4), mask4));
+            const __m256i a = Expand4To8_AVX2(_mm256_and_si256(pixels, mask4));
+            blocks[i] = Combine_AVX2(r, g, b, a);
+        }
+        return true;
+
+    case TextureFormat::IA8:
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m256i pixels = LoadU16_AVX2(source + i * 16);
+            const __m256i intensity = _mm256_srli_epi32(pixels, 8);
+            const __m256i alpha = _mm256_and_si256(pixels, opaque);
+            blocks[i] = Combine_AVX2(intensity, intensity, intensity, alpha);
+        }
+        return true;
+
+    case TextureFormat::RG8:
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m256i pixels = LoadU16_AVX2(source + i * 16);
+            const __m256i r = _mm256_srli_epi32(pixels, 8);
+            const __m256i g = _mm256_and_si256(pixels, opaque);
+            blocks[i] = Combine_AVX2(r, g, zero, opaque);
+        }
+        return true;
+
+    case TextureFormat::I8:
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m256i intensity = LoadU8_AVX2(source + i * 8);
+            blocks[i] = Combine_AVX2(intensity, intensity, intensity, opaque);
+        }
+        return true;
+
+    case TextureFormat::A8:
+        for (std::size_t i = 0; i < 8; ++i) {
+            blocks[i] = _mm256_slli_epi32(LoadU8_AVX2(source + i * 8), 24);
+        }
+        return true;
+
+    case TextureFormat::IA4:
+        for (std::size_t i = 0; i < 8; ++i) {
+            const __m256i pixels = LoadU8_AVX2(source + i * 8);
+            const __m256i intensity = Expand4To8_AVX2(_mm256_srli_epi32(pixels, 4));
+            const __m256i alpha = Expand4To8_AVX2(_mm256_and_si256(pixels, mask4));
+            blocks[i] = Combine_AVX2(intensity, intensity, intensity, alpha);
+        }
+        return true;
+
+    case TextureFormat::I4:
+    case TextureFormat::A4:
+        for (std::size_t i = 0; i < 4; ++i) {
+            const __m128i values = ExpandNibbles_SSSE3(
+                _mm_loadl_epi64(reinterpret_cast<const __m128i*>(source + i * 8)));
+            for (std::size_t half = 0; half < 2; ++half) {
+                const __m256i value =
+                    _mm256_cvtepu8_epi32(half == 0 ? values : _mm_srli_si128(values, 8));
+                blocks[2 * i + half] = format == TextureFormat::A4
+                                           ? _mm256_slli_epi32(value, 24)
+                                           : Combine_AVX2(value, value, value, opaque);
+            }
+        }
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+TARGET_AVX2 void DeswizzleTile_AVX2(const __m256i* blocks, u8* dest, std::ptrdiff_t dest_stride) {
+    for (std::size_t by = 0; by < 4; ++by) {
+        // Each vector holds two horizontally adjacent blocks, reorder them to rows
+        const __m256i left = _mm256_permute4x64_epi64(blocks[MortonBlockIndex(0, by) / 2], 0xD8);
+        const __m256i right = _mm256_permute4x64_epi64(blocks[MortonBlockIndex(2, by) / 2], 0xD8);
+        u8* row = dest + static_cast<std::ptrdiff_t>(2 * by) * dest_stride;
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(row),
+                            _mm256_permute2x128_si256(left, right, 0x20));
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(row + dest_stride),
+                            _mm256_permute2x128_si256(left, right, 0x31));
+    }
+}
+
+TARGET_AVX2 __m256i Combine128_AVX2(__m128i low, __m128i high) {
+    return _mm256_inserti128_si256(_mm256_castsi128_si256(low), high, 1);
+}
+
+TARGET_AVX2 void DecodeETC1Tile_AVX2(const u8* source, bool has_alpha, u8* dest,
+                                     std::ptrdiff_t dest_stride) {
+    // The subtiles side by side are decoded together, one in each lane
+    for (std::size_t sy = 0; sy < 2; ++sy) {
+        const ETC1Subtile left = LoadETC1Subtile(source, 2 * sy, has_alpha);
+        const ETC1Subtile right = LoadETC1Subtile(source, 2 * sy + 1, has_alpha);
+        __m128i left_channels[4], right_channels[4];
+        DecodeETC1Subtile_SSSE3(left, has_alpha, left_channels[0], left_channels[1],
+                                left_channels[2], left_channels[3]);
+        DecodeETC1Subtile_SSSE3(right, has_alpha, right_channels[0], right_channels[1],
+                                right_channels[2], right_channels[3]);
+        const __m256i r = Combine128_AVX2(left_channels[0], right_channels[0]);
+        const __m256i g = Combine128_AVX2(left_channels[1], right_channels[1]);
+        const __m256i b = Combine128_AVX2(left_channels[2], right_channels[2]);
+        const __m256i a = Combine128_AVX2(left_channels[3], right_channels[3]);
+
+        const __m256i rg_low = _mm256_unpacklo_epi8(r, g);
+        const __m256i ba_low = _mm256_unpacklo_epi8(b, a);
+        const __m256i rg_high = _mm256_unpackhi_epi8(r, g);
+        const __m256i ba_high = _mm256_unpackhi_epi8(b, a);
+        const __m256i rows[4] = {
+            _mm256_unpacklo_epi16(rg_low, ba_low), _mm256_unpackhi_epi16(rg_low, ba_low),
+            _mm256_unpacklo_epi16(rg_high, ba_high), _mm256_unpackhi_epi16(rg_high, ba_high)};
+
+        for (std::size_t y = 0; y < 4; ++y) {
+            u8* row = dest + static_cast<std::ptrdiff_t>(sy * 4 + y) * dest_stride;
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(row), rows[y]);
+        }
+    }
+}
+
+} // Anonymous namespace
+
+TARGET_SSSE3 void DecodeTile_SSSE3(TextureFormat format, const u8* source, u8* dest,
+                                   std::ptrdiff_t dest_stride) {
+    if (format == TextureFormat::ETC1 || format == TextureFormat::ETC1A4) {
+        DecodeETC1Tile_SSSE3(source, format == TextureFormat::ETC1A4, dest, dest_stride);
+        return;
+    }
+
+    __m128i blocks[16];
+    if (!ConvertTile_SSSE3(format, source, blocks)) {
+        DecodeTile_Scalar(format, source, dest, dest_stride);
+        return;
+    }
+    DeswizzleTile_SSSE3(blocks, dest, dest_stride);
+}
+
+TARGET_AVX2 void DecodeTile_AVX2(TextureFormat format, const u8* source, u8* dest,
+                                 std::ptrdiff_t dest_stride) {
+    if (format == TextureFormat::ETC1 || format == TextureFormat::ETC1A4) {
+        DecodeETC1Tile_AVX2(source, format == TextureFormat::ETC1A4, dest, dest_stride);
+        return;
+    }
+
+    __m256i blocks[8];
+    if (!ConvertTile_AVX2(format, source, blocks)) {
+        DecodeTile_Scalar(format, source, dest, dest_stride);
+        return;
+    }
+    DeswizzleTile_AVX2(blocks, dest, dest_stride);
+}
+
+#endif // ARCHITECTURE_x86_64
+
+TileDecodeFunc GetTileDecodeFunc() {
+#ifdef ARCHITECTURE_x86_64
+    const auto& caps = Common::GetCPUCaps();
+    if (caps.avx2) {
+        return DecodeTile_AVX2;
+    }
+    if (caps.ssse3) {
+        return DecodeTile_SSSE3;
+    }
+#endif
+    return DecodeTile_Scalar;
+}
+
+void DecodeTextureRect(const u8* source, const TextureInfo& info, unsigned int x0,
+                       unsigned int y0, unsigned int x1, unsigned int y1, u8* dest,
+                       std::ptrdiff_t dest_stride) {
+    static const TileDecodeFunc decode_tile = GetTileDecodeFunc();
+    const std::size_t tile_size = CalculateTileSize(info.format);
+
+    std::array<u8, TILE_SIZE * 4> tile;
+    for (unsigned int tile_y = y0 & ~7u; tile_y < y1; tile_y += 8) {
+        const unsigned int row_begin = std::max(y0, tile_y);
+        const unsigned int row_end = std::min(y1, tile_y + 8);
+        const u8* line = source + (tile_y / 8) * info.stride;
+
+        for (unsigned int tile_x = x0 & ~7u; tile_x < x1; tile_x += 8) {
+            const unsigned int column_begin = std::max(x0, tile_x);
+            const unsigned int column_end = std::min(x1, tile_x + 8);
+            const u8* tile_source = line + (tile_x / 8) * tile_size;
+
+            // Tiles inside of the rectangle are decoded in place, the others are clipped
+            if (row_end - row_begin == 8 && column_end - column_begin == 8) {
+                decode_tile(info.format, tile_source,
+                            dest + static_cast<std::ptrdiff_t>(tile_y - y0) * dest_stride +
+                                (tile_x - x0) * 4,
+                            dest_stride);
+                continue;
+            }
+
+            decode_tile(info.format, tile_source, tile.data(), DECODED_ROW_SIZE);
+            for (unsigned int y = row_begin; y < row_end; ++y) {
+                std::memcpy(dest + static_cast<std::ptrdiff_t>(y - y0) * dest_stride +
+                                (column_begin - x0) * 4,
+                            &tile[(y - tile_y) * DECODED_ROW_SIZE + (column_begin - tile_x) * 4],
+                            (column_end - column_begin) * 4);
+            }
+        }
+    }
+}
+
 TextureInfo TextureInfo::FromPicaRegister(const TexturingRegs::TextureConfig& config,
                                           const TexturingRegs::TextureFormat& format) {
     TextureInfo info;
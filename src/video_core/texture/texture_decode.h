@@ -4,6 +4,7 @@
 
 #pragma once
 
+#include <cstddef>
 #include "common/common_types.h"
 #include "common/vector_math.h"
 #include "video_core/regs_texturing.h"
@@ -55,4 +56,42 @@ Common::Vec4<u8> LookupTexture(const u8* source, unsigned int x, unsigned int y,
 Common::Vec4<u8> LookupTexelInTile(const u8* source, unsigned int x, unsigned int y,
                                    const TextureInfo& info, bool disable_alpha);
 
+/**
+ * Decodes all texels of an 8x8 texture tile to RGBA8, storing texel (x, y) at
+ * dest + y * dest_stride + x * 4. The result is the same as looking up every texel with
+ * LookupTexelInTile.
+ */
+using TileDecodeFunc = void (*)(TexturingRegs::TextureFormat format, const u8* source, u8* dest,
+                                std::ptrdiff_t dest_stride);
+
+/// Reference implementation
+void DecodeTile_Scalar(TexturingRegs::TextureFormat format, const u8* source, u8* dest,
+                       std::ptrdiff_t dest_stride);
+
+#ifdef ARCHITECTURE_x86_64
+/// Requires SSSE3
+void DecodeTile_SSSE3(TexturingRegs::TextureFormat format, const u8* source, u8* dest,
+                      std::ptrdiff_t dest_stride);
+
+/// Requires AVX2
+void DecodeTile_AVX2(TexturingRegs::TextureFormat format, const u8* source, u8* dest,
+                     std::ptrdiff_t dest_stride);
+#endif
+
+/// Returns the fastest tile decoding implementation supported by the host CPU
+TileDecodeFunc GetTileDecodeFunc();
+
+/**
+ * Decodes the texels of a texture in the rectangle [x0, x1) x [y0, y1) to RGBA8, a whole tile at a
+ * time. The result is the same as looking up every texel with LookupTexture.
+ * @param source Source pointer to read data from
+ * @param info TextureInfo object describing the texture setup
+ * @param dest Destination of texel (x0, y0). Texel (x, y) is stored at
+ *             dest + (y - y0) * dest_stride + (x - x0) * 4.
+ * @param dest_stride Distance in bytes between consecutive rows in dest, negative to flip them
+ */
+void DecodeTextureRect(const u8* source, const TextureInfo& info, unsigned int x0,
+                       unsigned int y0, unsigned int x1, unsigned int y1, u8* dest,
+                       std::ptrdiff_t dest_stride);
+
 } // namespace Pica::Texture
@@ -73,7 +73,7 @@ void VertexLoader::Setup(const PipelineRegs& regs) {
 
 void VertexLoader::LoadVertex(u32 base_address, int index, int vertex,
                               Shader::AttributeBuffer& input,
-                              DebugUtils::MemoryAccessTracker& memory_accesses) {
+                              DebugUtils::MemoryAccessTracker& memory_accesses) const {
     ASSERT_MSG(is_setup, "A VertexLoader needs to be setup before loading vertices.");
 
     for (int i = 0; i < num_total_attributes; ++i) {
@@ -97,7 +97,7 @@ void VertexLoader::LoadVertex(u32 base_address, int index, int vertex,
             switch (vertex_attribute_formats[i]) {
             case PipelineRegs::VertexAttributeFormat::BYTE: {
                 const s8* srcdata = reinterpret_cast<const s8*>(
-                    VideoCore::g_memory->GetPhysicalPointer(source_addr));
+                    VideoCore::GetMemory().GetPhysicalPointer(source_addr));
                 for (unsigned int comp = 0; comp < vertex_attribute_elements[i]; ++comp) {
                     input.attr[i][comp] = float24::FromFloat32(srcdata[comp]);
                 }
@@ -105,7 +105,7 @@ void VertexLoader::LoadVertex(u32 base_address, int index, int vertex,
             }
             case PipelineRegs::VertexAttributeFormat::UBYTE: {
                 const u8* srcdata = reinterpret_cast<const u8*>(
-                    VideoCore::g_memory->GetPhysicalPointer(source_addr));
+                    VideoCore::GetMemory().GetPhysicalPointer(source_addr));
                 for (unsigned int comp = 0; comp < vertex_attribute_elements[i]; ++comp) {
                     input.attr[i][comp] = float24::FromFloat32(srcdata[comp]);
                 }
@@ -113,7 +113,7 @@ void VertexLoader::LoadVertex(u32 base_address, int index, int vertex,
             }
             case PipelineRegs::VertexAttributeFormat::SHORT: {
                 const s16* srcdata = reinterpret_cast<const s16*>(
-                    VideoCore::g_memory->GetPhysicalPointer(source_addr));
+                    VideoCore::GetMemory().GetPhysicalPointer(source_addr));
                 for (unsigned int comp = 0; comp < vertex_attribute_elements[i]; ++comp) {
                     input.attr[i][comp] = float24::FromFloat32(srcdata[comp]);
                 }
@@ -121,7 +121,7 @@ void VertexLoader::LoadVertex(u32 base_address, int index, int vertex,
             }
             case PipelineRegs::VertexAttributeFormat::FLOAT: {
                 const float* srcdata = reinterpret_cast<const float*>(
-                    VideoCore::g_memory->GetPhysicalPointer(source_addr));
+                    VideoCore::GetMemory().GetPhysicalPointer(source_addr));
                 for (unsigned int comp = 0; comp < vertex_attribute_elements[i]; ++comp) {
                     input.attr[i][comp] = float24::FromFloat32(srcdata[comp]);
                 }
@@ -146,7 +146,7 @@ void VertexLoader::LoadVertex(u32 base_address, int index, int vertex,
                       input.attr[i][2].ToFloat32(), input.attr[i][3].ToFloat32());
         } else if (vertex_attribute_is_default[i]) {
             // Load the default attribute if we're configured to do so
-            input.attr[i] = g_state.input_default_attributes.attr[i];
+            input.attr[i] = GetState().input_default_attributes.attr[i];
             LOG_TRACE(
                 HW_GPU,
                 "Loaded default attribute {:x} for vertex {:x} (index {:x}): ({}, {}, {}, {})", i,
@@ -23,7 +23,7 @@ public:
 
     void Setup(const PipelineRegs& regs);
     void LoadVertex(u32 base_address, int index, int vertex, Shader::AttributeBuffer& input,
-                    DebugUtils::MemoryAccessTracker& memory_accesses);
+                    DebugUtils::MemoryAccessTracker& memory_accesses) const;
 
     int GetNumTotalAttributes() const {
         return num_total_attributes;
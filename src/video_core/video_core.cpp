@@ -3,12 +3,16 @@
 // Refer to the license.txt file included.
 
 #include <memory>
+#include <thread>
 #include "common/logging/log.h"
+#include "common/thread_pool.h"
 #include "core/settings.h"
 #include "video_core/pica.h"
+#include "video_core/pica_state.h"
 #include "video_core/renderer_base.h"
 #include "video_core/renderer_opengl/gl_vars.h"
 #include "video_core/renderer_opengl/renderer_opengl.h"
+#include "video_core/shader/shader.h"
 #include "video_core/video_core.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -16,31 +20,33 @@
 
 namespace VideoCore {
 
-std::unique_ptr<RendererBase> g_renderer; ///< Renderer plugin
-
 std::atomic<bool> g_hw_renderer_enabled;
 std::atomic<bool> g_shader_jit_enabled;
 std::atomic<bool> g_hw_shader_enabled;
 std::atomic<bool> g_hw_shader_accurate_gs;
 std::atomic<bool> g_hw_shader_accurate_mul;
-std::atomic<bool> g_renderer_bg_color_update_requested;
-// Screenshot
-std::atomic<bool> g_renderer_screenshot_requested;
-void* g_screenshot_bits;
-std::function<void()> g_screenshot_complete_callback;
-Layout::FramebufferLayout g_screenshot_framebuffer_layout;
 
-Memory::MemorySystem* g_memory;
+Context::Context() : pica_state(std::make_unique<Pica::State>()) {}
+Context::~Context() = default;
+
+RendererBase* GetRenderer() {
+    return Core::System::GetInstance().VideoContext().renderer.get();
+}
+
+Memory::MemorySystem& GetMemory() {
+    return *Core::System::GetInstance().VideoContext().memory;
+}
 
 /// Initialize the video core
 Core::System::ResultStatus Init(Frontend::EmuWindow& emu_window, Memory::MemorySystem& memory) {
-    g_memory = &memory;
+    Context& context = Core::System::GetInstance().VideoContext();
+    context.memory = &memory;
     Pica::Init();
 
     OpenGL::GLES = Settings::values.use_gles;
 
-    g_renderer = std::make_unique<OpenGL::RendererOpenGL>(emu_window);
-    Core::System::ResultStatus result = g_renderer->Init();
+    context.renderer = std::make_unique<OpenGL::RendererOpenGL>(emu_window);
+    Core::System::ResultStatus result = context.renderer->Init();
 
     if (result != Core::System::ResultStatus::Success) {
         LOG_ERROR(Render, "initialization failed !");
@@ -53,34 +59,46 @@ Core::System::ResultStatus Init(Frontend::EmuWindow& emu_window, Memory::MemoryS
 
 /// Shutdown the video core
 void Shutdown() {
-    Pica::Shutdown();
-
-    g_renderer.reset();
+    Context& context = Core::System::GetInstance().VideoContext();
+    context.renderer.reset();
+    context.shader_jit_engine.reset();
 
     LOG_DEBUG(Render, "shutdown OK");
 }
 
 void RequestScreenshot(void* data, std::function<void()> callback,
                        const Layout::FramebufferLayout& layout) {
-    if (g_renderer_screenshot_requested) {
+    Context& context = Core::System::GetInstance().VideoContext();
+    if (context.screenshot_requested) {
         LOG_ERROR(Render, "A screenshot is already requested or in progress, ignoring the request");
         return;
     }
-    g_screenshot_bits = data;
-    g_screenshot_complete_callback = std::move(callback);
-    g_screenshot_framebuffer_layout = layout;
-    g_renderer_screenshot_requested = true;
+    context.screenshot_bits = data;
+    context.screenshot_complete_callback = std::move(callback);
+    context.screenshot_framebuffer_layout = layout;
+    context.screenshot_requested = true;
 }
 
 u16 GetResolutionScaleFactor() {
     if (g_hw_renderer_enabled) {
         return Settings::values.resolution_factor
                    ? Settings::values.resolution_factor
-                   : g_renderer->GetRenderWindow().GetFramebufferLayout().GetScalingRatio();
+                   : GetRenderer()->GetRenderWindow().GetFramebufferLayout().GetScalingRatio();
     } else {
         // Software renderer always render at native resolution
         return 1;
     }
 }
 
+Common::ThreadPool* GetWorkerPool() {
+    static const std::unique_ptr<Common::ThreadPool> worker_pool = [] {
+        const unsigned num_threads = std::thread::hardware_concurrency();
+        if (num_threads <= 1) {
+            return std::unique_ptr<Common::ThreadPool>{};
+        }
+        return std::make_unique<Common::ThreadPool>(num_threads - 1);
+    }();
+    return worker_pool.get();
+}
+
 } // namespace VideoCore
@@ -5,6 +5,7 @@
 #pragma once
 
 #include <atomic>
+#include <functional>
 #include <memory>
 #include "core/core.h"
 #include "core/frontend/emu_window.h"
@@ -15,16 +16,58 @@ class EmuWindow;
 
 class RendererBase;
 
+namespace Common {
+class ThreadPool;
+}
+
 namespace Memory {
 class MemorySystem;
 }
 
+namespace Pica {
+struct State;
+}
+
+namespace Pica::Shader {
+class ShaderEngine;
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////
 // Video Core namespace
 
 namespace VideoCore {
 
-extern std::unique_ptr<RendererBase> g_renderer; ///< Renderer plugin
+/// Video core state of one emulated console
+struct Context {
+    Context();
+    ~Context();
+
+    /// Current Pica state
+    std::unique_ptr<Pica::State> pica_state;
+    /// Renderer plugin
+    std::unique_ptr<RendererBase> renderer;
+    Memory::MemorySystem* memory = nullptr;
+    /**
+     * Shader JIT engine, shared with the other consoles of the process so that every program is
+     * only compiled once. Acquired on first use and released on shutdown, the engine and its
+     * compiled programs are freed along with the last console holding it.
+     */
+    std::shared_ptr<Pica::Shader::ShaderEngine> shader_jit_engine;
+    /// Whether the renderer has to reload the background color from the settings
+    std::atomic<bool> bg_color_update_requested{false};
+
+    // Screenshot
+    std::atomic<bool> screenshot_requested{false};
+    void* screenshot_bits = nullptr;
+    std::function<void()> screenshot_complete_callback;
+    Layout::FramebufferLayout screenshot_framebuffer_layout{};
+};
+
+/// Returns the renderer of the console bound to the calling thread, or nullptr if there is none
+RendererBase* GetRenderer();
+
+/// Returns the memory of the console bound to the calling thread
+Memory::MemorySystem& GetMemory();
 
 // TODO: Wrap these in a user settings struct along with any other graphics settings (often set from
 // qt ui)
@@ -33,14 +76,6 @@ extern std::atomic<bool> g_shader_jit_enabled;
 extern std::atomic<bool> g_hw_shader_enabled;
 extern std::atomic<bool> g_hw_shader_accurate_gs;
 extern std::atomic<bool> g_hw_shader_accurate_mul;
-extern std::atomic<bool> g_renderer_bg_color_update_requested;
-// Screenshot
-extern std::atomic<bool> g_renderer_screenshot_requested;
-extern void* g_screenshot_bits;
-extern std::function<void()> g_screenshot_complete_callback;
-extern Layout::FramebufferLayout g_screenshot_framebuffer_layout;
-
-extern Memory::MemorySystem* g_memory;
 
 /// Initialize the video core
 Core::System::ResultStatus Init(Frontend::EmuWindow& emu_window, Memory::MemorySystem& memory);
@@ -48,10 +83,17 @@ Core::System::ResultStatus Init(Frontend::EmuWindow& emu_window, Memory::MemoryS
 /// Shutdown the video core
 void Shutdown();
 
-/// Request a screenshot of the next frame
+/// Request a screenshot of the next frame of the console bound to the calling thread
 void RequestScreenshot(void* data, std::function<void()> callback,
                        const Layout::FramebufferLayout& layout);
 
 u16 GetResolutionScaleFactor();
 
+/**
+ * Returns the pool of worker threads shared by the software vertex and fragment pipelines of all
+ * consoles, or nullptr if the host has a single hardware thread. Jobs have to bind the submitting
+ * console to the worker running them before touching its state.
+ */
+Common::ThreadPool* GetWorkerPool();
+
 } // namespace VideoCore